@@ -40,6 +40,32 @@ namespace DirectX
     bool __cdecl IsValidIB(_In_ DXGI_FORMAT fmt);
     size_t __cdecl BytesPerElement(_In_ DXGI_FORMAT fmt);
 
+    //---------------------------------------------------------------------------------
+    // Virtual Vertex Formats
+    //  Compact encodings that VBReader and VBWriter accept as an element format. Each is
+    //  stored as the DXGI format from GetStorageFormat, which is the one to put in the
+    //  input layout given to Direct3D, and the vertex shader decodes the element.
+    const DXGI_FORMAT VBFORMAT_OCTAHEDRAL_NORMAL_8 = static_cast<DXGI_FORMAT>(0x10000);
+        // Unit vector mapped to the octahedron and unfolded, stored as R8G8_SNORM
+    const DXGI_FORMAT VBFORMAT_OCTAHEDRAL_NORMAL_16 = static_cast<DXGI_FORMAT>(0x10001);
+        // Unit vector mapped to the octahedron and unfolded, stored as R16G16_SNORM
+    const DXGI_FORMAT VBFORMAT_OCTAHEDRAL_TANGENT_8 = static_cast<DXGI_FORMAT>(0x10002);
+        // Octahedral unit vector in xy and the sign of w (the bitangent handedness) in w, stored as R8G8B8A8_SNORM
+    const DXGI_FORMAT VBFORMAT_OCTAHEDRAL_TANGENT_16 = static_cast<DXGI_FORMAT>(0x10003);
+        // Octahedral unit vector in xy and the sign of w (the bitangent handedness) in w, stored as R16G16B16A16_SNORM
+    const DXGI_FORMAT VBFORMAT_QUANTIZED_POSITION_16 = static_cast<DXGI_FORMAT>(0x10004);
+        // Position normalized to a bounding box, stored as R16G16B16A16_UNORM with w of 0
+        // The reader and writer apply the dequantization transform set with SetQuantization
+
+    DXGI_FORMAT __cdecl GetStorageFormat(_In_ DXGI_FORMAT fmt);
+        // Returns the DXGI format a virtual format is stored as, or fmt itself for any other format
+
+    void __cdecl ComputeQuantization(
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _Out_ XMFLOAT3& scale, _Out_ XMFLOAT3& bias);
+        // Returns the dequantization transform of VBFORMAT_QUANTIZED_POSITION_16 for the bounds of the positions,
+        // where position = stored * scale + bias. Quantizing each subset with its own bounds keeps more precision.
+
 
     //---------------------------------------------------------------------------------
     // Input Layout Descriptor Utilities
@@ -66,6 +92,18 @@ namespace DirectX
 
     //---------------------------------------------------------------------------------
     // Mesh Optimization Utilities
+    enum VCACHE_MODEL
+    {
+        VCACHE_MODEL_FIFO       = 0,
+            // First-in first-out cache where hits do not refresh an entry (typical of fixed-function hardware)
+
+        VCACHE_MODEL_LRU,
+            // Least-recently-used cache where hits move the vertex back to the front
+
+        VCACHE_MODEL_BATCH,
+            // Vertices are shaded in batches of up to cacheSize unique vertices with reuse only inside a batch
+    };
+
     void __cdecl ComputeVertexCacheMissRate(
         _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
         _In_ size_t cacheSize, _Out_ float& acmr, _Out_ float& atvr);
@@ -74,6 +112,24 @@ namespace DirectX
         _In_ size_t cacheSize, _Out_ float& acmr, _Out_ float& atvr);
         // Compute the average cache miss ratio and average triangle vertex reuse for the post-transform vertex cache
 
+    void __cdecl ComputeVertexCacheMissRate(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(count) const size_t* cacheSizes, _In_ size_t count,
+        _Out_writes_(count) float* acmr, _Out_writes_(count) float* atvr);
+    void __cdecl ComputeVertexCacheMissRate(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(count) const size_t* cacheSizes, _In_ size_t count,
+        _Out_writes_(count) float* acmr, _Out_writes_(count) float* atvr);
+        // Batch version that evaluates several cache sizes in a single pass over the index buffer
+
+    void __cdecl ComputeVertexCacheMissRate(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_ size_t cacheSize, _In_ VCACHE_MODEL model, _Out_ float& acmr, _Out_ float& atvr);
+    void __cdecl ComputeVertexCacheMissRate(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_ size_t cacheSize, _In_ VCACHE_MODEL model, _Out_ float& acmr, _Out_ float& atvr);
+        // Version that simulates a specific vertex cache model
+
     //---------------------------------------------------------------------------------
     // Vertex Buffer Reader/Writer
 
@@ -111,6 +167,33 @@ namespace DirectX
         HRESULT __cdecl Read(_Out_writes_(count) XMFLOAT4* buffer, _In_z_ const char* semanticName, _In_ unsigned int semanticIndex, _In_ size_t count, bool x2bias = false) const;
             // Helpers for data extraction
 
+        struct Handle
+        {
+            uint32_t    slot;
+            uint32_t    offset;
+            const void* codec;
+        };
+
+        HRESULT __cdecl GetHandle(_In_z_ const char* semanticName, _In_ unsigned int semanticIndex, _Out_ Handle& handle) const;
+            // Resolves an element once, so reads through the handle skip the semantic lookup and format dispatch
+            // A handle is opaque, and stays valid until the reader is initialized again (streams can still be added)
+
+        HRESULT __cdecl Read(_Out_writes_(count) XMVECTOR* buffer, _In_ const Handle& handle, _In_ size_t count, bool x2bias = false) const;
+        HRESULT __cdecl Read(_Out_writes_(count) float* buffer, _In_ const Handle& handle, _In_ size_t count, bool x2bias = false) const;
+        HRESULT __cdecl Read(_Out_writes_(count) XMFLOAT2* buffer, _In_ const Handle& handle, _In_ size_t count, bool x2bias = false) const;
+        HRESULT __cdecl Read(_Out_writes_(count) XMFLOAT3* buffer, _In_ const Handle& handle, _In_ size_t count, bool x2bias = false) const;
+        HRESULT __cdecl Read(_Out_writes_(count) XMFLOAT4* buffer, _In_ const Handle& handle, _In_ size_t count, bool x2bias = false) const;
+            // Extracts data elements through a resolved handle
+
+        HRESULT __cdecl SetQuantization(_In_z_ const char* semanticName, _In_ unsigned int semanticIndex, _In_ const XMFLOAT3& scale, _In_ const XMFLOAT3& bias);
+            // Sets the dequantization transform of a VBFORMAT_QUANTIZED_POSITION_16 element, which defaults to a scale of 1 and bias of 0
+            // Reads return stored * scale + bias, and the transform can be changed between reads of different subsets
+
+        void __cdecl SetThreadCount(_In_ size_t threads) noexcept;
+            // Splits reads of large vertex ranges into blocks decoded on up to this many threads, 0 or 1 uses only the calling thread
+            // Counts above omp_get_max_threads() are clamped to it
+            // Requires building with OpenMP, otherwise reads always run on the calling thread
+
         void __cdecl Release();
 
     #if defined(__d3d11_h__) || defined(__d3d11_x_h__)
@@ -167,6 +250,33 @@ namespace DirectX
         HRESULT __cdecl Write(_In_reads_(count) const XMFLOAT4* buffer, _In_z_ const char* semanticName, _In_ unsigned int semanticIndex, _In_ size_t count, bool x2bias = false) const;
             // Helpers for data insertion
 
+        struct Handle
+        {
+            uint32_t    slot;
+            uint32_t    offset;
+            const void* codec;
+        };
+
+        HRESULT __cdecl GetHandle(_In_z_ const char* semanticName, _In_ unsigned int semanticIndex, _Out_ Handle& handle) const;
+            // Resolves an element once, so writes through the handle skip the semantic lookup and format dispatch
+            // A handle is opaque, and stays valid until the writer is initialized again (streams can still be added)
+
+        HRESULT __cdecl Write(_In_reads_(count) const XMVECTOR* buffer, _In_ const Handle& handle, _In_ size_t count, bool x2bias = false) const;
+        HRESULT __cdecl Write(_In_reads_(count) const float* buffer, _In_ const Handle& handle, _In_ size_t count, bool x2bias = false) const;
+        HRESULT __cdecl Write(_In_reads_(count) const XMFLOAT2* buffer, _In_ const Handle& handle, _In_ size_t count, bool x2bias = false) const;
+        HRESULT __cdecl Write(_In_reads_(count) const XMFLOAT3* buffer, _In_ const Handle& handle, _In_ size_t count, bool x2bias = false) const;
+        HRESULT __cdecl Write(_In_reads_(count) const XMFLOAT4* buffer, _In_ const Handle& handle, _In_ size_t count, bool x2bias = false) const;
+            // Inserts data elements through a resolved handle
+
+        HRESULT __cdecl SetQuantization(_In_z_ const char* semanticName, _In_ unsigned int semanticIndex, _In_ const XMFLOAT3& scale, _In_ const XMFLOAT3& bias);
+            // Sets the dequantization transform of a VBFORMAT_QUANTIZED_POSITION_16 element, which defaults to a scale of 1 and bias of 0
+            // Writes store (position - bias) / scale, so each subset can be written with the transform from its own bounds
+
+        void __cdecl SetThreadCount(_In_ size_t threads) noexcept;
+            // Splits writes of large vertex ranges into blocks encoded on up to this many threads, 0 or 1 uses only the calling thread
+            // Counts above omp_get_max_threads() are clamped to it
+            // Requires building with OpenMP, otherwise writes always run on the calling thread
+
         void __cdecl Release();
 
     #if defined(__d3d11_h__) || defined(__d3d11_x_h__)
@@ -189,6 +299,28 @@ namespace DirectX
         std::unique_ptr<Impl> pImpl;
     };
 
+#if defined(__d3d11_h__) || defined(__d3d11_x_h__)
+    HRESULT __cdecl TranscodeVB(
+        _In_reads_bytes_(inStride * nVerts) const void* vbin, _In_ size_t inStride,
+        _In_reads_(nInDecl) const D3D11_INPUT_ELEMENT_DESC* inDecl, _In_ size_t nInDecl,
+        _Out_writes_bytes_(outStride * nVerts) void* vbout, _In_ size_t outStride,
+        _In_reads_(nOutDecl) const D3D11_INPUT_ELEMENT_DESC* outDecl, _In_ size_t nOutDecl,
+        _In_ size_t nVerts);
+#endif
+
+#if defined(__d3d12_h__) || defined(__d3d12_x_h__)
+    HRESULT __cdecl TranscodeVB(
+        _In_reads_bytes_(inStride * nVerts) const void* vbin, _In_ size_t inStride,
+        const D3D12_INPUT_LAYOUT_DESC& inDecl,
+        _Out_writes_bytes_(outStride * nVerts) void* vbout, _In_ size_t outStride,
+        const D3D12_INPUT_LAYOUT_DESC& outDecl,
+        _In_ size_t nVerts);
+#endif
+        // Converts an interleaved vertex buffer from one layout to another in a single pass, matching elements by semantic
+        // Elements with the same format are copied, the others converted as by VBReader and VBWriter, and elements
+        // missing from the input are zero filled. Both layouts must use input slot 0, and a stride of 0 uses the layout's.
+        // VBFORMAT_QUANTIZED_POSITION_16 elements can only be copied or dropped, converting one fails with ERROR_NOT_SUPPORTED.
+
     //---------------------------------------------------------------------------------
     // Adjacency Computation
 
@@ -335,6 +467,63 @@ namespace DirectX
         _In_ DWORD flags, _In_opt_ std::wstring* msgs = nullptr);
         // Checks the mesh for common problems, return 'S_OK' if no problems were found
 
+    enum VALIDATE_ERROR
+    {
+        VALIDATE_ERROR_INVALID_INDEX = 0,
+            // Index out of range, value is the index
+
+        VALIDATE_ERROR_INVALID_NEIGHBOR,
+            // Adjacency out of range, value is the neighbor
+
+        VALIDATE_ERROR_UNUSED_POINTS,
+            // Unused face with some valid indices (VALIDATE_UNUSED), value is the first valid index
+
+        VALIDATE_ERROR_UNUSED_NEIGHBOR,
+            // Unused face with a neighbor (VALIDATE_UNUSED), value is the neighbor
+
+        VALIDATE_ERROR_DEGENERATE,
+            // Point used more than once in a face (VALIDATE_DEGENERATE), value is the point
+
+        VALIDATE_ERROR_DEGENERATE_NEIGHBOR,
+            // Degenerate face with a neighbor (VALIDATE_DEGENERATE), value is the neighbor
+
+        VALIDATE_ERROR_ASYMMETRIC_ADJ,
+            // Neighbor does not reference back to the face (VALIDATE_ASYMMETRIC_ADJ), value is the neighbor
+
+        VALIDATE_ERROR_BACKFACING,
+            // Neighbor found more than once on the face (VALIDATE_BACKFACING), value is the neighbor
+
+        VALIDATE_ERROR_BOWTIE,
+            // Vertex used by two separate fans (VALIDATE_BOWTIES), value is the vertex and face is in the second fan
+
+        VALIDATE_ERROR_COUNT
+    };
+
+    struct ValidateIssue
+    {
+        uint32_t    error;      // VALIDATE_ERROR
+        uint32_t    face;
+        uint32_t    value;
+    };
+
+    struct ValidateResult
+    {
+        size_t                      counts[VALIDATE_ERROR_COUNT];
+        std::vector<ValidateIssue>  issues;
+    };
+
+    HRESULT __cdecl Validate(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_ DWORD flags, _Out_ ValidateResult& result, _In_ size_t maxIssues = 64);
+    HRESULT __cdecl Validate(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_ DWORD flags, _Out_ ValidateResult& result, _In_ size_t maxIssues = 64);
+        // Checks the mesh as above without formatting messages, and faces are checked in parallel when built with OpenMP
+        // Counts every problem, and keeps the first maxIssues face problems by face order followed by bowties by vertex order
+        // Bowties are only checked when the indices and adjacency are in range
+
     HRESULT __cdecl Clean(
         _Inout_updates_all_(nFaces * 3) uint16_t* indices, _In_ size_t nFaces,
         _In_ size_t nVerts, _Inout_updates_all_opt_(nFaces * 3) uint32_t* adjacency,
@@ -362,13 +551,62 @@ namespace DirectX
         _In_ std::function<bool __cdecl(uint32_t v0, uint32_t v1)> weldTest);
         // Welds vertices together based on a test function
 
+    template<class WeldTest>
+    HRESULT __cdecl WeldVertices(
+        _Inout_updates_all_(nFaces * 3) uint16_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_(nVerts) const uint32_t* pointRep,
+        _Out_writes_opt_(nVerts) uint32_t* vertexRemap,
+        _In_ WeldTest&& weldTest);
+    template<class WeldTest>
+    HRESULT __cdecl WeldVertices(
+        _Inout_updates_all_(nFaces * 3) uint32_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_(nVerts) const uint32_t* pointRep,
+        _Out_writes_opt_(nVerts) uint32_t* vertexRemap,
+        _In_ WeldTest&& weldTest);
+        // Version taking any callable bool weldTest(uint32_t v0, uint32_t v1), so the test can be inlined
+
+    class AttributeWeldTest
+    {
+    public:
+        AttributeWeldTest() noexcept : mCount{}, mStreams{} {}
+
+        static const size_t MaxStreams = 8;
+
+        HRESULT __cdecl AddStream(_In_ const XMFLOAT2* data, _In_ float epsilon);
+        HRESULT __cdecl AddStream(_In_ const XMFLOAT3* data, _In_ float epsilon);
+        HRESULT __cdecl AddStream(_In_ const XMFLOAT4* data, _In_ float epsilon);
+            // Adds an attribute stream with one element per vertex, such as normals, texture coordinates, or colors
+
+        bool __cdecl operator()(_In_ uint32_t v0, _In_ uint32_t v1) const;
+            // True if every stream matches within its epsilon per component
+
+    private:
+        struct Stream
+        {
+            const float*    data;
+            float           epsilon;
+        };
+
+        HRESULT __cdecl AddStream(_In_ const float* data, _In_ size_t components, _In_ float epsilon);
+
+        // Streams are grouped by component count (2, 3, 4) so each group compares without dispatch
+        size_t  mCount[3];
+        Stream  mStreams[3][MaxStreams];
+    };
+        // Built-in weld test for WeldVertices, which compares the streams with SIMD
+
     //---------------------------------------------------------------------------------
     // Mesh Optimization
 
     HRESULT __cdecl AttributeSort(
         _In_ size_t nFaces, _Inout_updates_all_(nFaces) uint32_t* attributes,
         _Out_writes_(nFaces) uint32_t* faceRemap);
-        // Reorders faces by attribute id
+    HRESULT __cdecl AttributeSort(
+        _In_ size_t nFaces, _Inout_updates_all_(nFaces) uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _Out_ std::vector<std::pair<size_t, size_t>>& subsets);
+        // Reorders faces by attribute id, with a stable radix sort that runs in parallel when built with OpenMP
+        // The second version also returns the face offset,counts of the sorted attribute groups, as ComputeSubsets would
 
     enum OPTFACES
     {
@@ -388,22 +626,35 @@ namespace DirectX
         _In_reads_(nFaces * 3) const uint32_t* adjacency,
         _Out_writes_(nFaces) uint32_t* faceRemap,
         _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT,
-        _In_ uint32_t restart = OPTFACES_R_DEFAULT);
+        _In_ uint32_t restart = OPTFACES_R_DEFAULT,
+        _In_ VCACHE_MODEL model = VCACHE_MODEL_FIFO);
     HRESULT __cdecl OptimizeFaces(
         _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
         _In_reads_(nFaces * 3) const uint32_t* adjacency,
         _Out_writes_(nFaces) uint32_t* faceRemap,
         _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT,
-        _In_ uint32_t restart = OPTFACES_R_DEFAULT);
+        _In_ uint32_t restart = OPTFACES_R_DEFAULT,
+        _In_ VCACHE_MODEL model = VCACHE_MODEL_FIFO);
     HRESULT __cdecl OptimizeFacesLRU(
         _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
         _Out_writes_(nFaces) uint32_t* faceRemap,
-        _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT);
+        _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT,
+        _In_ VCACHE_MODEL model = VCACHE_MODEL_LRU);
     HRESULT __cdecl OptimizeFacesLRU(
         _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
         _Out_writes_(nFaces) uint32_t* faceRemap,
-        _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT);
+        _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT,
+        _In_ VCACHE_MODEL model = VCACHE_MODEL_LRU);
+    HRESULT __cdecl OptimizeFacesTipsify(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
+    HRESULT __cdecl OptimizeFacesTipsify(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
         // Reorders faces to increase hit rate of vertex caches
+        // (OptimizeFaces and OptimizeFacesLRU can target a specific vertex cache model)
 
     HRESULT __cdecl OptimizeFacesEx(
         _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
@@ -411,26 +662,94 @@ namespace DirectX
         _In_reads_(nFaces) const uint32_t* attributes,
         _Out_writes_(nFaces) uint32_t* faceRemap,
         _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT,
-        _In_ uint32_t restart = OPTFACES_R_DEFAULT);
+        _In_ uint32_t restart = OPTFACES_R_DEFAULT,
+        _In_ VCACHE_MODEL model = VCACHE_MODEL_FIFO);
     HRESULT __cdecl OptimizeFacesEx(
         _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
         _In_reads_(nFaces * 3) const uint32_t* adjacency,
         _In_reads_(nFaces) const uint32_t* attributes,
         _Out_writes_(nFaces) uint32_t* faceRemap,
         _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT,
-        _In_ uint32_t restart = OPTFACES_R_DEFAULT);
+        _In_ uint32_t restart = OPTFACES_R_DEFAULT,
+        _In_ VCACHE_MODEL model = VCACHE_MODEL_FIFO);
     HRESULT __cdecl OptimizeFacesLRUEx(
         _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
         _In_reads_(nFaces) const uint32_t* attributes,
         _Out_writes_(nFaces) uint32_t* faceRemap,
-        _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT);
+        _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT,
+        _In_ VCACHE_MODEL model = VCACHE_MODEL_LRU);
     HRESULT __cdecl OptimizeFacesLRUEx(
         _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
         _In_reads_(nFaces) const uint32_t* attributes,
         _Out_writes_(nFaces) uint32_t* faceRemap,
-        _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT);
+        _In_ uint32_t lruCacheSize = OPTFACES_LRU_DEFAULT,
+        _In_ VCACHE_MODEL model = VCACHE_MODEL_LRU);
+    HRESULT __cdecl OptimizeFacesTipsifyEx(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
+    HRESULT __cdecl OptimizeFacesTipsifyEx(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
         // Attribute group version of OptimizeFaces
 
+    HRESULT __cdecl OptimizeFacesOverdraw(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ float threshold = 1.05f,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
+    HRESULT __cdecl OptimizeFacesOverdraw(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ float threshold = 1.05f,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
+    HRESULT __cdecl OptimizeFacesOverdrawEx(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ float threshold = 1.05f,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
+    HRESULT __cdecl OptimizeFacesOverdrawEx(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _In_ float threshold = 1.05f,
+        _In_ uint32_t vertexCache = OPTFACES_V_DEFAULT);
+        // Reorders faces that are already optimized for the vertex cache to reduce overdraw,
+        // keeping the ACMR within threshold times that of the input order
+
+    HRESULT __cdecl GenerateStrips(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _Inout_ std::vector<uint16_t>& stripIndices);
+    HRESULT __cdecl GenerateStrips(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _Inout_ std::vector<uint32_t>& stripIndices);
+        // Builds a triangle strip index buffer in OPTFACES_V_STRIPORDER face order,
+        // separating strips with the primitive restart index (0xFFFF or 0xFFFFFFFF)
+
+    HRESULT __cdecl GenerateStripsEx(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Inout_ std::vector<uint16_t>& stripIndices,
+        _Inout_ std::vector<std::pair<size_t, size_t>>& stripSubsets);
+    HRESULT __cdecl GenerateStripsEx(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Inout_ std::vector<uint32_t>& stripIndices,
+        _Inout_ std::vector<std::pair<size_t, size_t>>& stripSubsets);
+        // Attribute group version of GenerateStrips, returning an index offset,count per attribute group
+
     HRESULT __cdecl OptimizeVertices(
         _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces, _In_ size_t nVerts,
         _Out_writes_(nVerts) uint32_t* vertexRemap, _Out_opt_ size_t* trailingUnused = nullptr);
@@ -439,6 +758,224 @@ namespace DirectX
         _Out_writes_(nVerts) uint32_t* vertexRemap, _Out_opt_ size_t* trailingUnused = nullptr);
         // Reorders vertices in order of use
 
+    //---------------------------------------------------------------------------------
+    // Mesh Simplification
+
+    HRESULT __cdecl GenerateLODs(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_opt_(nVerts) const uint32_t* pointRep,
+        _In_reads_(nLODs) const size_t* targetFaces, _In_ size_t nLODs,
+        _Inout_ std::vector<uint16_t>& lodIndices,
+        _Inout_ std::vector<std::pair<size_t, size_t>>& lodRanges,
+        _Out_writes_opt_(nLODs) float* lodErrors = nullptr);
+    HRESULT __cdecl GenerateLODs(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_opt_(nVerts) const uint32_t* pointRep,
+        _In_reads_(nLODs) const size_t* targetFaces, _In_ size_t nLODs,
+        _Inout_ std::vector<uint32_t>& lodIndices,
+        _Inout_ std::vector<std::pair<size_t, size_t>>& lodRanges,
+        _Out_writes_opt_(nLODs) float* lodErrors = nullptr);
+        // Simplifies by quadric error metric edge collapses down to each (non-increasing) face count target.
+        // LODs index the input vertices, and vertices sharing a pointRep collapse together to keep seams and borders.
+        // lodRanges returns the index offset,count of each LOD in lodIndices, and lodErrors the largest collapse error.
+
+    HRESULT __cdecl SimplifyByClustering(
+        _Inout_updates_all_(nFaces * 3) uint16_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_opt_(nVerts) const uint32_t* pointRep,
+        _In_ size_t gridSize,
+        _Out_writes_opt_(nVerts) uint32_t* clusterRep = nullptr,
+        _Out_opt_ size_t* remainingFaces = nullptr);
+    HRESULT __cdecl SimplifyByClustering(
+        _Inout_updates_all_(nFaces * 3) uint32_t* indices, _In_ size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_opt_(nVerts) const uint32_t* pointRep,
+        _In_ size_t gridSize,
+        _Out_writes_opt_(nVerts) uint32_t* clusterRep = nullptr,
+        _Out_opt_ size_t* remainingFaces = nullptr);
+        // Fast vertex clustering: snaps points to a grid of gridSize (1 to 1024) cells along the longest side of the bounds
+        // and moves each cell onto the vertex nearest its centroid. Degenerate and repeated faces are marked unused as in Clean.
+        // clusterRep returns the vertex each vertex merged into; OptimizeVertices and CompactVB then drop the unused vertices.
+
+    //---------------------------------------------------------------------------------
+    // Meshlet Generation
+
+    enum MESHLET_DEFAULT
+    {
+        MESHLET_DEFAULT_MAX_VERTS = 128,
+        MESHLET_DEFAULT_MAX_PRIMS = 128,
+            // Default vertex and primitive limits for a meshlet
+
+        MESHLET_MINIMUM_SIZE = 32,
+        MESHLET_MAXIMUM_SIZE = 256,
+            // Range of supported limits, bounded by 8-bit local indices
+    };
+
+    struct Meshlet
+    {
+        uint32_t VertCount;
+        uint32_t VertOffset;
+        uint32_t PrimCount;
+        uint32_t PrimOffset;
+    };
+
+    struct MeshletTriangle
+    {
+        uint8_t i0;
+        uint8_t i1;
+        uint8_t i2;
+    };
+
+    struct MeshletCullData
+    {
+        XMFLOAT4 BoundingSphere;    // xyz = center, w = radius
+        XMFLOAT3 ConeApex;
+        XMFLOAT3 ConeAxis;
+        float    ConeCutoff;        // cull if dot(normalize(ConeApex - eye), ConeAxis) >= ConeCutoff
+    };
+
+    HRESULT __cdecl ComputeMeshlets(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _Inout_ std::vector<Meshlet>& meshlets,
+        _Inout_ std::vector<uint8_t>& uniqueVertexIB,
+        _Inout_ std::vector<MeshletTriangle>& primitiveIndices,
+        _In_ size_t maxVerts = MESHLET_DEFAULT_MAX_VERTS, _In_ size_t maxPrims = MESHLET_DEFAULT_MAX_PRIMS);
+    HRESULT __cdecl ComputeMeshlets(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _Inout_ std::vector<Meshlet>& meshlets,
+        _Inout_ std::vector<uint8_t>& uniqueVertexIB,
+        _Inout_ std::vector<MeshletTriangle>& primitiveIndices,
+        _In_ size_t maxVerts = MESHLET_DEFAULT_MAX_VERTS, _In_ size_t maxPrims = MESHLET_DEFAULT_MAX_PRIMS);
+        // Splits a mesh into meshlets in OptimizeFacesLRU order, grown through face adjacency.
+        // uniqueVertexIB holds the meshlet vertex indices using the same index type as the input.
+
+    HRESULT __cdecl ComputeMeshletsEx(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Inout_ std::vector<Meshlet>& meshlets,
+        _Inout_ std::vector<uint8_t>& uniqueVertexIB,
+        _Inout_ std::vector<MeshletTriangle>& primitiveIndices,
+        _Inout_ std::vector<std::pair<size_t, size_t>>& meshletSubsets,
+        _In_ size_t maxVerts = MESHLET_DEFAULT_MAX_VERTS, _In_ size_t maxPrims = MESHLET_DEFAULT_MAX_PRIMS);
+    HRESULT __cdecl ComputeMeshletsEx(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Inout_ std::vector<Meshlet>& meshlets,
+        _Inout_ std::vector<uint8_t>& uniqueVertexIB,
+        _Inout_ std::vector<MeshletTriangle>& primitiveIndices,
+        _Inout_ std::vector<std::pair<size_t, size_t>>& meshletSubsets,
+        _In_ size_t maxVerts = MESHLET_DEFAULT_MAX_VERTS, _In_ size_t maxPrims = MESHLET_DEFAULT_MAX_PRIMS);
+        // Attribute group version of ComputeMeshlets, which returns the meshlet range for each subset
+
+    HRESULT __cdecl ComputeCullData(
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_(nMeshlets) const Meshlet* meshlets, _In_ size_t nMeshlets,
+        _In_reads_(nVertIndices) const uint16_t* uniqueVertexIndices, _In_ size_t nVertIndices,
+        _In_reads_(nPrimIndices) const MeshletTriangle* primitiveIndices, _In_ size_t nPrimIndices,
+        _Out_writes_(nMeshlets) MeshletCullData* cullData);
+    HRESULT __cdecl ComputeCullData(
+        _In_reads_(nVerts) const XMFLOAT3* positions, _In_ size_t nVerts,
+        _In_reads_(nMeshlets) const Meshlet* meshlets, _In_ size_t nMeshlets,
+        _In_reads_(nVertIndices) const uint32_t* uniqueVertexIndices, _In_ size_t nVertIndices,
+        _In_reads_(nPrimIndices) const MeshletTriangle* primitiveIndices, _In_ size_t nPrimIndices,
+        _Out_writes_(nMeshlets) MeshletCullData* cullData);
+        // Computes the bounding sphere and normal cone of each meshlet for culling
+
+    //---------------------------------------------------------------------------------
+    // 16-bit Index Chunking
+
+    enum INDEXCHUNK_DEFAULT
+    {
+        INDEXCHUNK_MINIMUM_SIZE = 3,
+        INDEXCHUNK_MAXIMUM_SIZE = 65535,
+            // Range of supported vertex limits, leaving 0xFFFF for the strip restart index
+
+        INDEXCHUNK_DEFAULT_MAX_VERTS = INDEXCHUNK_MAXIMUM_SIZE,
+    };
+
+    struct IndexChunk
+    {
+        uint32_t AttributeId;
+        uint32_t FaceOffset;
+        uint32_t FaceCount;
+        uint32_t VertOffset;
+        uint32_t VertCount;
+    };
+
+    HRESULT __cdecl ComputeIndexChunks(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        _Inout_ std::vector<IndexChunk>& chunks,
+        _Inout_ std::vector<uint32_t>& chunkVertices,
+        _Out_writes_(nFaces * 3) uint16_t* chunkIndices,
+        _In_ size_t maxVerts = INDEXCHUNK_DEFAULT_MAX_VERTS);
+        // Splits each attribute subset at face order boundaries into chunks of at most maxVerts vertices.
+        // chunkIndices keeps the input face order with indices local to each face's chunk, and
+        // chunkVertices holds the original vertex index for each chunk vertex starting at VertOffset.
+
+    //---------------------------------------------------------------------------------
+    // Index Buffer Compression
+
+    HRESULT __cdecl CompressIndexBuffer(
+        _In_reads_(nFaces * 3) const uint16_t* indices, _In_ size_t nFaces,
+        _Inout_ std::vector<uint8_t>& compressed);
+    HRESULT __cdecl CompressIndexBuffer(
+        _In_reads_(nFaces * 3) const uint32_t* indices, _In_ size_t nFaces,
+        _Inout_ std::vector<uint8_t>& compressed);
+        // Losslessly encodes a triangle list, most effective after vertex cache and vertex fetch optimization
+
+    HRESULT __cdecl DecompressIndexBuffer(
+        _In_reads_bytes_(size) const uint8_t* compressed, _In_ size_t size,
+        _Out_writes_(nFaces * 3) uint16_t* indices, _In_ size_t nFaces);
+    HRESULT __cdecl DecompressIndexBuffer(
+        _In_reads_bytes_(size) const uint8_t* compressed, _In_ size_t size,
+        _Out_writes_(nFaces * 3) uint32_t* indices, _In_ size_t nFaces);
+        // Decodes the output of CompressIndexBuffer
+
+    //---------------------------------------------------------------------------------
+    // Vertex Buffer Compression
+
+#if defined(__d3d11_h__) || defined(__d3d11_x_h__)
+    HRESULT __cdecl CompressVertexBuffer(
+        _In_reads_(nDecl) const D3D11_INPUT_ELEMENT_DESC* vbDecl, _In_ size_t nDecl,
+        _In_reads_bytes_(nVerts * stride) const void* vb, _In_ size_t nVerts,
+        _Inout_ std::vector<uint8_t>& compressed,
+        _In_ size_t inputSlot = 0, _In_ size_t stride = 0);
+
+    HRESULT __cdecl DecompressVertexBuffer(
+        _In_reads_(nDecl) const D3D11_INPUT_ELEMENT_DESC* vbDecl, _In_ size_t nDecl,
+        _In_reads_bytes_(size) const uint8_t* compressed, _In_ size_t size,
+        _Out_writes_bytes_(nVerts * stride) void* vb, _In_ size_t nVerts,
+        _In_ size_t inputSlot = 0, _In_ size_t stride = 0);
+#endif
+
+#if defined(__d3d12_h__) || defined(__d3d12_x_h__)
+    HRESULT __cdecl CompressVertexBuffer(
+        const D3D12_INPUT_LAYOUT_DESC& vbDecl,
+        _In_reads_bytes_(nVerts * stride) const void* vb, _In_ size_t nVerts,
+        _Inout_ std::vector<uint8_t>& compressed,
+        _In_ size_t inputSlot = 0, _In_ size_t stride = 0);
+
+    HRESULT __cdecl DecompressVertexBuffer(
+        const D3D12_INPUT_LAYOUT_DESC& vbDecl,
+        _In_reads_bytes_(size) const uint8_t* compressed, _In_ size_t size,
+        _Out_writes_bytes_(nVerts * stride) void* vb, _In_ size_t nVerts,
+        _In_ size_t inputSlot = 0, _In_ size_t stride = 0);
+#endif
+        // Losslessly encodes one vertex stream, most effective after vertex fetch optimization and FinalizeVB
+        // Stride defaults to the size of the input slot's elements in the declaration
+
     //---------------------------------------------------------------------------------
     // Remap functions
 
@@ -25,3 +25,238 @@ inline bool __cdecl IsValidIB(DXGI_FORMAT fmt)
 {
     return (fmt == DXGI_FORMAT_R32_UINT || fmt == DXGI_FORMAT_R16_UINT) != 0;
 }
+
+
+//=====================================================================================
+// Mesh utilities
+//=====================================================================================
+namespace Internal
+{
+    template<class index_t, class WeldTest>
+    HRESULT WeldVerticesImpl(
+        _Inout_updates_all_(nFaces * 3) index_t* indices, size_t nFaces,
+        size_t nVerts, _In_reads_(nVerts) const uint32_t* pointRep,
+        _Out_writes_opt_(nVerts) uint32_t* vertexRemap,
+        WeldTest& weldTest)
+    {
+        std::unique_ptr<uint32_t[]> temp(new (std::nothrow) uint32_t[nVerts * 2]);
+        if (!temp)
+            return E_OUTOFMEMORY;
+
+        auto vertexRemapInverse = temp.get();
+
+        auto wedgeList = temp.get() + nVerts;
+
+        for (uint32_t j = 0; j < nVerts; ++j)
+        {
+            vertexRemapInverse[j] = j;
+            wedgeList[j] = j;
+
+            if (vertexRemap)
+                vertexRemap[j] = j;
+        }
+
+        // Generate wedge list
+        bool identity = true;
+
+        for (uint32_t j = 0; j < nVerts; ++j)
+        {
+            uint32_t pr = pointRep[j];
+            if (pr == uint32_t(-1))
+                continue;
+
+            if (pr >= nVerts)
+                return E_UNEXPECTED;
+
+            if (pr != j)
+            {
+                identity = false;
+
+                wedgeList[j] = wedgeList[pr];
+                wedgeList[pr] = j;
+            }
+        }
+
+        if (identity)
+        {
+            // No candidates for welding, so return now
+            return S_FALSE;
+        }
+
+        bool weld = false;
+
+        for (uint32_t vert = 0; vert < nVerts; ++vert)
+        {
+            if (pointRep[vert] == vert && wedgeList[vert] != vert)
+            {
+                uint32_t curOuter = vert;
+                do
+                {
+                    // if a remapping for the vertex hasn't been found, check to see if it matches any other vertices
+                    _Analysis_assume_(curOuter < nVerts);
+                    if (vertexRemapInverse[curOuter] == curOuter)
+                    {
+                        uint32_t curInner = wedgeList[vert];
+                        _Analysis_assume_(curInner < nVerts);
+                        do
+                        {
+                            // don't check for equalivalence if indices the same (had better be equal then)
+                            // and/or if the one being checked is already being remapped
+                            if ((curInner != curOuter) && (vertexRemapInverse[curInner] == curInner))
+                            {
+                                // if the two vertices are equal, then remap one to the other
+                                if (weldTest(curOuter, curInner))
+                                {
+                                    // remap the inner vertices to the outer...
+                                    vertexRemapInverse[curInner] = curOuter;
+
+                                    weld = true;
+                                }
+                            }
+
+                            curInner = wedgeList[curInner];
+                        } while (curInner != vert);
+                    }
+
+                    curOuter = wedgeList[curOuter];
+                } while (curOuter != vert);
+            }
+        }
+
+        if (!weld)
+            return S_FALSE;
+
+        // Apply map to indices
+        for (uint32_t j = 0; j < nFaces * 3; ++j)
+        {
+            index_t i = indices[j];
+            if (i == index_t(-1))
+                continue;
+
+            indices[j] = index_t(vertexRemapInverse[i]);
+        }
+
+        // Generate inverse map if requested
+        if (vertexRemap)
+        {
+            memset(vertexRemap, 0xff, sizeof(uint32_t) * nVerts);
+
+            for (uint32_t j = 0; j < nVerts; ++j)
+            {
+                if (vertexRemapInverse[j] != uint32_t(-1))
+                {
+                    vertexRemap[vertexRemapInverse[j]] = j;
+                }
+            }
+        }
+
+        return S_OK;
+    }
+}
+
+template<class WeldTest>
+_Use_decl_annotations_
+inline HRESULT __cdecl WeldVertices(
+    uint16_t* indices, size_t nFaces,
+    size_t nVerts, const uint32_t* pointRep,
+    uint32_t* vertexRemap,
+    WeldTest&& weldTest)
+{
+    if (!indices || !nFaces || !nVerts || !pointRep)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT16_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    return Internal::WeldVerticesImpl<uint16_t>(indices, nFaces, nVerts, pointRep, vertexRemap, weldTest);
+}
+
+template<class WeldTest>
+_Use_decl_annotations_
+inline HRESULT __cdecl WeldVertices(
+    uint32_t* indices, size_t nFaces,
+    size_t nVerts, const uint32_t* pointRep,
+    uint32_t* vertexRemap,
+    WeldTest&& weldTest)
+{
+    if (!indices || !nFaces || !nVerts || !pointRep)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    return Internal::WeldVerticesImpl<uint32_t>(indices, nFaces, nVerts, pointRep, vertexRemap, weldTest);
+}
+
+_Use_decl_annotations_
+inline HRESULT __cdecl AttributeWeldTest::AddStream(const float* data, size_t components, float epsilon)
+{
+    if (!data || epsilon < 0.f)
+        return E_INVALIDARG;
+
+    if ((mCount[0] + mCount[1] + mCount[2]) >= MaxStreams)
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    Stream& stream = mStreams[components - 2][mCount[components - 2]++];
+    stream.data = data;
+    stream.epsilon = epsilon;
+
+    return S_OK;
+}
+
+_Use_decl_annotations_
+inline HRESULT __cdecl AttributeWeldTest::AddStream(const XMFLOAT2* data, float epsilon)
+{
+    return AddStream(reinterpret_cast<const float*>(data), 2, epsilon);
+}
+
+_Use_decl_annotations_
+inline HRESULT __cdecl AttributeWeldTest::AddStream(const XMFLOAT3* data, float epsilon)
+{
+    return AddStream(reinterpret_cast<const float*>(data), 3, epsilon);
+}
+
+_Use_decl_annotations_
+inline HRESULT __cdecl AttributeWeldTest::AddStream(const XMFLOAT4* data, float epsilon)
+{
+    return AddStream(reinterpret_cast<const float*>(data), 4, epsilon);
+}
+
+_Use_decl_annotations_
+inline bool __cdecl AttributeWeldTest::operator()(uint32_t v0, uint32_t v1) const
+{
+    for (size_t j = 0; j < mCount[0]; ++j)
+    {
+        const Stream& stream = mStreams[0][j];
+        XMVECTOR a = XMLoadFloat2(reinterpret_cast<const XMFLOAT2*>(stream.data + size_t(v0) * 2));
+        XMVECTOR b = XMLoadFloat2(reinterpret_cast<const XMFLOAT2*>(stream.data + size_t(v1) * 2));
+        if (!XMVector2NearEqual(a, b, XMVectorReplicate(stream.epsilon)))
+            return false;
+    }
+
+    for (size_t j = 0; j < mCount[1]; ++j)
+    {
+        const Stream& stream = mStreams[1][j];
+        XMVECTOR a = XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(stream.data + size_t(v0) * 3));
+        XMVECTOR b = XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(stream.data + size_t(v1) * 3));
+        if (!XMVector3NearEqual(a, b, XMVectorReplicate(stream.epsilon)))
+            return false;
+    }
+
+    for (size_t j = 0; j < mCount[2]; ++j)
+    {
+        const Stream& stream = mStreams[2][j];
+        XMVECTOR a = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(stream.data + size_t(v0) * 4));
+        XMVECTOR b = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(stream.data + size_t(v1) * 4));
+        if (!XMVector4NearEqual(a, b, XMVectorReplicate(stream.epsilon)))
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,189 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshChunk.cpp
+//
+// DirectX Mesh Geometry Library - 16-bit index chunking
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+namespace
+{
+    //---------------------------------------------------------------------------------
+    // Chunk under construction. Global to local vertex lookups use a per-vertex table
+    // that is restored when the chunk is flushed.
+    //---------------------------------------------------------------------------------
+    class chunk_builder
+    {
+    public:
+        chunk_builder() noexcept : mMaxVerts(0), mVertStart(0) {}
+
+        HRESULT initialize(size_t nVerts, size_t maxVerts)
+        {
+            if (!nVerts || !maxVerts)
+                return E_INVALIDARG;
+
+            mLocalIndex.reset(new (std::nothrow) uint32_t[nVerts]);
+            if (!mLocalIndex)
+                return E_OUTOFMEMORY;
+
+            memset(mLocalIndex.get(), 0xff, sizeof(uint32_t) * nVerts);
+
+            mMaxVerts = maxVerts;
+            mVertStart = 0;
+
+            return S_OK;
+        }
+
+        bool fits(const std::vector<uint32_t>& chunkVertices, const uint32_t* face) const
+        {
+            size_t newVerts = 0;
+            for (size_t j = 0; j < 3; ++j)
+            {
+                uint32_t v = face[j];
+                if (v == UNUSED32 || mLocalIndex[v] != UNUSED32)
+                    continue;
+
+                if ((j > 0 && v == face[0]) || (j > 1 && v == face[1]))
+                    continue;
+
+                ++newVerts;
+            }
+
+            return (chunkVertices.size() - mVertStart + newVerts) <= mMaxVerts;
+        }
+
+        uint16_t local(std::vector<uint32_t>& chunkVertices, uint32_t v)
+        {
+            if (v == UNUSED32)
+                return uint16_t(-1);
+
+            if (mLocalIndex[v] == UNUSED32)
+            {
+                mLocalIndex[v] = static_cast<uint32_t>(chunkVertices.size() - mVertStart);
+                chunkVertices.push_back(v);
+            }
+
+            assert(mLocalIndex[v] < mMaxVerts);
+            return static_cast<uint16_t>(mLocalIndex[v]);
+        }
+
+        void flush(std::vector<IndexChunk>& chunks, const std::vector<uint32_t>& chunkVertices,
+            uint32_t attributeId, size_t faceOffset, size_t faceCount)
+        {
+            if (!faceCount)
+                return;
+
+            IndexChunk chunk;
+            chunk.AttributeId = attributeId;
+            chunk.FaceOffset = static_cast<uint32_t>(faceOffset);
+            chunk.FaceCount = static_cast<uint32_t>(faceCount);
+            chunk.VertOffset = static_cast<uint32_t>(mVertStart);
+            chunk.VertCount = static_cast<uint32_t>(chunkVertices.size() - mVertStart);
+            chunks.push_back(chunk);
+
+            for (size_t j = mVertStart; j < chunkVertices.size(); ++j)
+            {
+                mLocalIndex[chunkVertices[j]] = UNUSED32;
+            }
+
+            mVertStart = chunkVertices.size();
+        }
+
+    private:
+        size_t                      mMaxVerts;
+        size_t                      mVertStart;
+        std::unique_ptr<uint32_t[]> mLocalIndex;
+    };
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Walks each subset in its existing face order, so after OptimizeFaces the chunks
+// split at vertex cache boundaries and only vertices shared across a split are
+// repeated in chunkVertices
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ComputeIndexChunks(
+    const uint32_t* indices, size_t nFaces,
+    size_t nVerts,
+    const uint32_t* attributes,
+    std::vector<IndexChunk>& chunks,
+    std::vector<uint32_t>& chunkVertices,
+    uint16_t* chunkIndices,
+    size_t maxVerts)
+{
+    if (!indices || !nFaces || !nVerts || !chunkIndices)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if (maxVerts < INDEXCHUNK_MINIMUM_SIZE || maxVerts > INDEXCHUNK_MAXIMUM_SIZE)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    for (size_t j = 0; j < (nFaces * 3); ++j)
+    {
+        uint32_t i = indices[j];
+        if (i != UNUSED32 && i >= nVerts)
+            return E_UNEXPECTED;
+    }
+
+    chunk_builder builder;
+    HRESULT hr = builder.initialize(nVerts, maxVerts);
+    if (FAILED(hr))
+        return hr;
+
+    chunks.clear();
+    chunkVertices.clear();
+    chunkVertices.reserve(nVerts);
+
+    auto subsets = ComputeSubsets(attributes, nFaces);
+
+    if (subsets.empty())
+        return E_UNEXPECTED;
+
+    for (auto it = subsets.cbegin(); it != subsets.cend(); ++it)
+    {
+        const size_t faceBegin = it->first;
+        const size_t faceEnd = it->first + it->second;
+
+        if (faceEnd > nFaces)
+            return E_UNEXPECTED;
+
+        const uint32_t attributeId = (attributes) ? attributes[faceBegin] : 0;
+
+        size_t chunkBegin = faceBegin;
+        for (size_t face = faceBegin; face < faceEnd; ++face)
+        {
+            const uint32_t* tri = &indices[face * 3];
+
+            if (!builder.fits(chunkVertices, tri))
+            {
+                builder.flush(chunks, chunkVertices, attributeId, chunkBegin, face - chunkBegin);
+                chunkBegin = face;
+            }
+
+            uint16_t* dest = &chunkIndices[face * 3];
+            dest[0] = builder.local(chunkVertices, tri[0]);
+            dest[1] = builder.local(chunkVertices, tri[1]);
+            dest[2] = builder.local(chunkVertices, tri[2]);
+        }
+
+        builder.flush(chunks, chunkVertices, attributeId, chunkBegin, faceEnd - chunkBegin);
+    }
+
+    return S_OK;
+}
@@ -15,6 +15,25 @@ using namespace DirectX;
 
 namespace
 {
+    // faceSeen keeps one bit per face corner
+    inline bool IsSeen(_In_ const uint64_t* faceSeen, size_t corner)
+    {
+        return ((faceSeen[corner >> 6] >> (corner & 63)) & 1) != 0;
+    }
+
+    inline void MarkSeen(_Inout_ uint64_t* faceSeen, size_t corner)
+    {
+        faceSeen[corner >> 6] |= uint64_t(1) << (corner & 63);
+    }
+
+    // A new vert for a (vertex, attribute) pair, chained to the other splits of the vertex
+    struct AttributeSplit
+    {
+        uint32_t vertex;
+        uint32_t attribute;
+        uint32_t next;
+    };
+
     template<class index_t>
     HRESULT CleanImpl(
         _Inout_updates_all_(nFaces * 3) index_t* indices,
@@ -32,13 +51,15 @@ namespace
         dupVerts.clear();
         size_t curNewVert = nVerts;
 
-        size_t tsize = (sizeof(bool) * nFaces * 3) + (sizeof(uint32_t) * nVerts) + (sizeof(index_t) * nFaces * 3);
+        const size_t seenWords = (nFaces * 3 + 63) / 64;
+
+        size_t tsize = (sizeof(uint64_t) * seenWords) + (sizeof(uint32_t) * nVerts) + (sizeof(index_t) * nFaces * 3);
         std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[tsize]);
         if (!temp)
             return E_OUTOFMEMORY;
 
-        auto faceSeen = reinterpret_cast<bool*>(temp.get());
-        auto ids = reinterpret_cast<uint32_t*>(temp.get() + sizeof(bool) * nFaces * 3);
+        auto faceSeen = reinterpret_cast<uint64_t*>(temp.get());
+        auto ids = reinterpret_cast<uint32_t*>(temp.get() + sizeof(uint64_t) * seenWords);
 
         // UNUSED/DEGENERATE cleanup
         for (uint32_t face = 0; face < nFaces; ++face)
@@ -206,9 +227,10 @@ namespace
         memcpy(indicesNew, indices, sizeof(index_t) * nFaces * 3);
 
         // BOWTIES cleanup
+        size_t bowtieDups = 0;
         if (adjacency && breakBowties)
         {
-            memset(faceSeen, 0, sizeof(bool) * nFaces * 3);
+            memset(faceSeen, 0, sizeof(uint64_t) * seenWords);
             memset(ids, 0xFF, sizeof(uint32_t) * nVerts);
 
             orbit_iterator<index_t> ovi(adjacency, indices, nFaces);
@@ -224,9 +246,6 @@ namespace
                     || i2 == index_t(-1))
                 {
                     // ignore unused faces
-                    faceSeen[face * 3] = true;
-                    faceSeen[face * 3 + 1] = true;
-                    faceSeen[face * 3 + 2] = true;
                     continue;
                 }
 
@@ -239,23 +258,17 @@ namespace
                     || i1 == i2)
                 {
                     // ignore degenerate faces
-                    faceSeen[face * 3] = true;
-                    faceSeen[face * 3 + 1] = true;
-                    faceSeen[face * 3 + 2] = true;
                     continue;
                 }
 
                 for (uint32_t point = 0; point < 3; ++point)
                 {
-                    if (faceSeen[face * 3 + point])
+                    if (IsSeen(faceSeen, face * 3 + point))
                         continue;
 
-                    faceSeen[face * 3 + point] = true;
+                    MarkSeen(faceSeen, face * 3 + point);
 
                     index_t i = indices[face * 3 + point];
-                    if (i == index_t(-1))
-                        continue;
-
                     assert(i < nVerts);
 
                     ovi.initialize(face, i, orbit_iterator<index_t>::ALL);
@@ -274,7 +287,7 @@ namespace
                         if (curPoint > 2)
                             return E_FAIL;
 
-                        faceSeen[curFace * 3 + curPoint] = true;
+                        MarkSeen(faceSeen, curFace * 3 + curPoint);
 
                         index_t j = indices[curFace * 3 + curPoint];
                         if (j == index_t(-1))
@@ -292,111 +305,142 @@ namespace
                         }
                         else if (ids[j] != face)
                         {
-                            // We found a bowtie, duplicate a vert
+                            // We found a bowtie, the new vert takes its source from the corner it replaces
                             replaceVertex = j;
                             replaceValue = index_t(curNewVert);
                             indicesNew[curFace * 3 + curPoint] = replaceValue;
                             ++curNewVert;
-
-                            dupVerts.push_back(j);
                         }
                     }
                 }
             }
 
-            assert((nVerts + dupVerts.size()) == curNewVert);
+            bowtieDups = curNewVert - nVerts;
         }
 
-        // Ensure no vertex is used by more than one attribute
+        // Ensure no vertex is used by more than one attribute. The first face to use a vertex
+        // keeps it, and each other (vertex, attribute) pair gets one new vert in order of first use.
+        std::vector<AttributeSplit> splits;
         if (attributes)
         {
-            memset(ids, 0xFF, sizeof(uint32_t) * nVerts);
+            const size_t nUsed = curNewVert;
 
-            std::vector<uint32_t> dupAttr;
-            dupAttr.reserve(dupVerts.size());
-            for (size_t j = 0; j < dupVerts.size(); ++j)
-            {
-                dupAttr.push_back(UNUSED32);
-            }
+            std::unique_ptr<uint32_t[]> owner(new (std::nothrow) uint32_t[nUsed]);
+            if (!owner)
+                return E_OUTOFMEMORY;
+
+            memset(owner.get(), 0xFF, sizeof(uint32_t) * nUsed);
 
-            std::unordered_multimap<uint32_t, size_t> dups;
+            // Only the corners that conflict with their vertex's attribute need a second look
+            std::vector<uint32_t> conflicts;
 
             for (size_t face = 0; face < nFaces; ++face)
             {
-                uint32_t a = attributes[face];
+                const uint32_t a = attributes[face];
 
                 for (size_t point = 0; point < 3; ++point)
                 {
-                    uint32_t j = indicesNew[face * 3 + point];
-
-                    uint32_t k = (j >= nVerts) ? dupAttr[j - nVerts] : ids[j];
+                    index_t j = indicesNew[face * 3 + point];
+                    if (j == index_t(-1))
+                        continue;
 
-                    if (k == UNUSED32)
+                    if (owner[j] == UNUSED32)
                     {
-                        if (j >= nVerts)
-                            dupAttr[j - nVerts] = a;
-                        else
-                            ids[j] = a;
+                        owner[j] = a;
                     }
-                    else if (k != a)
+                    else if (owner[j] != a)
                     {
-                        // Look for a dup with the correct attribute
-                        auto range = dups.equal_range(j);
-                        auto it = range.first;
-                        for (; it != range.second; ++it)
-                        {
-                            uint32_t m = (it->second >= nVerts) ? dupAttr[it->second - nVerts] : ids[it->second];
-                            if (m == a)
-                            {
-                                indicesNew[face * 3 + point] = index_t(it->second);
-                                break;
-                            }
-                        }
+                        conflicts.push_back(uint32_t(face * 3 + point));
+                    }
+                }
+            }
 
-                        if (it == range.second)
-                        {
-                            // Duplicate the vert
-                            auto dv = std::pair<uint32_t, size_t>(j, curNewVert);
-                            dups.insert(dv);
+            if (!conflicts.empty())
+            {
+                // Each conflicting vertex chains the splits made for it, with the head kept in place of its owner
+                const size_t usedWords = (nUsed + 63) / 64;
 
-                            indicesNew[face * 3 + point] = index_t(curNewVert);
-                            ++curNewVert;
+                std::unique_ptr<uint64_t[]> hasSplit(new (std::nothrow) uint64_t[usedWords]);
+                if (!hasSplit)
+                    return E_OUTOFMEMORY;
 
-                            if (j >= nVerts)
-                            {
-                                dupVerts.push_back(dupVerts[j - nVerts]);
-                            }
-                            else
-                            {
-                                dupVerts.push_back(j);
-                            }
+                memset(hasSplit.get(), 0, sizeof(uint64_t) * usedWords);
 
-                            dupAttr.push_back(a);
+                splits.reserve(conflicts.size());
+
+                for (auto it = conflicts.cbegin(); it != conflicts.cend(); ++it)
+                {
+                    const uint32_t j = indicesNew[*it];
+                    const uint32_t a = attributes[*it / 3];
 
-                            assert(dupVerts.size() == dupAttr.size());
+                    uint32_t split = UNUSED32;
+                    if (IsSeen(hasSplit.get(), j))
+                    {
+                        for (split = owner[j]; split != UNUSED32; split = splits[split].next)
+                        {
+                            if (splits[split].attribute == a)
+                                break;
                         }
                     }
+
+                    if (split == UNUSED32)
+                    {
+                        AttributeSplit newSplit = { j, a, IsSeen(hasSplit.get(), j) ? owner[j] : UNUSED32 };
+                        split = uint32_t(splits.size());
+                        splits.push_back(newSplit);
+
+                        owner[j] = split;
+                        MarkSeen(hasSplit.get(), j);
+                    }
+
+                    indicesNew[*it] = index_t(curNewVert + split);
                 }
+
+                curNewVert += splits.size();
             }
+        }
+
+        if (uint64_t(curNewVert) >= index_t(-1))
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
 
-            assert((nVerts + dupVerts.size()) == curNewVert);
+        if (curNewVert == nVerts)
+            return S_OK;
 
-#ifndef NDEBUG
-            for (auto it = dupVerts.begin(); it != dupVerts.end(); ++it)
+        dupVerts.resize(curNewVert - nVerts);
+
+        // Bowtie duplicates take their source from the corners they replaced
+        if (bowtieDups > 0)
+        {
+            for (size_t k = 0; k < nFaces * 3; ++k)
             {
-                assert(*it < nVerts);
+                index_t j = indicesNew[k];
+                if (j != indices[k] && (j - nVerts) < bowtieDups)
+                {
+                    dupVerts[j - nVerts] = indices[k];
+                }
             }
-#endif
         }
 
-        if ((uint64_t(nVerts) + uint64_t(dupVerts.size())) >= index_t(-1))
-            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+        const int splitCount = static_cast<int>(splits.size());
 
-        if (!dupVerts.empty())
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif
+        for (int split = 0; split < splitCount; ++split)
         {
-            memcpy(indices, indicesNew, sizeof(index_t) * nFaces * 3);
+            const uint32_t j = splits[size_t(split)].vertex;
+            dupVerts[bowtieDups + size_t(split)] = (j >= nVerts) ? dupVerts[j - nVerts] : j;
         }
 
+#ifndef NDEBUG
+        for (auto it = dupVerts.begin(); it != dupVerts.end(); ++it)
+        {
+            assert(*it < nVerts);
+        }
+#endif
+
+        memcpy(indices, indicesNew, sizeof(index_t) * nFaces * 3);
+
         return S_OK;
     }
 }
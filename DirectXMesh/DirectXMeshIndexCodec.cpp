@@ -0,0 +1,378 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshIndexCodec.cpp
+//
+// DirectX Mesh Geometry Library - Index buffer compression
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+//
+// Compressed stream layout
+//
+//  uint32_t    magic
+//  uint32_t    face count
+//  uint8_t     code per face                           [nFaces]
+//  uint8_t     rotation per face, 2 bits each          [(nFaces + 3) / 4]
+//  uint8_t     tail of auxiliary bytes and varints
+//
+// Each face is coded against a FIFO of recently seen directed edges and a FIFO of
+// recently seen vertices. The high nibble of the code is the index of an edge shared
+// with a previous face (or 15 if there is none) and the low nibble says where the
+// remaining vertex comes from: 0 is the next vertex never seen before, 1-14 is a slot
+// in the vertex FIFO, and 15 is a zigzag varint delta from the last explicit vertex.
+// Faces with no shared edge code their first two vertices in an auxiliary tail byte.
+// The rotation stream records which corner of the face the shared edge starts at, so
+// faces decode with exactly the same vertex order as the input.
+//
+
+namespace
+{
+    const uint32_t c_IndexCodecMagic = 0x31434249; // 'IBC1'
+
+    const uint32_t c_EdgeFifoSize = 16;
+    const uint32_t c_VertexFifoSize = 16;
+
+    const uint32_t c_NoEdge = 15;
+    const uint32_t c_NextVertex = 0;
+    const uint32_t c_ExplicitVertex = 15;
+
+    struct index_codec_state
+    {
+        uint32_t edges[c_EdgeFifoSize][2];
+        uint32_t vertices[c_VertexFifoSize];
+        uint32_t edgeHead;
+        uint32_t vertexHead;
+        uint32_t next;
+        uint32_t last;
+
+        index_codec_state() noexcept : edgeHead(0), vertexHead(0), next(0), last(0)
+        {
+            memset(edges, 0xff, sizeof(edges));
+            memset(vertices, 0xff, sizeof(vertices));
+        }
+
+        void push_edge(uint32_t a, uint32_t b)
+        {
+            uint32_t* edge = edges[edgeHead & (c_EdgeFifoSize - 1)];
+            edge[0] = a;
+            edge[1] = b;
+            ++edgeHead;
+        }
+
+        void push_vertex(uint32_t v)
+        {
+            vertices[vertexHead & (c_VertexFifoSize - 1)] = v;
+            ++vertexHead;
+        }
+
+        const uint32_t* get_edge(uint32_t k) const
+        {
+            return edges[(edgeHead - 1 - k) & (c_EdgeFifoSize - 1)];
+        }
+
+        uint32_t get_vertex(uint32_t k) const
+        {
+            return vertices[(vertexHead - 1 - k) & (c_VertexFifoSize - 1)];
+        }
+
+        // neighbors see the edges of a face in the opposite direction
+        void push_face_edges(uint32_t a, uint32_t b, uint32_t c, bool shared)
+        {
+            if (!shared)
+            {
+                push_edge(b, a);
+            }
+
+            push_edge(c, b);
+            push_edge(a, c);
+        }
+    };
+
+    inline void write_varint(std::vector<uint8_t>& data, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            data.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+
+        data.push_back(static_cast<uint8_t>(value));
+    }
+
+    inline bool read_varint(const uint8_t*& data, const uint8_t* end, uint32_t& value)
+    {
+        value = 0;
+        for (uint32_t shift = 0; shift < 35; shift += 7)
+        {
+            if (data >= end)
+                return false;
+
+            uint8_t byte = *data++;
+            value |= uint32_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+
+        return false;
+    }
+
+    inline uint32_t zigzag(uint32_t delta)
+    {
+        return (delta << 1) ^ uint32_t(int32_t(delta) >> 31);
+    }
+
+    inline uint32_t unzigzag(uint32_t value)
+    {
+        return (value >> 1) ^ (0u - (value & 1));
+    }
+
+    //---------------------------------------------------------------------------------
+    uint32_t EncodeVertex(index_codec_state& state, uint32_t v, std::vector<uint8_t>& tail)
+    {
+        if (v == state.next)
+        {
+            ++state.next;
+            state.push_vertex(v);
+            return c_NextVertex;
+        }
+
+        for (uint32_t k = 0; k < c_ExplicitVertex - 1; ++k)
+        {
+            if (state.get_vertex(k) == v)
+                return k + 1;
+        }
+
+        write_varint(tail, zigzag(v - state.last));
+        state.last = v;
+        state.push_vertex(v);
+        return c_ExplicitVertex;
+    }
+
+    inline bool DecodeVertex(index_codec_state& state, uint32_t code, const uint8_t*& tail, const uint8_t* end, uint32_t& v)
+    {
+        if (code == c_NextVertex)
+        {
+            v = state.next++;
+            state.push_vertex(v);
+        }
+        else if (code < c_ExplicitVertex)
+        {
+            v = state.get_vertex(code - 1);
+        }
+        else
+        {
+            uint32_t delta;
+            if (!read_varint(tail, end, delta))
+                return false;
+
+            v = state.last + unzigzag(delta);
+            state.last = v;
+            state.push_vertex(v);
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT CompressIndexBufferImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        std::vector<uint8_t>& compressed)
+    {
+        if (!indices || !nFaces)
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        const size_t rotationBytes = (nFaces + 3) / 4;
+        const size_t tailOffset = 2 * sizeof(uint32_t) + nFaces + rotationBytes;
+
+        compressed.clear();
+        compressed.resize(tailOffset, 0);
+
+        const uint32_t header[2] = { c_IndexCodecMagic, uint32_t(nFaces) };
+        memcpy(compressed.data(), header, sizeof(header));
+
+        uint8_t* codes = compressed.data() + sizeof(header);
+
+        std::vector<uint8_t> rotations(rotationBytes, 0);
+        std::vector<uint8_t> tail;
+        tail.reserve(nFaces);
+
+        index_codec_state state;
+
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            const uint32_t tri[3] = { indices[face * 3], indices[face * 3 + 1], indices[face * 3 + 2] };
+
+            // look for the most recent edge shared with a previous face
+            uint32_t edge = c_NoEdge;
+            uint32_t rot = 0;
+            for (uint32_t k = 0; k < c_NoEdge && edge == c_NoEdge; ++k)
+            {
+                const uint32_t* e = state.get_edge(k);
+                for (uint32_t r = 0; r < 3; ++r)
+                {
+                    if (tri[r] == e[0] && tri[(r + 1) % 3] == e[1])
+                    {
+                        edge = k;
+                        rot = r;
+                        break;
+                    }
+                }
+            }
+
+            uint32_t a = tri[rot];
+            uint32_t b = tri[(rot + 1) % 3];
+            uint32_t c = tri[(rot + 2) % 3];
+
+            uint32_t code;
+            if (edge != c_NoEdge)
+            {
+                code = (edge << 4) | EncodeVertex(state, c, tail);
+            }
+            else
+            {
+                size_t aux = tail.size();
+                tail.push_back(0);
+
+                uint32_t va = EncodeVertex(state, a, tail);
+                uint32_t vb = EncodeVertex(state, b, tail);
+                uint32_t vc = EncodeVertex(state, c, tail);
+
+                tail[aux] = static_cast<uint8_t>((va << 4) | vb);
+                code = (c_NoEdge << 4) | vc;
+            }
+
+            codes[face] = static_cast<uint8_t>(code);
+            rotations[face >> 2] |= static_cast<uint8_t>(rot << ((face & 3) * 2));
+
+            state.push_face_edges(a, b, c, edge != c_NoEdge);
+        }
+
+        memcpy(compressed.data() + sizeof(header) + nFaces, rotations.data(), rotationBytes);
+        compressed.insert(compressed.end(), tail.cbegin(), tail.cend());
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT DecompressIndexBufferImpl(
+        _In_reads_bytes_(size) const uint8_t* compressed, size_t size,
+        _Out_writes_(nFaces * 3) index_t* indices, size_t nFaces)
+    {
+        if (!compressed || !indices || !nFaces)
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        const size_t rotationBytes = (nFaces + 3) / 4;
+        const size_t tailOffset = 2 * sizeof(uint32_t) + nFaces + rotationBytes;
+        if (size < tailOffset)
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+        uint32_t header[2];
+        memcpy(header, compressed, sizeof(header));
+        if (header[0] != c_IndexCodecMagic || header[1] != nFaces)
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+        const uint8_t* codes = compressed + sizeof(header);
+        const uint8_t* rotations = codes + nFaces;
+        const uint8_t* tail = compressed + tailOffset;
+        const uint8_t* end = compressed + size;
+
+        index_codec_state state;
+
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            uint32_t code = codes[face];
+            uint32_t rot = (rotations[face >> 2] >> ((face & 3) * 2)) & 3;
+            uint32_t edge = code >> 4;
+
+            if (rot > 2)
+                return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+            uint32_t a, b, c;
+            if (edge != c_NoEdge)
+            {
+                const uint32_t* e = state.get_edge(edge);
+                a = e[0];
+                b = e[1];
+
+                if (!DecodeVertex(state, code & 0xf, tail, end, c))
+                    return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+            }
+            else
+            {
+                if (tail >= end)
+                    return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+                uint32_t aux = *tail++;
+
+                if (!DecodeVertex(state, aux >> 4, tail, end, a)
+                    || !DecodeVertex(state, aux & 0xf, tail, end, b)
+                    || !DecodeVertex(state, code & 0xf, tail, end, c))
+                    return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+            }
+
+            if (a > index_t(-1) || b > index_t(-1) || c > index_t(-1))
+                return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+            index_t* tri = &indices[face * 3];
+            tri[rot] = index_t(a);
+            tri[(rot + 1) % 3] = index_t(b);
+            tri[(rot + 2) % 3] = index_t(c);
+
+            state.push_face_edges(a, b, c, edge != c_NoEdge);
+        }
+
+        if (tail != end)
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+        return S_OK;
+    }
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+_Use_decl_annotations_
+HRESULT DirectX::CompressIndexBuffer(
+    const uint16_t* indices, size_t nFaces, std::vector<uint8_t>& compressed)
+{
+    return CompressIndexBufferImpl<uint16_t>(indices, nFaces, compressed);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::CompressIndexBuffer(
+    const uint32_t* indices, size_t nFaces, std::vector<uint8_t>& compressed)
+{
+    return CompressIndexBufferImpl<uint32_t>(indices, nFaces, compressed);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::DecompressIndexBuffer(
+    const uint8_t* compressed, size_t size, uint16_t* indices, size_t nFaces)
+{
+    return DecompressIndexBufferImpl<uint16_t>(compressed, size, indices, nFaces);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::DecompressIndexBuffer(
+    const uint8_t* compressed, size_t size, uint32_t* indices, size_t nFaces)
+{
+    return DecompressIndexBufferImpl<uint32_t>(compressed, size, indices, nFaces);
+}
@@ -0,0 +1,564 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshMeshlet.cpp
+//
+// DirectX Mesh Geometry Library - Meshlet generation
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+namespace
+{
+    //---------------------------------------------------------------------------------
+    // Meshlet under construction. Global to local vertex lookups use a per-vertex
+    // table that is restored when the meshlet is flushed.
+    //---------------------------------------------------------------------------------
+    class meshlet_builder
+    {
+    public:
+        meshlet_builder() noexcept : mMaxVerts(0), mMaxPrims(0), mPrimCount(0) {}
+
+        HRESULT initialize(size_t nVerts, size_t maxVerts, size_t maxPrims)
+        {
+            if (!nVerts || !maxVerts || !maxPrims)
+                return E_INVALIDARG;
+
+            mLocalIndex.reset(new (std::nothrow) uint32_t[nVerts]);
+            if (!mLocalIndex)
+                return E_OUTOFMEMORY;
+
+            memset(mLocalIndex.get(), 0xff, sizeof(uint32_t) * nVerts);
+
+            mVerts.reserve(maxVerts);
+            mMaxVerts = maxVerts;
+            mMaxPrims = maxPrims;
+            mPrimCount = 0;
+
+            return S_OK;
+        }
+
+        bool fits(uint32_t i0, uint32_t i1, uint32_t i2) const
+        {
+            if (mPrimCount >= mMaxPrims)
+                return false;
+
+            size_t newVerts = 0;
+            if (mLocalIndex[i0] == UNUSED32)
+                ++newVerts;
+            if (mLocalIndex[i1] == UNUSED32 && i1 != i0)
+                ++newVerts;
+            if (mLocalIndex[i2] == UNUSED32 && i2 != i0 && i2 != i1)
+                ++newVerts;
+
+            return (mVerts.size() + newVerts) <= mMaxVerts;
+        }
+
+        void add(uint32_t i0, uint32_t i1, uint32_t i2, std::vector<MeshletTriangle>& primitiveIndices)
+        {
+            assert(fits(i0, i1, i2));
+
+            MeshletTriangle tri;
+            tri.i0 = local(i0);
+            tri.i1 = local(i1);
+            tri.i2 = local(i2);
+            primitiveIndices.push_back(tri);
+
+            ++mPrimCount;
+        }
+
+        template<class index_t>
+        void flush(std::vector<Meshlet>& meshlets, std::vector<uint8_t>& uniqueVertexIB, size_t primOffset)
+        {
+            if (!mPrimCount)
+                return;
+
+            Meshlet m;
+            m.VertCount = static_cast<uint32_t>(mVerts.size());
+            m.VertOffset = static_cast<uint32_t>(uniqueVertexIB.size() / sizeof(index_t));
+            m.PrimCount = static_cast<uint32_t>(mPrimCount);
+            m.PrimOffset = static_cast<uint32_t>(primOffset);
+            meshlets.push_back(m);
+
+            size_t start = uniqueVertexIB.size();
+            uniqueVertexIB.resize(start + mVerts.size() * sizeof(index_t));
+
+            auto dest = reinterpret_cast<index_t*>(uniqueVertexIB.data() + start);
+            for (auto it = mVerts.cbegin(); it != mVerts.cend(); ++it)
+            {
+                *(dest++) = static_cast<index_t>(*it);
+                mLocalIndex[*it] = UNUSED32;
+            }
+
+            mVerts.clear();
+            mPrimCount = 0;
+        }
+
+    private:
+        uint8_t local(uint32_t v)
+        {
+            if (mLocalIndex[v] == UNUSED32)
+            {
+                mLocalIndex[v] = static_cast<uint32_t>(mVerts.size());
+                mVerts.push_back(v);
+            }
+
+            assert(mLocalIndex[v] < MESHLET_MAXIMUM_SIZE);
+            return static_cast<uint8_t>(mLocalIndex[v]);
+        }
+
+        size_t                      mMaxVerts;
+        size_t                      mMaxPrims;
+        size_t                      mPrimCount;
+        std::vector<uint32_t>       mVerts;
+        std::unique_ptr<uint32_t[]> mLocalIndex;
+    };
+
+
+    //---------------------------------------------------------------------------------
+    // Greedily fills meshlets by walking the vertex cache optimized face order, growing
+    // each meshlet through face adjacency first so that it stays spatially compact
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT ComputeMeshletsImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        std::vector<Meshlet>& meshlets,
+        std::vector<uint8_t>& uniqueVertexIB,
+        std::vector<MeshletTriangle>& primitiveIndices,
+        _Inout_opt_ std::vector<std::pair<size_t, size_t>>* meshletSubsets,
+        size_t maxVerts, size_t maxPrims)
+    {
+        if (!indices || !nFaces || !nVerts || !adjacency)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        if (maxVerts < MESHLET_MINIMUM_SIZE || maxVerts > MESHLET_MAXIMUM_SIZE
+            || maxPrims < MESHLET_MINIMUM_SIZE || maxPrims > MESHLET_MAXIMUM_SIZE)
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        for (size_t j = 0; j < (nFaces * 3); ++j)
+        {
+            index_t i = indices[j];
+            if (i != index_t(-1) && i >= nVerts)
+                return E_UNEXPECTED;
+        }
+
+        std::unique_ptr<uint32_t[]> faceRemap(new (std::nothrow) uint32_t[nFaces]);
+        std::unique_ptr<bool[]> processed(new (std::nothrow) bool[nFaces]);
+        if (!faceRemap || !processed)
+            return E_OUTOFMEMORY;
+
+        HRESULT hr = (attributes)
+            ? OptimizeFacesLRUEx(indices, nFaces, attributes, faceRemap.get())
+            : OptimizeFacesLRU(indices, nFaces, faceRemap.get());
+        if (FAILED(hr))
+            return hr;
+
+        meshlet_builder builder;
+        hr = builder.initialize(nVerts, maxVerts, maxPrims);
+        if (FAILED(hr))
+            return hr;
+
+        meshlets.clear();
+        uniqueVertexIB.clear();
+        primitiveIndices.clear();
+        primitiveIndices.reserve(nFaces);
+
+        if (meshletSubsets)
+        {
+            meshletSubsets->clear();
+        }
+
+        auto subsets = ComputeSubsets(attributes, nFaces);
+
+        if (subsets.empty())
+            return E_UNEXPECTED;
+
+        std::vector<uint32_t> candidates;
+
+        for (auto it = subsets.cbegin(); it != subsets.cend(); ++it)
+        {
+            const size_t faceBegin = it->first;
+            const size_t faceEnd = it->first + it->second;
+
+            if (faceEnd > nFaces)
+                return E_UNEXPECTED;
+
+            const size_t firstMeshlet = meshlets.size();
+
+            for (size_t j = faceBegin; j < faceEnd; ++j)
+            {
+                processed[j] = false;
+            }
+
+            auto tryAdd = [&](uint32_t face) -> bool
+            {
+                index_t i0 = indices[face * 3];
+                index_t i1 = indices[face * 3 + 1];
+                index_t i2 = indices[face * 3 + 2];
+
+                if (i0 == index_t(-1)
+                    || i1 == index_t(-1)
+                    || i2 == index_t(-1))
+                    return false;
+
+                if (!builder.fits(i0, i1, i2))
+                    return false;
+
+                builder.add(i0, i1, i2, primitiveIndices);
+                processed[face] = true;
+
+                for (size_t point = 0; point < 3; ++point)
+                {
+                    uint32_t neighbor = adjacency[face * 3 + point];
+                    if (neighbor != UNUSED32 && neighbor >= faceBegin && neighbor < faceEnd && !processed[neighbor])
+                    {
+                        candidates.push_back(neighbor);
+                    }
+                }
+
+                return true;
+            };
+
+            size_t primOffset = primitiveIndices.size();
+            size_t cursor = faceBegin;
+            size_t nextCandidate = 0;
+
+            for (;;)
+            {
+                // grow the current meshlet from its neighbors
+                bool added = false;
+                while (nextCandidate < candidates.size())
+                {
+                    uint32_t face = candidates[nextCandidate++];
+                    if (!processed[face] && tryAdd(face))
+                    {
+                        added = true;
+                        break;
+                    }
+                }
+
+                if (added)
+                    continue;
+
+                // otherwise continue with the next face in vertex cache order
+                for (; cursor < faceEnd; ++cursor)
+                {
+                    uint32_t face = faceRemap[cursor];
+                    if (face == UNUSED32)
+                    {
+                        // faces with unused indices are at the end of the subset
+                        cursor = faceEnd;
+                        break;
+                    }
+
+                    if (!processed[face])
+                        break;
+                }
+
+                if (cursor >= faceEnd)
+                    break;
+
+                if (!tryAdd(faceRemap[cursor]))
+                {
+                    builder.flush<index_t>(meshlets, uniqueVertexIB, primOffset);
+                    primOffset = primitiveIndices.size();
+                    candidates.clear();
+                    nextCandidate = 0;
+
+                    if (!tryAdd(faceRemap[cursor]))
+                        return E_UNEXPECTED;
+                }
+            }
+
+            builder.flush<index_t>(meshlets, uniqueVertexIB, primOffset);
+            candidates.clear();
+
+            if (meshletSubsets)
+            {
+                meshletSubsets->emplace_back(firstMeshlet, meshlets.size() - firstMeshlet);
+            }
+        }
+
+        return S_OK;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT ComputeCullDataImpl(
+        _In_reads_(nVerts) const XMFLOAT3* positions, size_t nVerts,
+        _In_reads_(nMeshlets) const Meshlet* meshlets, size_t nMeshlets,
+        _In_reads_(nVertIndices) const index_t* uniqueVertexIndices, size_t nVertIndices,
+        _In_reads_(nPrimIndices) const MeshletTriangle* primitiveIndices, size_t nPrimIndices,
+        _Out_writes_(nMeshlets) MeshletCullData* cullData)
+    {
+        if (!positions || !nVerts || !meshlets || !nMeshlets || !uniqueVertexIndices || !primitiveIndices || !cullData)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        std::vector<XMFLOAT3> points;
+        std::vector<XMFLOAT3> normals;
+        points.reserve(MESHLET_MAXIMUM_SIZE);
+        normals.reserve(MESHLET_MAXIMUM_SIZE);
+
+        for (size_t mi = 0; mi < nMeshlets; ++mi)
+        {
+            const Meshlet& m = meshlets[mi];
+
+            if ((uint64_t(m.VertOffset) + m.VertCount) > nVertIndices
+                || (uint64_t(m.PrimOffset) + m.PrimCount) > nPrimIndices
+                || !m.VertCount || !m.PrimCount)
+                return E_UNEXPECTED;
+
+            points.clear();
+            for (uint32_t j = 0; j < m.VertCount; ++j)
+            {
+                index_t v = uniqueVertexIndices[m.VertOffset + j];
+                if (v >= nVerts)
+                    return E_UNEXPECTED;
+
+                points.push_back(positions[v]);
+            }
+
+            // Ritter's bounding sphere
+            XMVECTOR p0 = XMLoadFloat3(&points[0]);
+            XMVECTOR a = p0;
+            XMVECTOR maxDist = XMVectorZero();
+            for (auto it = points.cbegin(); it != points.cend(); ++it)
+            {
+                XMVECTOR p = XMLoadFloat3(&*it);
+                XMVECTOR dist = XMVector3LengthSq(XMVectorSubtract(p, p0));
+                if (XMVector3Greater(dist, maxDist))
+                {
+                    maxDist = dist;
+                    a = p;
+                }
+            }
+
+            XMVECTOR b = a;
+            maxDist = XMVectorZero();
+            for (auto it = points.cbegin(); it != points.cend(); ++it)
+            {
+                XMVECTOR p = XMLoadFloat3(&*it);
+                XMVECTOR dist = XMVector3LengthSq(XMVectorSubtract(p, a));
+                if (XMVector3Greater(dist, maxDist))
+                {
+                    maxDist = dist;
+                    b = p;
+                }
+            }
+
+            XMVECTOR center = XMVectorScale(XMVectorAdd(a, b), 0.5f);
+            float radius = XMVectorGetX(XMVector3Length(XMVectorSubtract(b, a))) * 0.5f;
+
+            for (auto it = points.cbegin(); it != points.cend(); ++it)
+            {
+                XMVECTOR p = XMLoadFloat3(&*it);
+                float dist = XMVectorGetX(XMVector3Length(XMVectorSubtract(p, center)));
+                if (dist > radius)
+                {
+                    // grow the sphere to just include the point
+                    float newRadius = (radius + dist) * 0.5f;
+                    center = XMVectorAdd(center, XMVectorScale(XMVectorSubtract(p, center), (newRadius - radius) / dist));
+                    radius = newRadius;
+                }
+            }
+
+            MeshletCullData& cull = cullData[mi];
+            XMStoreFloat4(&cull.BoundingSphere, XMVectorSetW(center, radius));
+
+            // Normal cone
+            normals.clear();
+            XMVECTOR axis = XMVectorZero();
+            for (uint32_t j = 0; j < m.PrimCount; ++j)
+            {
+                const MeshletTriangle& tri = primitiveIndices[m.PrimOffset + j];
+                if (tri.i0 >= m.VertCount || tri.i1 >= m.VertCount || tri.i2 >= m.VertCount)
+                    return E_UNEXPECTED;
+
+                XMVECTOR v0 = XMLoadFloat3(&points[tri.i0]);
+                XMVECTOR v1 = XMLoadFloat3(&points[tri.i1]);
+                XMVECTOR v2 = XMLoadFloat3(&points[tri.i2]);
+
+                XMVECTOR n = XMVector3Cross(XMVectorSubtract(v1, v0), XMVectorSubtract(v2, v0));
+                if (XMVector3Equal(n, XMVectorZero()))
+                    continue;
+
+                n = XMVector3Normalize(n);
+                axis = XMVectorAdd(axis, n);
+
+                XMFLOAT3 tmp;
+                XMStoreFloat3(&tmp, n);
+                normals.push_back(tmp);
+            }
+
+            cull.ConeApex = XMFLOAT3(0.f, 0.f, 0.f);
+            cull.ConeAxis = XMFLOAT3(0.f, 0.f, 0.f);
+            cull.ConeCutoff = 1.f;
+
+            if (normals.empty() || XMVector3Equal(axis, XMVectorZero()))
+                continue;
+
+            axis = XMVector3Normalize(axis);
+
+            float minDot = 1.f;
+            for (auto it = normals.cbegin(); it != normals.cend(); ++it)
+            {
+                float d = XMVectorGetX(XMVector3Dot(XMLoadFloat3(&*it), axis));
+                minDot = std::min(minDot, d);
+            }
+
+            if (minDot <= 0.1f)
+            {
+                // normals span too wide an angle for cone culling
+                continue;
+            }
+
+            XMStoreFloat3(&cull.ConeAxis, axis);
+
+            // move the apex back along the axis until it is behind every triangle plane
+            float maxT = 0.f;
+            size_t n = 0;
+            for (uint32_t j = 0; j < m.PrimCount; ++j)
+            {
+                const MeshletTriangle& tri = primitiveIndices[m.PrimOffset + j];
+
+                XMVECTOR v0 = XMLoadFloat3(&points[tri.i0]);
+                XMVECTOR v1 = XMLoadFloat3(&points[tri.i1]);
+                XMVECTOR v2 = XMLoadFloat3(&points[tri.i2]);
+
+                XMVECTOR fn = XMVector3Cross(XMVectorSubtract(v1, v0), XMVectorSubtract(v2, v0));
+                if (XMVector3Equal(fn, XMVectorZero()))
+                    continue;
+
+                XMVECTOR normal = XMLoadFloat3(&normals[n++]);
+
+                float dc = XMVectorGetX(XMVector3Dot(XMVectorSubtract(center, v0), normal));
+                float dn = XMVectorGetX(XMVector3Dot(axis, normal));
+
+                assert(dn > 0.f);
+                maxT = std::max(maxT, dc / dn);
+            }
+
+            XMStoreFloat3(&cull.ConeApex, XMVectorSubtract(center, XMVectorScale(axis, maxT)));
+
+            // cos(90 - half angle) so that the test is dot(normalize(apex - eye), axis) >= cutoff
+            cull.ConeCutoff = sqrtf(1.f - minDot * minDot);
+        }
+
+        return S_OK;
+    }
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+_Use_decl_annotations_
+HRESULT DirectX::ComputeMeshlets(
+    const uint16_t* indices, size_t nFaces,
+    size_t nVerts,
+    const uint32_t* adjacency,
+    std::vector<Meshlet>& meshlets,
+    std::vector<uint8_t>& uniqueVertexIB,
+    std::vector<MeshletTriangle>& primitiveIndices,
+    size_t maxVerts, size_t maxPrims)
+{
+    return ComputeMeshletsImpl<uint16_t>(indices, nFaces, nVerts, adjacency, nullptr,
+        meshlets, uniqueVertexIB, primitiveIndices, nullptr, maxVerts, maxPrims);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::ComputeMeshlets(
+    const uint32_t* indices, size_t nFaces,
+    size_t nVerts,
+    const uint32_t* adjacency,
+    std::vector<Meshlet>& meshlets,
+    std::vector<uint8_t>& uniqueVertexIB,
+    std::vector<MeshletTriangle>& primitiveIndices,
+    size_t maxVerts, size_t maxPrims)
+{
+    return ComputeMeshletsImpl<uint32_t>(indices, nFaces, nVerts, adjacency, nullptr,
+        meshlets, uniqueVertexIB, primitiveIndices, nullptr, maxVerts, maxPrims);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ComputeMeshletsEx(
+    const uint16_t* indices, size_t nFaces,
+    size_t nVerts,
+    const uint32_t* adjacency,
+    const uint32_t* attributes,
+    std::vector<Meshlet>& meshlets,
+    std::vector<uint8_t>& uniqueVertexIB,
+    std::vector<MeshletTriangle>& primitiveIndices,
+    std::vector<std::pair<size_t, size_t>>& meshletSubsets,
+    size_t maxVerts, size_t maxPrims)
+{
+    if (!attributes)
+        return E_INVALIDARG;
+
+    return ComputeMeshletsImpl<uint16_t>(indices, nFaces, nVerts, adjacency, attributes,
+        meshlets, uniqueVertexIB, primitiveIndices, &meshletSubsets, maxVerts, maxPrims);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::ComputeMeshletsEx(
+    const uint32_t* indices, size_t nFaces,
+    size_t nVerts,
+    const uint32_t* adjacency,
+    const uint32_t* attributes,
+    std::vector<Meshlet>& meshlets,
+    std::vector<uint8_t>& uniqueVertexIB,
+    std::vector<MeshletTriangle>& primitiveIndices,
+    std::vector<std::pair<size_t, size_t>>& meshletSubsets,
+    size_t maxVerts, size_t maxPrims)
+{
+    if (!attributes)
+        return E_INVALIDARG;
+
+    return ComputeMeshletsImpl<uint32_t>(indices, nFaces, nVerts, adjacency, attributes,
+        meshlets, uniqueVertexIB, primitiveIndices, &meshletSubsets, maxVerts, maxPrims);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ComputeCullData(
+    const XMFLOAT3* positions, size_t nVerts,
+    const Meshlet* meshlets, size_t nMeshlets,
+    const uint16_t* uniqueVertexIndices, size_t nVertIndices,
+    const MeshletTriangle* primitiveIndices, size_t nPrimIndices,
+    MeshletCullData* cullData)
+{
+    return ComputeCullDataImpl<uint16_t>(positions, nVerts, meshlets, nMeshlets,
+        uniqueVertexIndices, nVertIndices, primitiveIndices, nPrimIndices, cullData);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::ComputeCullData(
+    const XMFLOAT3* positions, size_t nVerts,
+    const Meshlet* meshlets, size_t nMeshlets,
+    const uint32_t* uniqueVertexIndices, size_t nVertIndices,
+    const MeshletTriangle* primitiveIndices, size_t nPrimIndices,
+    MeshletCullData* cullData)
+{
+    return ComputeCullDataImpl<uint32_t>(positions, nVerts, meshlets, nMeshlets,
+        uniqueVertexIndices, nVertIndices, primitiveIndices, nPrimIndices, cullData);
+}
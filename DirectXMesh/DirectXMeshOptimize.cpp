@@ -15,6 +15,177 @@ using namespace DirectX;
 
 namespace
 {
+    // Faces per block of the parallel sort, and bits per radix digit
+    const size_t c_SortBlock = 65536;
+    const uint32_t c_RadixBits = 8;
+    const uint32_t c_RadixBuckets = 1u << c_RadixBits;
+
+    //---------------------------------------------------------------------------------
+    // One stable counting pass over the digit ((key - base) >> shift) of each face.
+    // Blocks of faces are counted, then scattered, in parallel; a null remapIn is the identity.
+    //---------------------------------------------------------------------------------
+    void RadixPass(
+        size_t nFaces,
+        _In_reads_(nFaces) const uint32_t* keysIn, _In_reads_opt_(nFaces) const uint32_t* remapIn,
+        _Out_writes_(nFaces) uint32_t* keysOut, _Out_writes_(nFaces) uint32_t* remapOut,
+        uint32_t base, uint32_t shift,
+        _Out_writes_(c_RadixBuckets) size_t* bucketTotals)
+    {
+        const size_t nBlocks = (nFaces + c_SortBlock - 1) / c_SortBlock;
+        std::vector<size_t> offsets(nBlocks * c_RadixBuckets, 0);
+
+        const int blockCount = static_cast<int>(nBlocks);
+
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif
+        for (int block = 0; block < blockCount; ++block)
+        {
+            const size_t first = size_t(block) * c_SortBlock;
+            const size_t last = std::min(first + c_SortBlock, nFaces);
+
+            size_t* counts = &offsets[size_t(block) * c_RadixBuckets];
+            for (size_t j = first; j < last; ++j)
+            {
+                ++counts[((keysIn[j] - base) >> shift) & (c_RadixBuckets - 1)];
+            }
+        }
+
+        // Each digit's faces go block by block, which keeps the pass stable
+        size_t offset = 0;
+        for (uint32_t digit = 0; digit < c_RadixBuckets; ++digit)
+        {
+            const size_t start = offset;
+            for (size_t block = 0; block < nBlocks; ++block)
+            {
+                const size_t count = offsets[block * c_RadixBuckets + digit];
+                offsets[block * c_RadixBuckets + digit] = offset;
+                offset += count;
+            }
+
+            bucketTotals[digit] = offset - start;
+        }
+
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif
+        for (int block = 0; block < blockCount; ++block)
+        {
+            const size_t first = size_t(block) * c_SortBlock;
+            const size_t last = std::min(first + c_SortBlock, nFaces);
+
+            size_t* cursors = &offsets[size_t(block) * c_RadixBuckets];
+            for (size_t j = first; j < last; ++j)
+            {
+                const uint32_t key = keysIn[j];
+                const size_t dest = cursors[((key - base) >> shift) & (c_RadixBuckets - 1)]++;
+                keysOut[dest] = key;
+                remapOut[dest] = remapIn ? remapIn[j] : uint32_t(j);
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Stable LSD radix sort of faces by attribute, on only the digits the attribute range needs.
+    // When a single pass is enough its bucket totals are the subsets, otherwise the sorted ids are scanned.
+    //---------------------------------------------------------------------------------
+    HRESULT AttributeSortImpl(
+        size_t nFaces,
+        _Inout_updates_all_(nFaces) uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        _Out_opt_ std::vector<std::pair<size_t, size_t>>* subsets)
+    {
+        if (!nFaces || !attributes || !faceRemap)
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        uint32_t minAttr = attributes[0];
+        uint32_t maxAttr = attributes[0];
+        for (size_t j = 1; j < nFaces; ++j)
+        {
+            minAttr = std::min(minAttr, attributes[j]);
+            maxAttr = std::max(maxAttr, attributes[j]);
+        }
+
+        const uint32_t range = maxAttr - minAttr;
+
+        uint32_t passes = 0;
+        for (uint32_t r = range; r > 0; r >>= c_RadixBits)
+        {
+            ++passes;
+        }
+
+        if (!passes)
+        {
+            // Already sorted
+            for (size_t j = 0; j < nFaces; ++j)
+            {
+                faceRemap[j] = uint32_t(j);
+            }
+
+            if (subsets)
+            {
+                subsets->clear();
+                subsets->emplace_back(std::pair<size_t, size_t>(0, nFaces));
+            }
+
+            return S_OK;
+        }
+
+        std::unique_ptr<uint32_t[]> temp(new (std::nothrow) uint32_t[nFaces * 2]);
+        if (!temp)
+            return E_OUTOFMEMORY;
+
+        uint32_t* keys[2] = { attributes, temp.get() };
+        uint32_t* remap[2] = { faceRemap, temp.get() + nFaces };
+
+        size_t bucketTotals[c_RadixBuckets];
+
+        // Passes alternate between the outputs and the temp, ending in the outputs,
+        // so an odd number of passes starts from a copy of the attributes
+        size_t src = 0;
+        if (passes & 1)
+        {
+            memcpy(keys[1], attributes, sizeof(uint32_t) * nFaces);
+            src = 1;
+        }
+
+        for (uint32_t pass = 0; pass < passes; ++pass)
+        {
+            const size_t dst = src ^ 1;
+            RadixPass(nFaces, keys[src], pass ? remap[src] : nullptr, keys[dst], remap[dst], minAttr, pass * c_RadixBits, bucketTotals);
+            src = dst;
+        }
+
+        assert(src == 0);
+
+        if (subsets)
+        {
+            if (passes == 1)
+            {
+                subsets->clear();
+
+                size_t offset = 0;
+                for (uint32_t digit = 0; digit < c_RadixBuckets; ++digit)
+                {
+                    if (bucketTotals[digit] > 0)
+                    {
+                        subsets->emplace_back(std::pair<size_t, size_t>(offset, bucketTotals[digit]));
+                        offset += bucketTotals[digit];
+                    }
+                }
+            }
+            else
+            {
+                *subsets = ComputeSubsets(attributes, nFaces);
+            }
+        }
+
+        return S_OK;
+    }
+
     template<class index_t>
     HRESULT OptimizeVerticesImpl(
         _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
@@ -96,34 +267,17 @@ _Use_decl_annotations_
 HRESULT DirectX::AttributeSort(
     size_t nFaces, uint32_t* attributes, uint32_t* faceRemap)
 {
-    if (!nFaces || !attributes || !faceRemap)
-        return E_INVALIDARG;
-
-    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
-        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
-
-    typedef std::pair<uint32_t, uint32_t> intpair_t;
-
-    std::vector<intpair_t> list;
-    list.reserve(nFaces);
-    for (uint32_t j = 0; j < nFaces; ++j)
-    {
-        list.emplace_back(intpair_t(attributes[j], j));
-    }
-
-    std::stable_sort(list.begin(), list.end(), [](const intpair_t& a, const intpair_t& b) -> bool
-    {
-        return (a.first < b.first);
-    });
+    return AttributeSortImpl(nFaces, attributes, faceRemap, nullptr);
+}
 
-    auto it = list.begin();
-    for (uint32_t j = 0; j < nFaces; ++j, ++it)
-    {
-        attributes[j] = it->first;
-        faceRemap[j] = it->second;
-    }
+_Use_decl_annotations_
+HRESULT DirectX::AttributeSort(
+    size_t nFaces, uint32_t* attributes, uint32_t* faceRemap,
+    std::vector<std::pair<size_t, size_t>>& subsets)
+{
+    subsets.clear();
 
-    return S_OK;
+    return AttributeSortImpl(nFaces, attributes, faceRemap, &subsets);
 }
 
 
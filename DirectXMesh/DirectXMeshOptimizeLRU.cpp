@@ -18,88 +18,176 @@ using namespace DirectX;
 
 namespace
 {
-    // This code was authored and released into the public domain by Adrian Stone (stone@gameangst.com).
+    //---------------------------------------------------------------------------------
+    // Tuning parameters for the vertex scoring function. OptimizeFacesImpl takes the
+    // policy as a template parameter so the score tables are built at compile time.
+    //---------------------------------------------------------------------------------
+    struct ForsythScoringPolicy
+    {
+        static constexpr double CacheDecayPower = 1.5;
+        static constexpr double LastTriScore = 0.75;
+        static constexpr double ValenceBoostScale = 2.0;
+        static constexpr double ValenceBoostPower = 0.5;
+    };
 
-    // code for computing vertex score was taken, as much as possible
-    // directly from the original publication.
-    float ComputeVertexCacheScore(int cachePosition, uint32_t vertexCacheSize)
+    enum { kMaxVertexCacheSize = 64 };
+    enum { kMaxPrecomputedVertexValenceScores = 64 };
+
+    //---------------------------------------------------------------------------------
+    // constexpr math helpers (written as single return statements for VS 2015)
+    //---------------------------------------------------------------------------------
+    constexpr double c_ln2 = 0.693147180559945309417;
+
+    constexpr double cexp_series(double x, double term, double sum, int n)
     {
-        const float FindVertexScore_CacheDecayPower = 1.5f;
-        const float FindVertexScore_LastTriScore = 0.75f;
+        return (n > 24) ? sum : cexp_series(x, term * x / n, sum + term * x / n, n + 1);
+    }
 
-        float score = 0.0f;
-        if (cachePosition < 0)
-        {
-            // Vertex is not in FIFO cache - no score.
-        }
-        else
-        {
-            if (cachePosition < 3)
-            {
-                // This vertex was used in the last triangle,
-                // so it has a fixed score, whichever of the three
-                // it's in. Otherwise, you can get very different
-                // answers depending on whether you add
-                // the triangle 1,2,3 or 3,1,2 - which is silly.
+    constexpr double csquare(double x)
+    {
+        return x * x;
+    }
 
-                score = FindVertexScore_LastTriScore;
-            }
-            else
-            {
-                assert(cachePosition < int(vertexCacheSize));
+    constexpr double cexp(double x)
+    {
+        return (x > 0.5 || x < -0.5) ? csquare(cexp(x * 0.5)) : cexp_series(x, 1.0, 1.0, 1);
+    }
 
-                // Points for being high in the cache.
-                const float scaler = 1.0f / (vertexCacheSize - 3);
-                score = 1.0f - (cachePosition - 3) * scaler;
-                score = powf(score, FindVertexScore_CacheDecayPower);
-            }
-        }
+    constexpr double cln_series(double z2, double term, double sum, int n)
+    {
+        return (n > 24) ? sum : cln_series(z2, term * z2, sum + term * z2 / (2 * n + 1), n + 1);
+    }
 
-        return score;
+    constexpr double cln(double x)
+    {
+        // Reduce to [1,2) then ln(x) = 2 atanh((x - 1) / (x + 1))
+        return (x >= 2.0) ? cln(x * 0.5) + c_ln2
+            : (x < 1.0) ? cln(x * 2.0) - c_ln2
+            : 2.0 * cln_series(csquare((x - 1.0) / (x + 1.0)), (x - 1.0) / (x + 1.0), (x - 1.0) / (x + 1.0), 1);
     }
 
-    float ComputeVertexValenceScore(uint32_t numActiveFaces)
+    constexpr double cpow(double x, double y)
     {
-        const float FindVertexScore_ValenceBoostScale = 2.0f;
-        const float FindVertexScore_ValenceBoostPower = 0.5f;
+        return (x <= 0.0) ? 0.0 : cexp(y * cln(x));
+    }
 
-        float score = 0.f;
+    // This code was authored and released into the public domain by Adrian Stone (stone@gameangst.com).
 
+    // code for computing vertex score was taken, as much as possible
+    // directly from the original publication.
+    template<class Policy>
+    constexpr float ComputeVertexCacheScore(uint32_t cachePosition, uint32_t vertexCacheSize)
+    {
+        // If the vertex is not in FIFO cache - no score.
+        //
+        // If this vertex was used in the last triangle,
+        // so it has a fixed score, whichever of the three
+        // it's in. Otherwise, you can get very different
+        // answers depending on whether you add
+        // the triangle 1,2,3 or 3,1,2 - which is silly.
+        //
+        // Otherwise points for being high in the cache.
+        return (cachePosition >= vertexCacheSize) ? 0.f
+            : (cachePosition < 3) ? float(Policy::LastTriScore)
+            : float(cpow(1.0 - double(cachePosition - 3) / double(vertexCacheSize - 3), Policy::CacheDecayPower));
+    }
+
+    template<class Policy>
+    constexpr float ComputeVertexValenceScore(uint32_t numActiveFaces)
+    {
         // Bonus points for having a low number of tris still to
         // use the vert, so we get rid of lone verts quickly.
-        float valenceBoost = powf(static_cast<float>(numActiveFaces),
-            -FindVertexScore_ValenceBoostPower);
+        return (numActiveFaces == 0) ? 0.f
+            : float(Policy::ValenceBoostScale * cpow(double(numActiveFaces), -Policy::ValenceBoostPower));
+    }
 
-        score += FindVertexScore_ValenceBoostScale * valenceBoost;
-        return score;
+    //---------------------------------------------------------------------------------
+    // Score tables generated at compile time
+    //---------------------------------------------------------------------------------
+    template<size_t N>
+    struct score_table
+    {
+        float value[N];
+    };
+
+    template<class Policy, size_t... Pos>
+    constexpr score_table<sizeof...(Pos)> MakeCacheScores(uint32_t cacheSize, std::index_sequence<Pos...>)
+    {
+        return { { ComputeVertexCacheScore<Policy>(uint32_t(Pos), cacheSize)... } };
     }
 
-    enum { kMaxVertexCacheSize = 64 };
-    enum { kMaxPrecomputedVertexValenceScores = 64 };
+    template<class Policy, size_t... Index>
+    constexpr score_table<sizeof...(Index)> MakeAllCacheScores(std::index_sequence<Index...>)
+    {
+        // Flattened [cacheSize][cachePosition] table
+        return { { ComputeVertexCacheScore<Policy>(uint32_t(Index % kMaxVertexCacheSize), uint32_t(Index / kMaxVertexCacheSize))... } };
+    }
 
-    float s_vertexCacheScores[kMaxVertexCacheSize + 1][kMaxVertexCacheSize];
-    float s_vertexValenceScores[kMaxPrecomputedVertexValenceScores];
+    template<class Policy, size_t... Valence>
+    constexpr score_table<sizeof...(Valence)> MakeValenceScores(std::index_sequence<Valence...>)
+    {
+        return { { ComputeVertexValenceScore<Policy>(uint32_t(Valence))... } };
+    }
+
+    // Cache scores for a cache size known at compile time
+    template<class Policy, uint32_t CacheSize>
+    struct vertex_scores
+    {
+        static_assert(CacheSize > 0 && CacheSize <= kMaxVertexCacheSize, "Invalid vertex cache size");
+
+        static float cache(uint32_t cachePosition, uint32_t)
+        {
+            assert(cachePosition < CacheSize);
+            return sCacheScores.value[cachePosition];
+        }
 
-    static INIT_ONCE s_initOnce = INIT_ONCE_STATIC_INIT;
+        static constexpr score_table<CacheSize> sCacheScores
+            = MakeCacheScores<Policy>(CacheSize, std::make_index_sequence<CacheSize>());
+    };
+
+    template<class Policy, uint32_t CacheSize>
+    constexpr score_table<CacheSize> vertex_scores<Policy, CacheSize>::sCacheScores;
 
-    BOOL WINAPI ComputeVertexScores(PINIT_ONCE, PVOID, PVOID*)
+    // Cache scores for a cache size only known at runtime
+    template<class Policy>
+    struct vertex_scores<Policy, 0>
     {
-        for (uint32_t cacheSize = 0; cacheSize <= kMaxVertexCacheSize; ++cacheSize)
+        static float cache(uint32_t cachePosition, uint32_t vertexCacheSize)
         {
-            for (uint32_t cachePos = 0; cachePos < cacheSize; ++cachePos)
-            {
-                s_vertexCacheScores[cacheSize][cachePos] = ComputeVertexCacheScore(cachePos, cacheSize);
-            }
+            assert(vertexCacheSize <= kMaxVertexCacheSize);
+            assert(cachePosition < vertexCacheSize);
+            return sCacheScores.value[vertexCacheSize * kMaxVertexCacheSize + cachePosition];
         }
 
-        for (uint32_t valence = 0; valence < kMaxPrecomputedVertexValenceScores; ++valence)
+        static constexpr score_table<(kMaxVertexCacheSize + 1) * kMaxVertexCacheSize> sCacheScores
+            = MakeAllCacheScores<Policy>(std::make_index_sequence<(kMaxVertexCacheSize + 1) * kMaxVertexCacheSize>());
+    };
+
+    template<class Policy>
+    constexpr score_table<(kMaxVertexCacheSize + 1) * kMaxVertexCacheSize> vertex_scores<Policy, 0>::sCacheScores;
+
+    template<class Policy>
+    struct valence_scores
+    {
+        static float valence(uint32_t numActiveFaces)
         {
-            s_vertexValenceScores[valence] = ComputeVertexValenceScore(valence);
+            if (numActiveFaces < kMaxPrecomputedVertexValenceScores)
+            {
+                return sValenceScores.value[numActiveFaces];
+            }
+
+            float valenceBoost = powf(static_cast<float>(numActiveFaces), -float(Policy::ValenceBoostPower));
+            return float(Policy::ValenceBoostScale) * valenceBoost;
         }
 
-        return TRUE;
-    }
+        static constexpr score_table<kMaxPrecomputedVertexValenceScores> sValenceScores
+            = MakeValenceScores<Policy>(std::make_index_sequence<kMaxPrecomputedVertexValenceScores>());
+    };
+
+    template<class Policy>
+    constexpr score_table<kMaxPrecomputedVertexValenceScores> valence_scores<Policy>::sValenceScores;
 
+    template<class Policy, uint32_t CacheSize>
     float FindVertexScore(uint32_t numActiveFaces, uint32_t cachePosition, uint32_t vertexCacheSize)
     {
         if (numActiveFaces == 0)
@@ -113,17 +201,10 @@ namespace
 
         if (cachePosition < vertexCacheSize)
         {
-            score += s_vertexCacheScores[vertexCacheSize][cachePosition];
+            score += vertex_scores<Policy, CacheSize>::cache(cachePosition, vertexCacheSize);
         }
 
-        if (numActiveFaces < kMaxPrecomputedVertexValenceScores)
-        {
-            score += s_vertexValenceScores[numActiveFaces];
-        }
-        else
-        {
-            score += ComputeVertexValenceScore(numActiveFaces);
-        }
+        score += valence_scores<Policy>::valence(numActiveFaces);
 
         return score;
     }
@@ -160,37 +241,153 @@ namespace
         }
     };
 
-    template <typename T, typename IndexType>
-    struct FaceValenceSort
+    //---------------------------------------------------------------------------------
+    // Bucket queue of unprocessed faces keyed by total valence (the sum of the active
+    // face counts of the face's vertices). Keys only ever decrease, so extracting the
+    // minimum is amortized constant time over the whole optimization.
+    class face_queue
     {
-        const OptimizeVertexData<IndexType> *_vertexData;
+    public:
+        face_queue() noexcept : mMinKey(0), mMaxKey(0), mFaceCount(0) {}
+
+        HRESULT initialize(uint32_t faceCount, uint32_t maxKey)
+        {
+            if (!faceCount || maxKey == UINT32_MAX)
+                return E_INVALIDARG;
 
-        FaceValenceSort(const OptimizeVertexData<IndexType> *vertexData) : _vertexData(vertexData) { }
+            mBuckets.reset(new (std::nothrow) uint32_t[size_t(maxKey) + 1]);
+            mListElements.reset(new (std::nothrow) listElement[faceCount]);
+            if (!mBuckets || !mListElements)
+                return E_OUTOFMEMORY;
 
-        bool operator()(T a, T b) const
+            memset(mBuckets.get(), 0xff, sizeof(uint32_t) * (size_t(maxKey) + 1));
+
+            for (uint32_t j = 0; j < faceCount; ++j)
+            {
+                mListElements[j].key = UNUSED32;
+                mListElements[j].prev = mListElements[j].next = UNUSED32;
+            }
+
+            mMinKey = maxKey + 1;
+            mMaxKey = maxKey;
+            mFaceCount = faceCount;
+
+            return S_OK;
+        }
+
+        void insert(uint32_t face, uint32_t key)
         {
-            const OptimizeVertexData<IndexType> *vA = _vertexData + size_t(a) * 3;
-            const OptimizeVertexData<IndexType> *vB = _vertexData + size_t(b) * 3;
+            assert(face < mFaceCount);
+            assert(key <= mMaxKey);
+            assert(mListElements[face].key == UNUSED32);
 
-            int aValence = vA[0].activeFaceListSize + vA[1].activeFaceListSize + vA[2].activeFaceListSize;
-            int bValence = vB[0].activeFaceListSize + vB[1].activeFaceListSize + vB[2].activeFaceListSize;
+            mListElements[face].key = key;
+            push_front(face);
+        }
 
-            // higher scoring faces are those with lower valence totals
+        void decrement(uint32_t face)
+        {
+            assert(face < mFaceCount);
 
-            // reverse sort (reverse of reverse)
+            if (mListElements[face].key == UNUSED32)
+            {
+                // not queued or already processed
+                return;
+            }
 
-            if (aValence < bValence)
-                return true;
+            assert(mListElements[face].key > 0);
 
-            return false;
+            remove_from_bucket(face);
+            mListElements[face].key -= 1;
+            push_front(face);
+        }
+
+        void remove(uint32_t face)
+        {
+            assert(face < mFaceCount);
+
+            if (mListElements[face].key == UNUSED32)
+                return;
+
+            remove_from_bucket(face);
+            mListElements[face].key = UNUSED32;
+        }
+
+        uint32_t find_min()
+        {
+            for (; mMinKey <= mMaxKey; ++mMinKey)
+            {
+                if (mBuckets[mMinKey] != UNUSED32)
+                    return mBuckets[mMinKey];
+            }
+
+            return UNUSED32;
+        }
+
+    private:
+        void push_front(uint32_t face)
+        {
+            uint32_t key = mListElements[face].key;
+            uint32_t head = mBuckets[key];
+
+            mListElements[face].prev = UNUSED32;
+            mListElements[face].next = head;
+
+            if (head != UNUSED32)
+                mListElements[head].prev = face;
+
+            mBuckets[key] = face;
+
+            if (key < mMinKey)
+                mMinKey = key;
         }
+
+        void remove_from_bucket(uint32_t face)
+        {
+            uint32_t prev = mListElements[face].prev;
+            uint32_t next = mListElements[face].next;
+
+            if (prev != UNUSED32)
+            {
+                mListElements[prev].next = next;
+            }
+            else
+            {
+                // remove head of the list
+                assert(mBuckets[mListElements[face].key] == face);
+                mBuckets[mListElements[face].key] = next;
+            }
+
+            if (next != UNUSED32)
+                mListElements[next].prev = prev;
+
+            mListElements[face].prev = mListElements[face].next = UNUSED32;
+        }
+
+        struct listElement
+        {
+            uint32_t    key;
+            uint32_t    prev;
+            uint32_t    next;
+        };
+
+        uint32_t                        mMinKey;
+        uint32_t                        mMaxKey;
+        uint32_t                        mFaceCount;
+        std::unique_ptr<uint32_t[]>     mBuckets;
+        std::unique_ptr<listElement[]>  mListElements;
     };
 
-    template <typename IndexType>
+    template <typename IndexType, class Policy, uint32_t CacheSize>
     HRESULT OptimizeFacesImpl(
         _In_reads_(indexCount) const IndexType* indexList, uint32_t indexCount,
-        _Out_writes_(indexCount / 3) uint32_t* faceRemap, uint32_t lruCacheSize, uint32_t offset)
+        _Out_writes_(indexCount / 3) uint32_t* faceRemap, uint32_t lruCacheSize, VCACHE_MODEL model, uint32_t offset)
     {
+        assert(!CacheSize || CacheSize == lruCacheSize);
+
+        // For specialized instances this is a compile-time constant
+        const uint32_t vertexCacheSize = CacheSize ? CacheSize : lruCacheSize;
+
         std::unique_ptr<OptimizeVertexData<IndexType>[]> vertexDataList(new (std::nothrow) OptimizeVertexData<IndexType>[indexCount]);
         if (!vertexDataList)
             return E_OUTOFMEMORY;
@@ -202,14 +399,6 @@ namespace
 
         const uint32_t faceCount = indexCount / 3;
 
-        std::unique_ptr<uint8_t[]> processedFaceList(new (std::nothrow) uint8_t[faceCount]);
-        std::unique_ptr<uint32_t[]> faceSorted(new (std::nothrow) uint32_t[faceCount]);
-        std::unique_ptr<uint32_t[]> faceReverseLookup(new (std::nothrow) uint32_t[faceCount]);
-        if (!processedFaceList || !faceSorted || !faceReverseLookup)
-            return E_OUTOFMEMORY;
-
-        memset(processedFaceList.get(), 0, sizeof(uint8_t) * faceCount);
-
         // build the vertex remap table
         uint32_t uniqueVertexCount = 0;
         uint32_t unused = 0;
@@ -274,7 +463,7 @@ namespace
                 vertexData.cachePos1 = kEvictedCacheIndex;
                 vertexData.activeFaceListStart = curActiveFaceListPos;
                 curActiveFaceListPos += vertexData.activeFaceListSize;
-                vertexData.score = FindVertexScore(vertexData.activeFaceListSize, vertexData.cachePos0, lruCacheSize);
+                vertexData.score = FindVertexScore<Policy, CacheSize>(vertexData.activeFaceListSize, vertexData.cachePos0, vertexCacheSize);
 
                 vertexData.activeFaceListSize = 0;
             }
@@ -282,20 +471,6 @@ namespace
             assert(curActiveFaceListPos == (indexCount - unused));
         }
 
-        // sort unprocessed faces by highest score
-        for (uint32_t f = 0; f < faceCount; f++)
-        {
-            faceSorted[f] = f;
-        }
-
-        FaceValenceSort<uint32_t, IndexType> faceValenceSort(vertexDataList.get());
-        std::sort(faceSorted.get(), faceSorted.get() + faceCount, faceValenceSort);
-
-        for (uint32_t f = 0; f < faceCount; f++)
-        {
-            faceReverseLookup[faceSorted[f]] = f;
-        }
-
         // fill out face list per vertex
         for (uint32_t i = 0; i < indexCount; i += 3)
         {
@@ -311,6 +486,36 @@ namespace
             }
         }
 
+        // queue unprocessed faces by lowest total valence, used as restart points when the cache runs dry
+        face_queue faceQueue;
+        {
+            uint32_t maxKey = 0;
+            for (uint32_t i = 0; i < uniqueVertexCount; ++i)
+            {
+                maxKey = std::max<uint32_t>(maxKey, vertexDataList[i].activeFaceListSize);
+            }
+
+            HRESULT hr = faceQueue.initialize(faceCount, maxKey * 3);
+            if (FAILED(hr))
+                return hr;
+
+            for (uint32_t f = faceCount; f > 0; --f)
+            {
+                uint32_t face = (f - 1) * 3;
+                uint32_t i0 = vertexRemap[face];
+                uint32_t i1 = vertexRemap[size_t(face) + 1];
+                uint32_t i2 = vertexRemap[size_t(face) + 2];
+                if (i0 == UNUSED32 || i1 == UNUSED32 || i2 == UNUSED32)
+                    continue;
+
+                // inserted in reverse so that initial ties resolve to the lowest face index
+                faceQueue.insert(f - 1,
+                    vertexDataList[i0].activeFaceListSize
+                    + vertexDataList[i1].activeFaceListSize
+                    + vertexDataList[i2].activeFaceListSize);
+            }
+        }
+
         uint32_t vertexCacheBuffer[(kMaxVertexCacheSize + 3) * 2] = {};
         uint32_t *cache0 = vertexCacheBuffer;
         uint32_t *cache1 = vertexCacheBuffer + (kMaxVertexCacheSize + 3);
@@ -332,8 +537,6 @@ namespace
 
         float bestScore = -1.f;
 
-        uint32_t nextBestFace = 0;
-
         uint32_t curFace = 0;
         for (size_t i = 0; i < indexCount; i += 3)
         {
@@ -347,37 +550,54 @@ namespace
             if (bestScore < 0.f)
             {
                 // no verts in the cache are used by any unprocessed faces so
-                // search all unprocessed faces for a new starting point
-                while (nextBestFace < faceCount)
+                // restart from the unprocessed face with the lowest total valence
+                uint32_t faceIndex = faceQueue.find_min();
+                if (faceIndex != UNUSED32)
                 {
-                    uint32_t faceIndex = faceSorted[nextBestFace++];
-                    if (processedFaceList[faceIndex] == 0)
-                    {
-                        uint32_t face = faceIndex * 3;
-                        uint32_t i0 = vertexRemap[face];
-                        uint32_t i1 = vertexRemap[size_t(face) + 1];
-                        uint32_t i2 = vertexRemap[size_t(face) + 2];
-                        if (i0 != UNUSED32 && i1 != UNUSED32 && i2 != UNUSED32)
-                        {
-                            // we're searching a pre-sorted list, first one we find will be the best
-                            bestFace = face;
-                            bestScore = vertexDataList[i0].score
-                                + vertexDataList[i1].score
-                                + vertexDataList[i2].score;
-                            break;
-                        }
-                    }
+                    uint32_t face = faceIndex * 3;
+                    bestFace = face;
+                    bestScore = vertexDataList[vertexRemap[face]].score
+                        + vertexDataList[vertexRemap[size_t(face) + 1]].score
+                        + vertexDataList[vertexRemap[size_t(face) + 2]].score;
                 }
                 assert(bestScore >= 0.f);
             }
 
-            processedFaceList[bestFace / 3] = 1;
+            faceQueue.remove(bestFace / 3);
             uint16_t entriesInCache1 = 0;
 
+            if (model == VCACHE_MODEL_BATCH)
+            {
+                // start a new batch if the face's new vertices don't fit in the current one
+                uint32_t newVerts = 0;
+                for (size_t v = 0; v < 3; ++v)
+                {
+                    uint32_t vert = vertexRemap[bestFace + v];
+                    if (vertexDataList[vert].cachePos0 >= entriesInCache0
+                        && (!v || vert != vertexRemap[bestFace + v - 1])
+                        && (v < 2 || vert != vertexRemap[bestFace]))
+                    {
+                        ++newVerts;
+                    }
+                }
+
+                if (entriesInCache0 + newVerts > vertexCacheSize)
+                {
+                    for (uint32_t c0 = 0; c0 < entriesInCache0; ++c0)
+                    {
+                        OptimizeVertexData<IndexType>& vertexData = vertexDataList[cache0[c0]];
+                        vertexData.cachePos0 = kEvictedCacheIndex;
+                        vertexData.score = FindVertexScore<Policy, CacheSize>(vertexData.activeFaceListSize, kEvictedCacheIndex, vertexCacheSize);
+                    }
+
+                    entriesInCache0 = 0;
+                }
+            }
+
             faceRemap[curFace] = (bestFace / 3) + offset;
             curFace++;
 
-            // add bestFace to LRU cache
+            // add bestFace to the cache (for the FIFO model, hits keep their current position)
             assert(vertexRemap[bestFace] != UNUSED32);
             assert(vertexRemap[size_t(bestFace) + 1] != UNUSED32);
             assert(vertexRemap[size_t(bestFace) + 2] != UNUSED32);
@@ -386,7 +606,8 @@ namespace
             {
                 OptimizeVertexData<IndexType>& vertexData = vertexDataList[vertexRemap[bestFace + v]];
 
-                if (vertexData.cachePos1 >= entriesInCache1)
+                if (vertexData.cachePos1 >= entriesInCache1
+                    && (model != VCACHE_MODEL_FIFO || vertexData.cachePos0 >= entriesInCache0))
                 {
                     vertexData.cachePos1 = entriesInCache1;
                     cache1[entriesInCache1++] = vertexRemap[bestFace + v];
@@ -408,30 +629,12 @@ namespace
                 std::swap(*it, *(end - 1));
 
                 --vertexData.activeFaceListSize;
-                vertexData.score = FindVertexScore(vertexData.activeFaceListSize, vertexData.cachePos1, lruCacheSize);
+                vertexData.score = FindVertexScore<Policy, CacheSize>(vertexData.activeFaceListSize, vertexData.cachePos1, vertexCacheSize);
 
-                // need to re-sort the faces that use this vertex, as their score will change due to activeFaceListSize shrinking
+                // the remaining faces that use this vertex lose one unit of valence
                 for (const uint32_t *fi = begin; fi != end - 1; ++fi)
                 {
-                    uint32_t faceIndex = *fi / 3;
-                    uint32_t n = faceReverseLookup[faceIndex];
-                    assert(faceSorted[n] == faceIndex);
-
-                    // found it, now move it up
-                    while (n > 0)
-                    {
-                        if (faceValenceSort(n, n - 1))
-                        {
-                            faceReverseLookup[faceSorted[n]] = n - 1;
-                            faceReverseLookup[faceSorted[n - 1]] = n;
-                            std::swap(faceSorted[n], faceSorted[n - 1]);
-                            n--;
-                        }
-                        else
-                        {
-                            break;
-                        }
-                    }
+                    faceQueue.decrement(*fi / 3);
                 }
             }
 
@@ -444,7 +647,7 @@ namespace
                 {
                     vertexData.cachePos1 = entriesInCache1;
                     cache1[entriesInCache1++] = cache0[c0];
-                    vertexData.score = FindVertexScore(vertexData.activeFaceListSize, vertexData.cachePos1, lruCacheSize);
+                    vertexData.score = FindVertexScore<Policy, CacheSize>(vertexData.activeFaceListSize, vertexData.cachePos1, vertexCacheSize);
 
                     // don't need to re-sort this vertex... once it gets out of the cache, it'll have its original score
                 }
@@ -480,7 +683,7 @@ namespace
 
             std::swap(cache0, cache1);
 
-            entriesInCache0 = std::min<uint32_t>(entriesInCache1, lruCacheSize);
+            entriesInCache0 = std::min<uint32_t>(entriesInCache1, vertexCacheSize);
         }
 
         for (; curFace < faceCount; ++curFace)
@@ -490,6 +693,29 @@ namespace
 
         return S_OK;
     }
+
+    //---------------------------------------------------------------------------------
+    // Uses a specialized instance for common cache sizes
+    template <typename IndexType, class Policy = ForsythScoringPolicy>
+    HRESULT OptimizeFacesForCache(
+        _In_reads_(indexCount) const IndexType* indexList, uint32_t indexCount,
+        _Out_writes_(indexCount / 3) uint32_t* faceRemap, uint32_t lruCacheSize, VCACHE_MODEL model, uint32_t offset)
+    {
+        switch (lruCacheSize)
+        {
+        case 16:
+            return OptimizeFacesImpl<IndexType, Policy, 16>(indexList, indexCount, faceRemap, lruCacheSize, model, offset);
+
+        case OPTFACES_LRU_DEFAULT:
+            return OptimizeFacesImpl<IndexType, Policy, OPTFACES_LRU_DEFAULT>(indexList, indexCount, faceRemap, lruCacheSize, model, offset);
+
+        case kMaxVertexCacheSize:
+            return OptimizeFacesImpl<IndexType, Policy, kMaxVertexCacheSize>(indexList, indexCount, faceRemap, lruCacheSize, model, offset);
+
+        default:
+            return OptimizeFacesImpl<IndexType, Policy, 0>(indexList, indexCount, faceRemap, lruCacheSize, model, offset);
+        }
+    }
 }
 
 //=====================================================================================
@@ -499,7 +725,7 @@ namespace
 _Use_decl_annotations_
 HRESULT DirectX::OptimizeFacesLRU(
     const uint16_t* indices, size_t nFaces,
-    uint32_t* faceRemap, uint32_t lruCacheSize)
+    uint32_t* faceRemap, uint32_t lruCacheSize, VCACHE_MODEL model)
 {
     if (!indices || !nFaces || !faceRemap)
         return E_INVALIDARG;
@@ -507,18 +733,19 @@ HRESULT DirectX::OptimizeFacesLRU(
     if (!lruCacheSize || lruCacheSize > kMaxVertexCacheSize)
         return E_INVALIDARG;
 
+    if (unsigned(model) > VCACHE_MODEL_BATCH)
+        return E_INVALIDARG;
+
     if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
         return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
 
-    InitOnceExecuteOnce(&s_initOnce, ComputeVertexScores, nullptr, nullptr);
-
-    return OptimizeFacesImpl<uint16_t>(indices, static_cast<uint32_t>(nFaces * 3), faceRemap, lruCacheSize, 0);
+    return OptimizeFacesForCache<uint16_t>(indices, static_cast<uint32_t>(nFaces * 3), faceRemap, lruCacheSize, model, 0);
 }
 
 _Use_decl_annotations_
 HRESULT DirectX::OptimizeFacesLRU(
     const uint32_t* indices, size_t nFaces,
-    uint32_t* faceRemap, uint32_t lruCacheSize)
+    uint32_t* faceRemap, uint32_t lruCacheSize, VCACHE_MODEL model)
 {
     if (!indices || !nFaces || !faceRemap)
         return E_INVALIDARG;
@@ -526,12 +753,13 @@ HRESULT DirectX::OptimizeFacesLRU(
     if (!lruCacheSize || lruCacheSize > kMaxVertexCacheSize)
         return E_INVALIDARG;
 
+    if (unsigned(model) > VCACHE_MODEL_BATCH)
+        return E_INVALIDARG;
+
     if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
         return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
 
-    InitOnceExecuteOnce(&s_initOnce, ComputeVertexScores, nullptr, nullptr);
-
-    return OptimizeFacesImpl<uint32_t>(indices, static_cast<uint32_t>(nFaces * 3), faceRemap, lruCacheSize, 0);
+    return OptimizeFacesForCache<uint32_t>(indices, static_cast<uint32_t>(nFaces * 3), faceRemap, lruCacheSize, model, 0);
 }
 
 
@@ -539,7 +767,7 @@ HRESULT DirectX::OptimizeFacesLRU(
 _Use_decl_annotations_
 HRESULT DirectX::OptimizeFacesLRUEx(
     const uint16_t* indices, size_t nFaces, const uint32_t* attributes,
-    uint32_t* faceRemap, uint32_t lruCacheSize)
+    uint32_t* faceRemap, uint32_t lruCacheSize, VCACHE_MODEL model)
 {
     if (!indices || !nFaces || !attributes || !faceRemap)
         return E_INVALIDARG;
@@ -547,11 +775,12 @@ HRESULT DirectX::OptimizeFacesLRUEx(
     if (!lruCacheSize || lruCacheSize > kMaxVertexCacheSize)
         return E_INVALIDARG;
 
+    if (unsigned(model) > VCACHE_MODEL_BATCH)
+        return E_INVALIDARG;
+
     if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
         return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
 
-    InitOnceExecuteOnce(&s_initOnce, ComputeVertexScores, nullptr, nullptr);
-
     auto subsets = ComputeSubsets(attributes, nFaces);
 
     if (subsets.empty())
@@ -572,9 +801,9 @@ HRESULT DirectX::OptimizeFacesLRUEx(
         if (faceMax > nFaces)
             return E_UNEXPECTED;
 
-        HRESULT hr = OptimizeFacesImpl<uint16_t>(
+        HRESULT hr = OptimizeFacesForCache<uint16_t>(
             &indices[it->first * 3], static_cast<uint32_t>(it->second * 3),
-            &faceRemap[it->first], lruCacheSize, uint32_t(it->first));
+            &faceRemap[it->first], lruCacheSize, model, uint32_t(it->first));
         if (FAILED(hr))
             return hr;
     }
@@ -585,7 +814,7 @@ HRESULT DirectX::OptimizeFacesLRUEx(
 _Use_decl_annotations_
 HRESULT DirectX::OptimizeFacesLRUEx(
     const uint32_t* indices, size_t nFaces, const uint32_t* attributes,
-    uint32_t* faceRemap, uint32_t lruCacheSize)
+    uint32_t* faceRemap, uint32_t lruCacheSize, VCACHE_MODEL model)
 {
     if (!indices || !nFaces || !attributes || !faceRemap)
         return E_INVALIDARG;
@@ -593,11 +822,12 @@ HRESULT DirectX::OptimizeFacesLRUEx(
     if (!lruCacheSize || lruCacheSize > kMaxVertexCacheSize)
         return E_INVALIDARG;
 
+    if (unsigned(model) > VCACHE_MODEL_BATCH)
+        return E_INVALIDARG;
+
     if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
         return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
 
-    InitOnceExecuteOnce(&s_initOnce, ComputeVertexScores, nullptr, nullptr);
-
     auto subsets = ComputeSubsets(attributes, nFaces);
 
     if (subsets.empty())
@@ -618,9 +848,9 @@ HRESULT DirectX::OptimizeFacesLRUEx(
         if (faceMax > nFaces)
             return E_UNEXPECTED;
 
-        HRESULT hr = OptimizeFacesImpl<uint32_t>(
+        HRESULT hr = OptimizeFacesForCache<uint32_t>(
             &indices[it->first * 3], static_cast<uint32_t>(it->second * 3),
-            &faceRemap[it->first], lruCacheSize, uint32_t(it->first));
+            &faceRemap[it->first], lruCacheSize, model, uint32_t(it->first));
         if (FAILED(hr))
             return hr;
     }
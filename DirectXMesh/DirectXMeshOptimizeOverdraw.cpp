@@ -0,0 +1,412 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshOptimizeOverdraw.cpp
+//
+// DirectX Mesh Geometry Library - Mesh optimization
+//
+// Sander, Nehab, and Barczak, "Fast Triangle Reordering for Vertex Locality and
+// Reduced Overdraw", ACM SIGGRAPH 2007
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+namespace
+{
+    //---------------------------------------------------------------------------------
+    // Returns the misses of the faces from a cold cache, counted as ComputeVertexCacheMissRate
+    // does. Clearing the cache is constant time, so one cache serves every cluster and subset.
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    uint32_t ColdCacheMisses(vcache_sim& vcache, _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces)
+    {
+        vcache.clear();
+
+        uint32_t misses = 0;
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            misses += vcache.access(indices[face * 3], indices[face * 3 + 1], indices[face * 3 + 2]);
+        }
+
+        return misses;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    // Orders the clusters of [indices, nFaces) by decreasing occlusion potential,
+    // which is how far the cluster sits from the mesh centroid along its own normal
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    void SortClusters(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        _In_ const XMFLOAT3* positions,
+        const std::vector<uint32_t>& clusters,
+        _Out_writes_(nFaces) uint32_t* faceRemap)
+    {
+        const size_t nClusters = clusters.size();
+
+        std::vector<XMFLOAT4> centroids(nClusters);
+        std::vector<XMFLOAT3> normals(nClusters);
+
+        XMVECTOR meshCentroid = XMVectorZero();
+        float meshArea = 0.f;
+
+        for (size_t c = 0; c < nClusters; ++c)
+        {
+            size_t begin = clusters[c];
+            size_t end = (c + 1 < nClusters) ? clusters[c + 1] : nFaces;
+
+            XMVECTOR centroid = XMVectorZero();
+            XMVECTOR normal = XMVectorZero();
+            float area = 0.f;
+
+            for (size_t face = begin; face < end; ++face)
+            {
+                XMVECTOR p0 = XMLoadFloat3(&positions[indices[face * 3]]);
+                XMVECTOR p1 = XMLoadFloat3(&positions[indices[face * 3 + 1]]);
+                XMVECTOR p2 = XMLoadFloat3(&positions[indices[face * 3 + 2]]);
+
+                // area-weighted face normal
+                XMVECTOR n = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+                float faceArea = XMVectorGetX(XMVector3Length(n)) * 0.5f;
+
+                XMVECTOR faceCentroid = XMVectorScale(XMVectorAdd(XMVectorAdd(p0, p1), p2), 1.f / 3.f);
+
+                centroid = XMVectorMultiplyAdd(faceCentroid, XMVectorReplicate(faceArea), centroid);
+                normal = XMVectorAdd(normal, n);
+                area += faceArea;
+            }
+
+            meshCentroid = XMVectorAdd(meshCentroid, centroid);
+            meshArea += area;
+
+            if (area > 0.f)
+            {
+                centroid = XMVectorScale(centroid, 1.f / area);
+            }
+
+            XMStoreFloat4(&centroids[c], centroid);
+            XMStoreFloat3(&normals[c], XMVector3Normalize(normal));
+        }
+
+        if (meshArea > 0.f)
+        {
+            meshCentroid = XMVectorScale(meshCentroid, 1.f / meshArea);
+        }
+
+        std::vector<std::pair<float, uint32_t>> order;
+        order.reserve(nClusters);
+
+        for (size_t c = 0; c < nClusters; ++c)
+        {
+            XMVECTOR v = XMVectorSubtract(XMLoadFloat4(&centroids[c]), meshCentroid);
+            float potential = XMVectorGetX(XMVector3Dot(v, XMLoadFloat3(&normals[c])));
+
+            order.emplace_back(potential, uint32_t(c));
+        }
+
+        std::stable_sort(order.begin(), order.end(),
+            [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b)
+        {
+            return a.first > b.first;
+        });
+
+        size_t curFace = 0;
+        for (auto it = order.cbegin(); it != order.cend(); ++it)
+        {
+            size_t c = it->second;
+            size_t begin = clusters[c];
+            size_t end = (c + 1 < nClusters) ? clusters[c + 1] : nFaces;
+
+            for (size_t face = begin; face < end; ++face)
+            {
+                faceRemap[curFace++] = uint32_t(face);
+            }
+        }
+
+        assert(curFace == nFaces);
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT OptimizeOverdrawImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, size_t nVerts,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        float threshold, vcache_sim& vcache, uint32_t offset)
+    {
+        // Faces using unused indices are moved to the end
+        std::vector<index_t> ib;
+        std::vector<uint32_t> validFaces;
+        ib.reserve(nFaces * 3);
+        validFaces.reserve(nFaces);
+
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            index_t i0 = indices[face * 3];
+            index_t i1 = indices[face * 3 + 1];
+            index_t i2 = indices[face * 3 + 2];
+
+            if (i0 == index_t(-1)
+                || i1 == index_t(-1)
+                || i2 == index_t(-1))
+                continue;
+
+            if (i0 >= nVerts
+                || i1 >= nVerts
+                || i2 >= nVerts)
+                return E_UNEXPECTED;
+
+            ib.push_back(i0);
+            ib.push_back(i1);
+            ib.push_back(i2);
+            validFaces.push_back(uint32_t(face));
+        }
+
+        const size_t nValid = validFaces.size();
+
+        if (!nValid)
+        {
+            memset(faceRemap, 0xff, sizeof(uint32_t) * nFaces);
+            return S_OK;
+        }
+
+        // Hard boundaries are where the existing order misses on every vertex of a face,
+        // so the clusters can be reordered without changing the cache behavior much
+        std::vector<uint32_t> hardClusters;
+        hardClusters.push_back(0);
+
+        vcache.clear();
+
+        uint32_t missesIn = 0;
+        for (size_t face = 0; face < nValid; ++face)
+        {
+            uint32_t misses = vcache.access(ib[face * 3], ib[face * 3 + 1], ib[face * 3 + 2]);
+
+            if (misses == 3 && face > 0)
+            {
+                hardClusters.push_back(uint32_t(face));
+            }
+
+            missesIn += misses;
+        }
+
+        const float acmrIn = float(missesIn) / float(nValid);
+
+        // Soft boundaries split each hard cluster as soon as the ACMR of the piece from a
+        // cold cache is within threshold of the ACMR of the whole cluster
+        std::vector<uint32_t> softClusters;
+        softClusters.reserve(hardClusters.size());
+
+        for (size_t c = 0; c < hardClusters.size(); ++c)
+        {
+            size_t begin = hardClusters[c];
+            size_t end = (c + 1 < hardClusters.size()) ? hardClusters[c + 1] : nValid;
+
+            const float acmrCluster = float(ColdCacheMisses(vcache, &ib[begin * 3], end - begin)) / float(end - begin);
+
+            const float limit = acmrCluster * threshold;
+
+            vcache.clear();
+            softClusters.push_back(uint32_t(begin));
+
+            size_t start = begin;
+            uint32_t misses = 0;
+            for (size_t face = begin; face < end; ++face)
+            {
+                misses += vcache.access(ib[face * 3], ib[face * 3 + 1], ib[face * 3 + 2]);
+
+                if ((face + 1) < end && float(misses) <= limit * float(face + 1 - start))
+                {
+                    start = face + 1;
+                    misses = 0;
+                    vcache.clear();
+                    softClusters.push_back(uint32_t(start));
+                }
+            }
+        }
+
+        std::unique_ptr<uint32_t[]> remap(new (std::nothrow) uint32_t[nValid]);
+        std::unique_ptr<index_t[]> newIndices(new (std::nothrow) index_t[nValid * 3]);
+        if (!remap || !newIndices)
+            return E_OUTOFMEMORY;
+
+        // Use the finest clustering whose ACMR stays within threshold of the input order
+        bool accepted = false;
+        for (const std::vector<uint32_t>* clusters : { &softClusters, &hardClusters })
+        {
+            if (clusters == &hardClusters && softClusters.size() == hardClusters.size())
+                break;
+
+            SortClusters(ib.data(), nValid, positions, *clusters, remap.get());
+
+            HRESULT hr = ReorderIB(ib.data(), nValid, remap.get(), newIndices.get());
+            if (FAILED(hr))
+                return hr;
+
+            const float acmrOut = float(ColdCacheMisses(vcache, newIndices.get(), nValid)) / float(nValid);
+
+            if (acmrOut <= acmrIn * threshold)
+            {
+                accepted = true;
+                break;
+            }
+        }
+
+        if (!accepted)
+        {
+            // keep the input order
+            for (size_t face = 0; face < nValid; ++face)
+            {
+                remap[face] = uint32_t(face);
+            }
+        }
+
+        for (size_t face = 0; face < nValid; ++face)
+        {
+            faceRemap[face] = validFaces[remap[face]] + offset;
+        }
+
+        for (size_t face = nValid; face < nFaces; ++face)
+        {
+            faceRemap[face] = UNUSED32;
+        }
+
+        return S_OK;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT OptimizeFacesOverdrawImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, size_t nVerts,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        float threshold, uint32_t vertexCache)
+    {
+        if (!indices || !nFaces || !positions || !nVerts || !faceRemap || !vertexCache)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        if (!(threshold >= 1.f))
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        vcache_sim vcache;
+        HRESULT hr = vcache.initialize(nVerts, nFaces * 3, vertexCache, VCACHE_MODEL_FIFO);
+        if (FAILED(hr))
+            return hr;
+
+        return OptimizeOverdrawImpl<index_t>(indices, nFaces, positions, nVerts, faceRemap, threshold, vcache, 0);
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT OptimizeFacesOverdrawExImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, size_t nVerts,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap,
+        float threshold, uint32_t vertexCache)
+    {
+        if (!indices || !nFaces || !positions || !nVerts || !attributes || !faceRemap || !vertexCache)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        if (!(threshold >= 1.f))
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        auto subsets = ComputeSubsets(attributes, nFaces);
+
+        if (subsets.empty())
+            return E_UNEXPECTED;
+
+        memset(faceRemap, 0, sizeof(uint32_t) * nFaces);
+
+        // The cache state is shared by all subsets
+        vcache_sim vcache;
+        HRESULT hr = vcache.initialize(nVerts, nFaces * 3, vertexCache, VCACHE_MODEL_FIFO);
+        if (FAILED(hr))
+            return hr;
+
+        for (auto it = subsets.cbegin(); it != subsets.cend(); ++it)
+        {
+            if (it->first >= nFaces)
+                return E_UNEXPECTED;
+
+            if ((uint64_t(it->first) + uint64_t(it->second)) >= UINT32_MAX)
+                return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+            uint32_t faceMax = uint32_t(it->first + it->second);
+
+            if (faceMax > nFaces)
+                return E_UNEXPECTED;
+
+            hr = OptimizeOverdrawImpl<index_t>(
+                &indices[it->first * 3], it->second, positions, nVerts,
+                &faceRemap[it->first], threshold, vcache, uint32_t(it->first));
+            if (FAILED(hr))
+                return hr;
+        }
+
+        return S_OK;
+    }
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesOverdraw(
+    const uint16_t* indices, size_t nFaces,
+    const XMFLOAT3* positions, size_t nVerts,
+    uint32_t* faceRemap, float threshold, uint32_t vertexCache)
+{
+    return OptimizeFacesOverdrawImpl<uint16_t>(indices, nFaces, positions, nVerts, faceRemap, threshold, vertexCache);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesOverdraw(
+    const uint32_t* indices, size_t nFaces,
+    const XMFLOAT3* positions, size_t nVerts,
+    uint32_t* faceRemap, float threshold, uint32_t vertexCache)
+{
+    return OptimizeFacesOverdrawImpl<uint32_t>(indices, nFaces, positions, nVerts, faceRemap, threshold, vertexCache);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesOverdrawEx(
+    const uint16_t* indices, size_t nFaces,
+    const XMFLOAT3* positions, size_t nVerts, const uint32_t* attributes,
+    uint32_t* faceRemap, float threshold, uint32_t vertexCache)
+{
+    return OptimizeFacesOverdrawExImpl<uint16_t>(indices, nFaces, positions, nVerts, attributes, faceRemap, threshold, vertexCache);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesOverdrawEx(
+    const uint32_t* indices, size_t nFaces,
+    const XMFLOAT3* positions, size_t nVerts, const uint32_t* attributes,
+    uint32_t* faceRemap, float threshold, uint32_t vertexCache)
+{
+    return OptimizeFacesOverdrawExImpl<uint32_t>(indices, nFaces, positions, nVerts, attributes, faceRemap, threshold, vertexCache);
+}
@@ -449,63 +449,6 @@ namespace
     }
 
 
-    //---------------------------------------------------------------------------------
-    class sim_vcache
-    {
-    public:
-        sim_vcache() noexcept : mTail(0), mCacheSize(0) {}
-
-        HRESULT initialize(uint32_t cacheSize)
-        {
-            if (!cacheSize)
-                return E_INVALIDARG;
-
-            mFIFO.reset(new (std::nothrow) uint32_t[cacheSize]);
-            if (!mFIFO)
-                return E_OUTOFMEMORY;
-
-            mCacheSize = cacheSize;
-
-            clear();
-
-            return S_OK;
-        }
-
-        void clear()
-        {
-            assert(mFIFO != nullptr);
-            mTail = 0;
-            memset(mFIFO.get(), 0xff, sizeof(uint32_t) * mCacheSize);
-        }
-
-        bool access(uint32_t vertex)
-        {
-            assert(vertex != UNUSED32);
-            assert(mFIFO != nullptr);
-
-            for (size_t ptr = 0; ptr < mCacheSize; ++ptr)
-            {
-                if (mFIFO[ptr] == vertex)
-                {
-                    return true;
-                }
-            }
-
-            mFIFO[mTail] = vertex;
-            mTail += 1;
-            if (mTail == mCacheSize)
-                mTail = 0;
-
-            return false;
-        }
-
-    private:
-        uint32_t                    mTail;
-        uint32_t                    mCacheSize;
-        std::unique_ptr<uint32_t[]> mFIFO;
-    };
-
-
     //---------------------------------------------------------------------------------
     template<class index_t>
     HRESULT StripReorderImpl(
@@ -590,7 +533,7 @@ namespace
         _In_reads_(nFaces * 3) const uint32_t* adjacency,
         _In_reads_opt_(nFaces) const uint32_t* attributes,
         _Out_writes_(nFaces) uint32_t* faceRemap,
-        uint32_t vertexCache, uint32_t restart)
+        uint32_t vertexCache, uint32_t restart, VCACHE_MODEL model)
     {
         auto subsets = ComputeSubsets(attributes, nFaces);
 
@@ -601,8 +544,16 @@ namespace
         if (FAILED(hr))
             return hr;
 
-        sim_vcache vcache;
-        hr = vcache.initialize(vertexCache);
+        uint32_t maxIndex = 0;
+        for (size_t j = 0; j < (nFaces * 3); ++j)
+        {
+            index_t v = indices[j];
+            if (v != index_t(-1) && v > maxIndex)
+                maxIndex = v;
+        }
+
+        vcache_sim vcache;
+        hr = vcache.initialize(size_t(maxIndex) + 1, nFaces * 3, vertexCache, model);
         if (FAILED(hr))
             return hr;
 
@@ -695,16 +646,11 @@ namespace
                         curface += 1;
 
                         assert(indices[curCorner.first * 3] != index_t(-1));
-                        if (!vcache.access(indices[curCorner.first * 3]))
-                            locnext += 1;
-
                         assert(indices[curCorner.first * 3 + 1] != index_t(-1));
-                        if (!vcache.access(indices[curCorner.first * 3 + 1]))
-                            locnext += 1;
-
                         assert(indices[curCorner.first * 3 + 2] != index_t(-1));
-                        if (!vcache.access(indices[curCorner.first * 3 + 2]))
-                            locnext += 1;
+                        locnext += vcache.access(indices[curCorner.first * 3],
+                            indices[curCorner.first * 3 + 1],
+                            indices[curCorner.first * 3 + 2]);
 
                         facecorner_t intCorner = counterclockwise_corner<index_t>(curCorner, status);
                         bool interiornei = (intCorner.first != UNUSED32) && !status.isprocessed(intCorner.first);
@@ -762,6 +708,131 @@ namespace
 
         return S_OK;
     }
+
+    //---------------------------------------------------------------------------------
+    // Returns the rotation of the face that starts with the directed edge v0->v1
+    template<class index_t>
+    inline uint32_t find_rotation(_In_reads_(3) const index_t* face, index_t v0, index_t v1)
+    {
+        for (uint32_t r = 0; r < 3; ++r)
+        {
+            if (face[r] == v0 && face[(r + 1) % 3] == v1)
+                return r;
+        }
+
+        return UNUSED32;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT GenerateStripsImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces,
+        _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_opt_(nFaces) const uint32_t* attributes,
+        std::vector<index_t>& stripIndices,
+        _Inout_opt_ std::vector<std::pair<size_t, size_t>>* stripSubsets)
+    {
+        auto subsets = ComputeSubsets(attributes, nFaces);
+
+        if (subsets.empty())
+            return E_UNEXPECTED;
+
+        std::unique_ptr<uint32_t[]> faceRemap(new (std::nothrow) uint32_t[nFaces]);
+        if (!faceRemap)
+            return E_OUTOFMEMORY;
+
+        HRESULT hr = StripReorderImpl<index_t>(indices, nFaces, adjacency, attributes, faceRemap.get());
+        if (FAILED(hr))
+            return hr;
+
+        stripIndices.clear();
+        stripIndices.reserve(nFaces * 3);
+
+        if (stripSubsets)
+        {
+            stripSubsets->clear();
+            stripSubsets->reserve(subsets.size());
+        }
+
+        for (auto it = subsets.cbegin(); it != subsets.cend(); ++it)
+        {
+            if ((it->first + it->second) > nFaces)
+                return E_UNEXPECTED;
+
+            const size_t subsetStart = stripIndices.size();
+            const size_t faceMax = it->first + it->second;
+
+            // number of triangles in the current strip, which sets the winding of the next one
+            size_t stripLength = 0;
+
+            for (size_t j = it->first; j < faceMax; ++j)
+            {
+                uint32_t f = faceRemap[j];
+                if (f == UNUSED32)
+                    continue;
+
+                if (f >= nFaces)
+                    return E_UNEXPECTED;
+
+                const index_t* face = &indices[size_t(f) * 3];
+
+                if (face[0] == index_t(-1)
+                    || face[1] == index_t(-1)
+                    || face[2] == index_t(-1))
+                    continue;
+
+                if (stripLength > 0)
+                {
+                    // odd triangles in a strip are drawn with their first two vertices swapped
+                    index_t a = stripIndices[stripIndices.size() - 2];
+                    index_t b = stripIndices[stripIndices.size() - 1];
+
+                    uint32_t r = (stripLength & 1) ? find_rotation(face, b, a) : find_rotation(face, a, b);
+                    if (r != UNUSED32)
+                    {
+                        stripIndices.push_back(face[(r + 2) % 3]);
+                        ++stripLength;
+                        continue;
+                    }
+
+                    stripIndices.push_back(index_t(-1));
+                }
+
+                // start a new strip, rotated so it ends on the edge shared with the next face
+                uint32_t rot = 0;
+                for (size_t k = j + 1; k < faceMax; ++k)
+                {
+                    uint32_t g = faceRemap[k];
+                    if (g >= nFaces)
+                        continue;
+
+                    const index_t* next = &indices[size_t(g) * 3];
+                    for (uint32_t r = 0; r < 3; ++r)
+                    {
+                        if (find_rotation(next, face[(r + 2) % 3], face[(r + 1) % 3]) != UNUSED32)
+                        {
+                            rot = r;
+                            break;
+                        }
+                    }
+                    break;
+                }
+
+                stripIndices.push_back(face[rot]);
+                stripIndices.push_back(face[(rot + 1) % 3]);
+                stripIndices.push_back(face[(rot + 2) % 3]);
+                stripLength = 1;
+            }
+
+            if (stripSubsets)
+            {
+                stripSubsets->emplace_back(subsetStart, stripIndices.size() - subsetStart);
+            }
+        }
+
+        return S_OK;
+    }
 }
 
 //=====================================================================================
@@ -771,7 +842,7 @@ namespace
 _Use_decl_annotations_
 HRESULT DirectX::OptimizeFaces(
     const uint16_t* indices, size_t nFaces, const uint32_t* adjacency,
-    uint32_t* faceRemap, uint32_t vertexCache, uint32_t restart)
+    uint32_t* faceRemap, uint32_t vertexCache, uint32_t restart, VCACHE_MODEL model)
 {
     if (!indices || !nFaces || !adjacency || !faceRemap)
         return E_INVALIDARG;
@@ -788,14 +859,14 @@ HRESULT DirectX::OptimizeFaces(
         if (restart > vertexCache)
             return E_INVALIDARG;
 
-        return VertexCacheStripReorderImpl<uint16_t>(indices, nFaces, adjacency, nullptr, faceRemap, vertexCache, restart);
+        return VertexCacheStripReorderImpl<uint16_t>(indices, nFaces, adjacency, nullptr, faceRemap, vertexCache, restart, model);
     }
 }
 
 _Use_decl_annotations_
 HRESULT DirectX::OptimizeFaces(
     const uint32_t* indices, size_t nFaces, const uint32_t* adjacency,
-    uint32_t* faceRemap, uint32_t vertexCache, uint32_t restart)
+    uint32_t* faceRemap, uint32_t vertexCache, uint32_t restart, VCACHE_MODEL model)
 {
     if (!indices || !nFaces || !adjacency || !faceRemap)
         return E_INVALIDARG;
@@ -812,7 +883,7 @@ HRESULT DirectX::OptimizeFaces(
         if (restart > vertexCache)
             return E_INVALIDARG;
 
-        return VertexCacheStripReorderImpl<uint32_t>(indices, nFaces, adjacency, nullptr, faceRemap, vertexCache, restart);
+        return VertexCacheStripReorderImpl<uint32_t>(indices, nFaces, adjacency, nullptr, faceRemap, vertexCache, restart, model);
     }
 }
 
@@ -821,7 +892,7 @@ HRESULT DirectX::OptimizeFaces(
 _Use_decl_annotations_
 HRESULT DirectX::OptimizeFacesEx(
     const uint16_t* indices, size_t nFaces, const uint32_t* adjacency, const uint32_t* attributes,
-    uint32_t* faceRemap, uint32_t vertexCache, uint32_t restart)
+    uint32_t* faceRemap, uint32_t vertexCache, uint32_t restart, VCACHE_MODEL model)
 {
     if (!indices || !nFaces || !adjacency || !attributes || !faceRemap)
         return E_INVALIDARG;
@@ -838,14 +909,14 @@ HRESULT DirectX::OptimizeFacesEx(
         if (restart > vertexCache)
             return E_INVALIDARG;
 
-        return VertexCacheStripReorderImpl<uint16_t>(indices, nFaces, adjacency, attributes, faceRemap, vertexCache, restart);
+        return VertexCacheStripReorderImpl<uint16_t>(indices, nFaces, adjacency, attributes, faceRemap, vertexCache, restart, model);
     }
 }
 
 _Use_decl_annotations_
 HRESULT DirectX::OptimizeFacesEx(
     const uint32_t* indices, size_t nFaces, const uint32_t* adjacency, const uint32_t* attributes,
-    uint32_t* faceRemap, uint32_t vertexCache, uint32_t restart)
+    uint32_t* faceRemap, uint32_t vertexCache, uint32_t restart, VCACHE_MODEL model)
 {
     if (!indices || !nFaces || !adjacency || !attributes || !faceRemap)
         return E_INVALIDARG;
@@ -862,6 +933,64 @@ HRESULT DirectX::OptimizeFacesEx(
         if (restart > vertexCache)
             return E_INVALIDARG;
 
-        return VertexCacheStripReorderImpl<uint32_t>(indices, nFaces, adjacency, attributes, faceRemap, vertexCache, restart);
+        return VertexCacheStripReorderImpl<uint32_t>(indices, nFaces, adjacency, attributes, faceRemap, vertexCache, restart, model);
     }
 }
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::GenerateStrips(
+    const uint16_t* indices, size_t nFaces, const uint32_t* adjacency,
+    std::vector<uint16_t>& stripIndices)
+{
+    if (!indices || !nFaces || !adjacency)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    return GenerateStripsImpl<uint16_t>(indices, nFaces, adjacency, nullptr, stripIndices, nullptr);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateStrips(
+    const uint32_t* indices, size_t nFaces, const uint32_t* adjacency,
+    std::vector<uint32_t>& stripIndices)
+{
+    if (!indices || !nFaces || !adjacency)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    return GenerateStripsImpl<uint32_t>(indices, nFaces, adjacency, nullptr, stripIndices, nullptr);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateStripsEx(
+    const uint16_t* indices, size_t nFaces, const uint32_t* adjacency, const uint32_t* attributes,
+    std::vector<uint16_t>& stripIndices, std::vector<std::pair<size_t, size_t>>& stripSubsets)
+{
+    if (!indices || !nFaces || !adjacency || !attributes)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    return GenerateStripsImpl<uint16_t>(indices, nFaces, adjacency, attributes, stripIndices, &stripSubsets);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateStripsEx(
+    const uint32_t* indices, size_t nFaces, const uint32_t* adjacency, const uint32_t* attributes,
+    std::vector<uint32_t>& stripIndices, std::vector<std::pair<size_t, size_t>>& stripSubsets)
+{
+    if (!indices || !nFaces || !adjacency || !attributes)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    return GenerateStripsImpl<uint32_t>(indices, nFaces, adjacency, attributes, stripIndices, &stripSubsets);
+}
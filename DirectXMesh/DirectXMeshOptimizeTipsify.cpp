@@ -0,0 +1,362 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshOptimizeTipsify.cpp
+//
+// DirectX Mesh Geometry Library - Mesh optimization
+//
+// Sander, Nehab, and Barczak, "Fast Triangle Reordering for Vertex Locality and
+// Reduced Overdraw", ACM SIGGRAPH 2007
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+namespace
+{
+    //---------------------------------------------------------------------------------
+    // Scratch state for Tipsify. Per-vertex arrays are sized for the whole mesh and
+    // restored as each attribute subset completes, so processing a subset only costs
+    // time proportional to the number of faces in that subset.
+    //---------------------------------------------------------------------------------
+    class tipsify
+    {
+    public:
+        tipsify() noexcept : mTime(0), mMaxFaces(0), mVertexCacheSize(0) {}
+
+        HRESULT initialize(size_t nFaces, size_t nVerts, uint32_t vertexCacheSize)
+        {
+            if (!nFaces || !nVerts || !vertexCacheSize)
+                return E_INVALIDARG;
+
+            mLive.reset(new (std::nothrow) uint32_t[nVerts]);
+            mCacheTime.reset(new (std::nothrow) uint32_t[nVerts]);
+            mAdjStart.reset(new (std::nothrow) uint32_t[nVerts]);
+            mAdjCount.reset(new (std::nothrow) uint32_t[nVerts]);
+            mAdjacency.reset(new (std::nothrow) uint32_t[nFaces * 3]);
+            mDeadEnd.reset(new (std::nothrow) uint32_t[nFaces * 3]);
+            mEmitted.reset(new (std::nothrow) bool[nFaces]);
+            if (!mLive || !mCacheTime || !mAdjStart || !mAdjCount || !mAdjacency || !mDeadEnd || !mEmitted)
+                return E_OUTOFMEMORY;
+
+            memset(mLive.get(), 0, sizeof(uint32_t) * nVerts);
+            memset(mCacheTime.get(), 0, sizeof(uint32_t) * nVerts);
+            memset(mAdjStart.get(), 0xff, sizeof(uint32_t) * nVerts);
+
+            mMaxFaces = nFaces;
+            mVertexCacheSize = vertexCacheSize;
+            mTime = vertexCacheSize + 1;
+
+            return S_OK;
+        }
+
+        template<class index_t>
+        HRESULT optimize(
+            _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+            _Out_writes_(nFaces) uint32_t* faceRemap, uint32_t offset)
+        {
+            if (nFaces > mMaxFaces)
+                return E_UNEXPECTED;
+
+            // vertex-triangle adjacency, ignoring faces with unused indices
+            size_t nValid = 0;
+            for (size_t face = 0; face < nFaces; ++face)
+            {
+                mEmitted[face] = true;
+
+                index_t i0 = indices[face * 3];
+                index_t i1 = indices[face * 3 + 1];
+                index_t i2 = indices[face * 3 + 2];
+
+                if ((i0 != index_t(-1) && i0 >= nVerts)
+                    || (i1 != index_t(-1) && i1 >= nVerts)
+                    || (i2 != index_t(-1) && i2 >= nVerts))
+                {
+                    reset(indices, face, nVerts);
+                    return E_UNEXPECTED;
+                }
+
+                if (i0 == index_t(-1)
+                    || i1 == index_t(-1)
+                    || i2 == index_t(-1))
+                    continue;
+
+                mEmitted[face] = false;
+                ++nValid;
+
+                ++mLive[i0];
+                ++mLive[i1];
+                ++mLive[i2];
+            }
+
+            uint32_t adjacencySize = 0;
+            for (size_t face = 0; face < nFaces; ++face)
+            {
+                if (mEmitted[face])
+                    continue;
+
+                for (size_t point = 0; point < 3; ++point)
+                {
+                    index_t v = indices[face * 3 + point];
+                    if (mAdjStart[v] == UNUSED32)
+                    {
+                        mAdjStart[v] = adjacencySize;
+                        mAdjCount[v] = 0;
+                        adjacencySize += mLive[v];
+                    }
+
+                    mAdjacency[size_t(mAdjStart[v]) + mAdjCount[v]] = uint32_t(face);
+                    ++mAdjCount[v];
+                }
+            }
+
+            // emit faces
+            size_t curFace = 0;
+            size_t deadEndSize = 0;
+            size_t cursor = 0;
+
+            uint32_t fanning = next_face_vertex(indices, nFaces, cursor);
+            while (fanning != UNUSED32)
+            {
+                uint32_t candidateBegin = uint32_t(deadEndSize);
+
+                const uint32_t* adjacency = mAdjacency.get() + mAdjStart[fanning];
+                for (uint32_t j = 0; j < mAdjCount[fanning]; ++j)
+                {
+                    uint32_t face = adjacency[j];
+                    if (mEmitted[face])
+                        continue;
+
+                    for (size_t point = 0; point < 3; ++point)
+                    {
+                        index_t v = indices[size_t(face) * 3 + point];
+
+                        mDeadEnd[deadEndSize++] = v;
+
+                        assert(mLive[v] > 0);
+                        --mLive[v];
+
+                        if ((mTime - mCacheTime[v]) > mVertexCacheSize)
+                        {
+                            mCacheTime[v] = mTime++;
+                        }
+                    }
+
+                    mEmitted[face] = true;
+                    faceRemap[curFace++] = face + offset;
+                }
+
+                // pick the candidate that will still be in the cache once all of its remaining faces are emitted
+                uint32_t best = UNUSED32;
+                uint32_t bestPriority = 0;
+                for (size_t j = candidateBegin; j < deadEndSize; ++j)
+                {
+                    uint32_t v = mDeadEnd[j];
+                    if (!mLive[v])
+                        continue;
+
+                    uint32_t priority = 0;
+                    if ((mTime - mCacheTime[v]) + 2 * mLive[v] <= mVertexCacheSize)
+                    {
+                        priority = mTime - mCacheTime[v];
+                    }
+
+                    if (best == UNUSED32 || priority > bestPriority)
+                    {
+                        best = v;
+                        bestPriority = priority;
+                    }
+                }
+
+                if (best == UNUSED32)
+                {
+                    // dead-end, so backtrack through recently used vertices
+                    while (deadEndSize > 0)
+                    {
+                        uint32_t v = mDeadEnd[--deadEndSize];
+                        if (mLive[v] > 0)
+                        {
+                            best = v;
+                            break;
+                        }
+                    }
+
+                    if (best == UNUSED32)
+                    {
+                        best = next_face_vertex(indices, nFaces, cursor);
+                    }
+                }
+
+                fanning = best;
+            }
+
+            assert(curFace == nValid);
+            (void)nValid;
+
+            for (; curFace < nFaces; ++curFace)
+            {
+                faceRemap[curFace] = UNUSED32;
+            }
+
+            reset(indices, nFaces, nVerts);
+
+            return S_OK;
+        }
+
+    private:
+        // returns a vertex of the next unprocessed face in input order
+        template<class index_t>
+        uint32_t next_face_vertex(_In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t& cursor) const
+        {
+            for (; cursor < nFaces; ++cursor)
+            {
+                if (!mEmitted[cursor])
+                    return indices[cursor * 3];
+            }
+
+            return UNUSED32;
+        }
+
+        // restore the per-vertex state touched by the first nFaces faces
+        template<class index_t>
+        void reset(_In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts)
+        {
+            for (size_t j = 0; j < (nFaces * 3); ++j)
+            {
+                index_t v = indices[j];
+                if (v == index_t(-1) || v >= nVerts)
+                    continue;
+
+                mLive[v] = 0;
+                mAdjStart[v] = UNUSED32;
+            }
+        }
+
+        uint32_t                    mTime;
+        size_t                      mMaxFaces;
+        uint32_t                    mVertexCacheSize;
+        std::unique_ptr<uint32_t[]> mLive;
+        std::unique_ptr<uint32_t[]> mCacheTime;
+        std::unique_ptr<uint32_t[]> mAdjStart;
+        std::unique_ptr<uint32_t[]> mAdjCount;
+        std::unique_ptr<uint32_t[]> mAdjacency;
+        std::unique_ptr<uint32_t[]> mDeadEnd;
+        std::unique_ptr<bool[]>     mEmitted;
+    };
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT OptimizeFacesTipsifyImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+        _Out_writes_(nFaces) uint32_t* faceRemap, uint32_t vertexCache)
+    {
+        if (!indices || !nFaces || !nVerts || !faceRemap || !vertexCache)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        tipsify opt;
+        HRESULT hr = opt.initialize(nFaces, nVerts, vertexCache);
+        if (FAILED(hr))
+            return hr;
+
+        return opt.optimize(indices, nFaces, nVerts, faceRemap, 0);
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT OptimizeFacesTipsifyExImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+        _In_reads_(nFaces) const uint32_t* attributes,
+        _Out_writes_(nFaces) uint32_t* faceRemap, uint32_t vertexCache)
+    {
+        if (!indices || !nFaces || !nVerts || !attributes || !faceRemap || !vertexCache)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        auto subsets = ComputeSubsets(attributes, nFaces);
+
+        if (subsets.empty())
+            return E_UNEXPECTED;
+
+        tipsify opt;
+        HRESULT hr = opt.initialize(nFaces, nVerts, vertexCache);
+        if (FAILED(hr))
+            return hr;
+
+        memset(faceRemap, 0, sizeof(uint32_t) * nFaces);
+
+        for (auto it = subsets.cbegin(); it != subsets.cend(); ++it)
+        {
+            if (it->first >= nFaces)
+                return E_UNEXPECTED;
+
+            if ((uint64_t(it->first) + uint64_t(it->second)) >= UINT32_MAX)
+                return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+            uint32_t faceMax = uint32_t(it->first + it->second);
+
+            if (faceMax > nFaces)
+                return E_UNEXPECTED;
+
+            hr = opt.optimize(&indices[it->first * 3], it->second, nVerts, &faceRemap[it->first], uint32_t(it->first));
+            if (FAILED(hr))
+                return hr;
+        }
+
+        return S_OK;
+    }
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesTipsify(
+    const uint16_t* indices, size_t nFaces, size_t nVerts,
+    uint32_t* faceRemap, uint32_t vertexCache)
+{
+    return OptimizeFacesTipsifyImpl<uint16_t>(indices, nFaces, nVerts, faceRemap, vertexCache);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesTipsify(
+    const uint32_t* indices, size_t nFaces, size_t nVerts,
+    uint32_t* faceRemap, uint32_t vertexCache)
+{
+    return OptimizeFacesTipsifyImpl<uint32_t>(indices, nFaces, nVerts, faceRemap, vertexCache);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesTipsifyEx(
+    const uint16_t* indices, size_t nFaces, size_t nVerts, const uint32_t* attributes,
+    uint32_t* faceRemap, uint32_t vertexCache)
+{
+    return OptimizeFacesTipsifyExImpl<uint16_t>(indices, nFaces, nVerts, attributes, faceRemap, vertexCache);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::OptimizeFacesTipsifyEx(
+    const uint32_t* indices, size_t nFaces, size_t nVerts, const uint32_t* attributes,
+    uint32_t* faceRemap, uint32_t vertexCache)
+{
+    return OptimizeFacesTipsifyExImpl<uint32_t>(indices, nFaces, nVerts, attributes, faceRemap, vertexCache);
+}
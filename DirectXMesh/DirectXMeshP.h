@@ -79,13 +79,22 @@
 #include <directxmath.h>
 #include <directxpackedvector.h>
 
+#ifdef _XM_SSE_INTRINSICS_
+#include <intrin.h>
+#endif
+
 #include <assert.h>
 #include <malloc.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
 #include <map>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "directxmesh.h"
 
@@ -342,4 +351,289 @@ namespace DirectX
         return edge;
     }
 
+
+    //---------------------------------------------------------------------------------
+    // AVX2 + F16C support for the batched vertex codecs, checked once on first use
+    //---------------------------------------------------------------------------------
+#ifdef _XM_SSE_INTRINSICS_
+    inline bool IsAVX2Supported() noexcept
+    {
+        static const bool s_supported = []() noexcept -> bool
+        {
+            int info[4] = {};
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+
+            // OSXSAVE, AVX and F16C
+            __cpuid(info, 1);
+            if ((info[2] & 0x38000000) != 0x38000000)
+                return false;
+
+            // OS saves the XMM and YMM registers
+            if ((_xgetbv(0) & 0x6) != 0x6)
+                return false;
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & 0x20) != 0;
+        }();
+
+        return s_supported;
+    }
+#endif
+
+
+    //---------------------------------------------------------------------------------
+    // Octahedral unit vector mapping for the VBFORMAT_OCTAHEDRAL_* formats
+    //
+    // The vector is projected onto the octahedron |x| + |y| + |z| = 1, and the lower
+    // half is folded over the diagonals so the whole sphere covers the [-1,1] square
+    //---------------------------------------------------------------------------------
+    inline XMVECTOR XM_CALLCONV OctahedralEncode(FXMVECTOR v)
+    {
+        XMFLOAT3 n;
+        XMStoreFloat3(&n, v);
+
+        float l1 = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+        if (l1 <= 0.f)
+            return XMVectorZero();
+
+        float x = n.x / l1;
+        float y = n.y / l1;
+
+        if (n.z < 0.f)
+        {
+            float fx = (1.f - fabsf(y)) * ((x >= 0.f) ? 1.f : -1.f);
+            float fy = (1.f - fabsf(x)) * ((y >= 0.f) ? 1.f : -1.f);
+            x = fx;
+            y = fy;
+        }
+
+        return XMVectorSet(x, y, 0.f, 0.f);
+    }
+
+    inline XMVECTOR XM_CALLCONV OctahedralDecode(FXMVECTOR e)
+    {
+        float x = XMVectorGetX(e);
+        float y = XMVectorGetY(e);
+        float z = 1.f - fabsf(x) - fabsf(y);
+
+        // Unfold the lower half
+        float t = std::max(-z, 0.f);
+        x += (x >= 0.f) ? -t : t;
+        y += (y >= 0.f) ? -t : t;
+
+        return XMVector3Normalize(XMVectorSet(x, y, z, 0.f));
+    }
+
+
+    //---------------------------------------------------------------------------------
+    // Post-transform vertex cache simulation for each VCACHE_MODEL
+    //
+    // FIFO: vertices record the miss count when inserted, and are hits while fewer
+    //       than cacheSize misses have happened since
+    // LRU:  the reuse distance (distinct vertices referenced since the previous use)
+    //       is counted with a Fenwick tree over access times
+    // BATCH: vertices record the batch they were shaded in, and a face that would
+    //       take the batch over cacheSize unique vertices starts a new batch
+    //---------------------------------------------------------------------------------
+    class vcache_sim
+    {
+    public:
+        vcache_sim() noexcept :
+            mModel(VCACHE_MODEL_FIFO),
+            mCacheSize(0),
+            mVerts(0),
+            mMaxAccesses(0),
+            mMisses(0),
+            mTime(0),
+            mClearTime(0),
+            mBatch(1),
+            mBatchSize(0) {}
+
+        HRESULT initialize(size_t nVerts, size_t maxAccesses, uint32_t cacheSize, VCACHE_MODEL model)
+        {
+            if (!nVerts || !cacheSize || nVerts >= UINT32_MAX || maxAccesses >= UINT32_MAX)
+                return E_INVALIDARG;
+
+            switch (model)
+            {
+            case VCACHE_MODEL_FIFO:
+            case VCACHE_MODEL_BATCH:
+                break;
+
+            case VCACHE_MODEL_LRU:
+                mTree.reset(new (std::nothrow) uint32_t[maxAccesses + 1]);
+                if (!mTree)
+                    return E_OUTOFMEMORY;
+
+                memset(mTree.get(), 0, sizeof(uint32_t) * (maxAccesses + 1));
+                break;
+
+            default:
+                return E_INVALIDARG;
+            }
+
+            mStamps.reset(new (std::nothrow) uint32_t[nVerts]);
+            if (!mStamps)
+                return E_OUTOFMEMORY;
+
+            memset(mStamps.get(), 0, sizeof(uint32_t) * nVerts);
+
+            mModel = model;
+            mCacheSize = cacheSize;
+            mVerts = nVerts;
+            mMaxAccesses = maxAccesses;
+            mMisses = 0;
+            mTime = mClearTime = 0;
+            mBatch = 1;
+            mBatchSize = 0;
+
+            return S_OK;
+        }
+
+        void clear()
+        {
+            switch (mModel)
+            {
+            case VCACHE_MODEL_FIFO:
+                if (mMisses >= (UINT32_MAX / 2))
+                {
+                    // restart the stamps well before the miss count could wrap
+                    memset(mStamps.get(), 0, sizeof(uint32_t) * mVerts);
+                    mMisses = 0;
+                    break;
+                }
+
+                // every current entry is now too old to be in the cache
+                mMisses += mCacheSize;
+                break;
+
+            case VCACHE_MODEL_LRU:
+                mClearTime = mTime;
+                break;
+
+            case VCACHE_MODEL_BATCH:
+                ++mBatch;
+                mBatchSize = 0;
+                break;
+            }
+        }
+
+        // Returns the number of cache misses for the face, ignoring unused indices
+        uint32_t access(uint32_t i0, uint32_t i1, uint32_t i2)
+        {
+            if (mModel == VCACHE_MODEL_BATCH)
+            {
+                uint32_t misses = batch_misses(i0, i1, i2);
+                if (mBatchSize + misses > mCacheSize && mBatchSize > 0)
+                {
+                    ++mBatch;
+                    mBatchSize = 0;
+                    misses = batch_misses(i0, i1, i2);
+                }
+
+                const uint32_t face[3] = { i0, i1, i2 };
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    if (face[j] != UNUSED32)
+                    {
+                        assert(face[j] < mVerts);
+                        mStamps[face[j]] = mBatch;
+                    }
+                }
+
+                mBatchSize += misses;
+                return misses;
+            }
+
+            return access(i0) + access(i1) + access(i2);
+        }
+
+    private:
+        uint32_t access(uint32_t v)
+        {
+            if (v == UNUSED32)
+                return 0;
+
+            assert(v < mVerts);
+
+            if (mModel == VCACHE_MODEL_FIFO)
+            {
+                if (mStamps[v] && (mMisses - mStamps[v]) < mCacheSize)
+                    return 0;
+
+                mStamps[v] = ++mMisses;
+                return 1;
+            }
+
+            assert(mModel == VCACHE_MODEL_LRU);
+            assert(mTime < mMaxAccesses);
+
+            uint32_t now = ++mTime;
+            uint32_t last = mStamps[v];
+
+            uint32_t miss = 1;
+            if (last > mClearTime)
+            {
+                // each vertex only has its latest access marked in the tree
+                uint32_t distance = prefix(now - 1) - prefix(last);
+                if (distance < mCacheSize)
+                    miss = 0;
+            }
+
+            if (last)
+            {
+                update(last, uint32_t(-1));
+            }
+
+            update(now, 1);
+            mStamps[v] = now;
+
+            return miss;
+        }
+
+        uint32_t batch_misses(uint32_t i0, uint32_t i1, uint32_t i2) const
+        {
+            uint32_t misses = 0;
+            if (i0 != UNUSED32 && mStamps[i0] != mBatch)
+                ++misses;
+            if (i1 != UNUSED32 && i1 != i0 && mStamps[i1] != mBatch)
+                ++misses;
+            if (i2 != UNUSED32 && i2 != i0 && i2 != i1 && mStamps[i2] != mBatch)
+                ++misses;
+            return misses;
+        }
+
+        uint32_t prefix(uint32_t t) const
+        {
+            uint32_t sum = 0;
+            for (; t > 0; t &= t - 1)
+            {
+                sum += mTree[t];
+            }
+            return sum;
+        }
+
+        void update(uint32_t t, uint32_t delta)
+        {
+            for (; t <= mMaxAccesses; t += t & (0u - t))
+            {
+                mTree[t] += delta;
+            }
+        }
+
+        VCACHE_MODEL                mModel;
+        uint32_t                    mCacheSize;
+        size_t                      mVerts;
+        size_t                      mMaxAccesses;
+        uint32_t                    mMisses;
+        uint32_t                    mTime;
+        uint32_t                    mClearTime;
+        uint32_t                    mBatch;
+        uint32_t                    mBatchSize;
+        std::unique_ptr<uint32_t[]> mStamps;
+        std::unique_ptr<uint32_t[]> mTree;
+    };
+
 } // namespace
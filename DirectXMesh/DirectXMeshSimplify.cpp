@@ -0,0 +1,675 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshSimplify.cpp
+//
+// DirectX Mesh Geometry Library - Mesh simplification
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+//
+// Garland & Heckbert, "Surface Simplification Using Quadric Error Metrics", SIGGRAPH 1997
+//
+// Edges are collapsed onto one of their existing points, so every LOD indexes the input
+// vertex buffer. Topology is tracked per point (the pointRep of each vertex) and all
+// vertices sharing a point collapse together, each onto the vertex of the target point
+// that shares its faces. Collapses that would tear an attribute seam or pull in an open
+// border fail that mapping or the border test, and both seams and borders also carry
+// extra constraint quadrics so they keep their shape.
+//
+
+namespace
+{
+    const double c_BoundaryWeight = 10.0;
+
+    //---------------------------------------------------------------------------------
+    // Symmetric 4x4 error quadric
+    //---------------------------------------------------------------------------------
+    struct Quadric
+    {
+        double a00, a01, a02, a03;
+        double a11, a12, a13;
+        double a22, a23;
+        double a33;
+
+        void add_plane(double nx, double ny, double nz, double d, double weight)
+        {
+            a00 += weight * nx * nx; a01 += weight * nx * ny; a02 += weight * nx * nz; a03 += weight * nx * d;
+            a11 += weight * ny * ny; a12 += weight * ny * nz; a13 += weight * ny * d;
+            a22 += weight * nz * nz; a23 += weight * nz * d;
+            a33 += weight * d * d;
+        }
+
+        void add(const Quadric& q)
+        {
+            a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+            a11 += q.a11; a12 += q.a12; a13 += q.a13;
+            a22 += q.a22; a23 += q.a23;
+            a33 += q.a33;
+        }
+
+        double error(const XMFLOAT3& p) const
+        {
+            const double x = p.x;
+            const double y = p.y;
+            const double z = p.z;
+
+            double e = x * (a00 * x + 2.0 * (a01 * y + a02 * z + a03))
+                + y * (a11 * y + 2.0 * (a12 * z + a13))
+                + z * (a22 * z + 2.0 * a23)
+                + a33;
+
+            return std::max(e, 0.0);
+        }
+    };
+
+
+    //---------------------------------------------------------------------------------
+    // Edge collapse simplifier
+    //---------------------------------------------------------------------------------
+    class simplifier
+    {
+    public:
+        simplifier() noexcept : mPositions(nullptr), mnFaces(0), mLiveFaces(0), mMaxError(0.f), mStamp(0) {}
+
+        template<class index_t>
+        HRESULT initialize(_In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+            _In_reads_(nVerts) const XMFLOAT3* positions, size_t nVerts,
+            _In_reads_opt_(nVerts) const uint32_t* pointRep)
+        {
+            mPositions = positions;
+            mnFaces = nFaces;
+            mLiveFaces = 0;
+            mMaxError = 0.f;
+
+            mIndices.reset(new (std::nothrow) uint32_t[nFaces * 3]);
+            mFaceLive.reset(new (std::nothrow) bool[nFaces]);
+            mPointReps.reset(new (std::nothrow) uint32_t[nVerts]);
+            mPointLive.reset(new (std::nothrow) bool[nVerts]);
+            mVersions.reset(new (std::nothrow) uint32_t[nVerts]);
+            mQuadrics.reset(new (std::nothrow) Quadric[nVerts]);
+            mRingStamps.reset(new (std::nothrow) uint32_t[nVerts]);
+            mRingSlots.reset(new (std::nothrow) uint32_t[nVerts]);
+            if (!mIndices || !mFaceLive || !mPointReps || !mPointLive || !mVersions || !mQuadrics || !mRingStamps || !mRingSlots)
+                return E_OUTOFMEMORY;
+
+            for (size_t j = 0; j < nVerts; ++j)
+            {
+                uint32_t rep = (pointRep) ? pointRep[j] : uint32_t(j);
+                if (rep >= nVerts || (pointRep && pointRep[rep] != rep))
+                    return E_INVALIDARG;
+
+                mPointReps[j] = rep;
+            }
+
+            memset(mPointLive.get(), 0, sizeof(bool) * nVerts);
+            memset(mVersions.get(), 0, sizeof(uint32_t) * nVerts);
+            memset(mQuadrics.get(), 0, sizeof(Quadric) * nVerts);
+            memset(mRingStamps.get(), 0, sizeof(uint32_t) * nVerts);
+            mStamp = 0;
+
+            mPointFaces.clear();
+            mPointFaces.resize(nVerts);
+
+            // unused and degenerate faces take no part and are dropped from every LOD
+            for (size_t face = 0; face < nFaces; ++face)
+            {
+                uint32_t* tri = &mIndices[face * 3];
+                mFaceLive[face] = false;
+
+                bool unused = false;
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    index_t i = indices[face * 3 + j];
+                    if (i == index_t(-1))
+                    {
+                        unused = true;
+                        tri[j] = UNUSED32;
+                    }
+                    else if (i >= nVerts)
+                        return E_UNEXPECTED;
+                    else
+                        tri[j] = i;
+                }
+
+                if (unused)
+                    continue;
+
+                uint32_t p0 = mPointReps[tri[0]];
+                uint32_t p1 = mPointReps[tri[1]];
+                uint32_t p2 = mPointReps[tri[2]];
+                if (p0 == p1 || p0 == p2 || p1 == p2)
+                    continue;
+
+                mFaceLive[face] = true;
+                ++mLiveFaces;
+
+                mPointFaces[p0].push_back(uint32_t(face));
+                mPointFaces[p1].push_back(uint32_t(face));
+                mPointFaces[p2].push_back(uint32_t(face));
+
+                mPointLive[p0] = mPointLive[p1] = mPointLive[p2] = true;
+
+                // area weighted plane of the face
+                XMVECTOR v0 = XMLoadFloat3(&positions[p0]);
+                XMVECTOR n = XMVector3Cross(XMVectorSubtract(XMLoadFloat3(&positions[p1]), v0), XMVectorSubtract(XMLoadFloat3(&positions[p2]), v0));
+
+                float length = XMVectorGetX(XMVector3Length(n));
+                if (length > 0.f)
+                {
+                    XMFLOAT3 normal;
+                    XMStoreFloat3(&normal, XMVectorScale(n, 1.f / length));
+
+                    double d = -(double(normal.x) * positions[p0].x + double(normal.y) * positions[p0].y + double(normal.z) * positions[p0].z);
+
+                    Quadric q = {};
+                    q.add_plane(normal.x, normal.y, normal.z, d, 0.5 * double(length));
+
+                    mQuadrics[p0].add(q);
+                    mQuadrics[p1].add(q);
+                    mQuadrics[p2].add(q);
+                }
+            }
+
+            // open borders and attribute seams keep their shape through perpendicular planes
+            for (size_t face = 0; face < nFaces; ++face)
+            {
+                if (!mFaceLive[face])
+                    continue;
+
+                const uint32_t* tri = &mIndices[face * 3];
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    uint32_t a = tri[j];
+                    uint32_t b = tri[(j + 1) % 3];
+
+                    if (is_boundary_edge(uint32_t(face), a, b))
+                    {
+                        add_boundary_quadric(a, b, tri[(j + 2) % 3]);
+                    }
+                }
+            }
+
+            mHeap.clear();
+            mHeap.reserve(nVerts);
+
+            for (size_t j = 0; j < nVerts; ++j)
+            {
+                if (mPointLive[j])
+                {
+                    update(uint32_t(j));
+                }
+            }
+
+            return S_OK;
+        }
+
+        size_t live_faces() const { return mLiveFaces; }
+
+        float max_error() const { return sqrtf(mMaxError); }
+
+        void simplify(size_t targetFaces)
+        {
+            std::vector<std::pair<uint32_t, uint32_t>> vertexMap;
+
+            while (mLiveFaces > targetFaces && !mHeap.empty())
+            {
+                std::pop_heap(mHeap.begin(), mHeap.end(), collapse_greater);
+                collapse c = mHeap.back();
+                mHeap.pop_back();
+
+                if (!mPointLive[c.point] || mVersions[c.point] != c.version)
+                    continue;
+
+                // changes next to the target can invalidate a queued collapse
+                if (!mPointLive[c.target] || !can_collapse(c.point, c.target, vertexMap))
+                {
+                    ++mVersions[c.point];
+                    update(c.point);
+                    continue;
+                }
+
+                mMaxError = std::max(mMaxError, c.cost);
+
+                apply(c.point, c.target, vertexMap);
+            }
+        }
+
+        template<class index_t>
+        void emit(std::vector<index_t>& lodIndices) const
+        {
+            for (size_t face = 0; face < mnFaces; ++face)
+            {
+                if (!mFaceLive[face])
+                    continue;
+
+                const uint32_t* tri = &mIndices[face * 3];
+                lodIndices.push_back(static_cast<index_t>(tri[0]));
+                lodIndices.push_back(static_cast<index_t>(tri[1]));
+                lodIndices.push_back(static_cast<index_t>(tri[2]));
+            }
+        }
+
+    private:
+        struct collapse
+        {
+            float       cost;
+            float       lengthSq;
+            uint32_t    point;
+            uint32_t    target;
+            uint32_t    version;
+        };
+
+        // ties, common on flat areas, go to the shortest edge so collapses do not pile onto one point
+        static bool collapse_greater(const collapse& a, const collapse& b)
+        {
+            return (a.cost > b.cost) || (a.cost == b.cost && a.lengthSq > b.lengthSq);
+        }
+
+        uint32_t corner(uint32_t face, uint32_t point) const
+        {
+            const uint32_t* tri = &mIndices[face * 3];
+            for (uint32_t j = 0; j < 3; ++j)
+            {
+                if (mPointReps[tri[j]] == point)
+                    return j;
+            }
+            return UNUSED32;
+        }
+
+        // true for open borders, and for seams where the face across uses other vertices
+        bool is_boundary_edge(uint32_t face, uint32_t a, uint32_t b) const
+        {
+            const uint32_t pa = mPointReps[a];
+            const uint32_t pb = mPointReps[b];
+
+            for (auto it = mPointFaces[pb].cbegin(); it != mPointFaces[pb].cend(); ++it)
+            {
+                if (*it == face || !mFaceLive[*it])
+                    continue;
+
+                const uint32_t* tri = &mIndices[*it * 3];
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    if (mPointReps[tri[j]] == pb && mPointReps[tri[(j + 1) % 3]] == pa)
+                    {
+                        return (tri[j] != b || tri[(j + 1) % 3] != a);
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        void add_boundary_quadric(uint32_t a, uint32_t b, uint32_t c)
+        {
+            const uint32_t pa = mPointReps[a];
+            const uint32_t pb = mPointReps[b];
+
+            XMVECTOR v0 = XMLoadFloat3(&mPositions[pa]);
+            XMVECTOR edge = XMVectorSubtract(XMLoadFloat3(&mPositions[pb]), v0);
+            XMVECTOR n = XMVector3Cross(edge, XMVectorSubtract(XMLoadFloat3(&mPositions[mPointReps[c]]), v0));
+
+            XMVECTOR perp = XMVector3Cross(edge, n);
+
+            float length = XMVectorGetX(XMVector3Length(perp));
+            if (!(length > 0.f))
+                return;
+
+            XMFLOAT3 normal;
+            XMStoreFloat3(&normal, XMVectorScale(perp, 1.f / length));
+
+            double d = -(double(normal.x) * mPositions[pa].x + double(normal.y) * mPositions[pa].y + double(normal.z) * mPositions[pa].z);
+            double weight = c_BoundaryWeight * double(XMVectorGetX(XMVector3LengthSq(edge)));
+
+            Quadric q = {};
+            q.add_plane(normal.x, normal.y, normal.z, d, weight);
+
+            mQuadrics[pa].add(q);
+            mQuadrics[pb].add(q);
+        }
+
+        // Gathers the neighboring points with the number of live faces shared with each,
+        // stamping them so that membership tests against the ring are constant time
+        void gather_ring(uint32_t point, std::vector<std::pair<uint32_t, uint32_t>>& ring)
+        {
+            ring.clear();
+
+            if (++mStamp == 0)
+            {
+                memset(mRingStamps.get(), 0, sizeof(uint32_t) * mPointFaces.size());
+                mStamp = 1;
+            }
+
+            for (auto it = mPointFaces[point].cbegin(); it != mPointFaces[point].cend(); ++it)
+            {
+                if (!mFaceLive[*it])
+                    continue;
+
+                const uint32_t* tri = &mIndices[*it * 3];
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    uint32_t p = mPointReps[tri[j]];
+                    if (p == point)
+                        continue;
+
+                    if (mRingStamps[p] == mStamp)
+                    {
+                        ++ring[mRingSlots[p]].second;
+                    }
+                    else
+                    {
+                        mRingStamps[p] = mStamp;
+                        mRingSlots[p] = static_cast<uint32_t>(ring.size());
+                        ring.emplace_back(p, 1);
+                    }
+                }
+            }
+        }
+
+        bool can_collapse(uint32_t point, uint32_t target, std::vector<std::pair<uint32_t, uint32_t>>& vertexMap)
+        {
+            gather_ring(point, mRing);
+
+            // non-manifold edges lock the point, and border points only move along the border
+            uint32_t shared = 0;
+            bool border = false;
+            for (auto it = mRing.cbegin(); it != mRing.cend(); ++it)
+            {
+                if (it->second > 2)
+                    return false;
+
+                if (it->second == 1)
+                    border = true;
+
+                if (it->first == target)
+                    shared = it->second;
+            }
+
+            if (!shared || (border && shared != 1))
+                return false;
+
+            // the only common neighbors must be the ones opposite the collapsed edge
+            const uint32_t c_Counted = 0x80000000;
+
+            uint32_t common = 0;
+            for (auto it = mPointFaces[target].cbegin(); it != mPointFaces[target].cend(); ++it)
+            {
+                if (!mFaceLive[*it])
+                    continue;
+
+                const uint32_t* tri = &mIndices[*it * 3];
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    uint32_t p = mPointReps[tri[j]];
+                    if (p == target || mRingStamps[p] != mStamp)
+                        continue;
+
+                    uint32_t& count = mRing[mRingSlots[p]].second;
+                    if (!(count & c_Counted))
+                    {
+                        count |= c_Counted;
+                        ++common;
+                    }
+                }
+            }
+
+            if (common != shared)
+                return false;
+
+            // each vertex of the point must move to the single target vertex it shares a face with
+            vertexMap.clear();
+            for (auto it = mPointFaces[point].cbegin(); it != mPointFaces[point].cend(); ++it)
+            {
+                if (!mFaceLive[*it])
+                    continue;
+
+                uint32_t ct = corner(*it, target);
+                if (ct == UNUSED32)
+                    continue;
+
+                uint32_t from = mIndices[*it * 3 + corner(*it, point)];
+                uint32_t to = mIndices[*it * 3 + ct];
+
+                auto match = std::find_if(vertexMap.cbegin(), vertexMap.cend(), [from](const std::pair<uint32_t, uint32_t>& e) { return e.first == from; });
+                if (match == vertexMap.cend())
+                {
+                    vertexMap.emplace_back(from, to);
+                }
+                else if (match->second != to)
+                    return false;
+            }
+
+            XMVECTOR pt = XMLoadFloat3(&mPositions[target]);
+
+            for (auto it = mPointFaces[point].cbegin(); it != mPointFaces[point].cend(); ++it)
+            {
+                if (!mFaceLive[*it])
+                    continue;
+
+                const uint32_t* tri = &mIndices[*it * 3];
+                uint32_t c = corner(*it, point);
+
+                if (std::find_if(vertexMap.cbegin(), vertexMap.cend(),
+                    [&](const std::pair<uint32_t, uint32_t>& e) { return e.first == tri[c]; }) == vertexMap.cend())
+                    return false;
+
+                if (corner(*it, target) != UNUSED32)
+                    continue;
+
+                // reject collapses that flip a remaining face
+                XMVECTOR p0 = XMLoadFloat3(&mPositions[mPointReps[tri[c]]]);
+                XMVECTOR p1 = XMLoadFloat3(&mPositions[mPointReps[tri[(c + 1) % 3]]]);
+                XMVECTOR p2 = XMLoadFloat3(&mPositions[mPointReps[tri[(c + 2) % 3]]]);
+
+                XMVECTOR n0 = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+                XMVECTOR n1 = XMVector3Cross(XMVectorSubtract(p1, pt), XMVectorSubtract(p2, pt));
+
+                if (XMVectorGetX(XMVector3Dot(n0, n1)) <= 0.f)
+                    return false;
+            }
+
+            return true;
+        }
+
+        // Queues the cheapest valid collapse of the point
+        void update(uint32_t point)
+        {
+            gather_ring(point, mRing);
+
+            // validate in order of cost, since the topology checks cost more than the quadrics
+            XMVECTOR p0 = XMLoadFloat3(&mPositions[point]);
+
+            mCandidates.clear();
+            for (auto it = mRing.cbegin(); it != mRing.cend(); ++it)
+            {
+                Quadric q = mQuadrics[point];
+                q.add(mQuadrics[it->first]);
+
+                collapse c;
+                c.cost = static_cast<float>(q.error(mPositions[it->first]));
+                c.lengthSq = XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(XMLoadFloat3(&mPositions[it->first]), p0)));
+                c.point = point;
+                c.target = it->first;
+                c.version = mVersions[point];
+                mCandidates.push_back(c);
+            }
+
+            std::sort(mCandidates.begin(), mCandidates.end(), [](const collapse& a, const collapse& b) { return collapse_greater(b, a); });
+
+            for (auto it = mCandidates.cbegin(); it != mCandidates.cend(); ++it)
+            {
+                if (!can_collapse(point, it->target, mVertexMap))
+                    continue;
+
+                const collapse& c = *it;
+                mHeap.push_back(c);
+                std::push_heap(mHeap.begin(), mHeap.end(), collapse_greater);
+                return;
+            }
+        }
+
+        void apply(uint32_t point, uint32_t target, const std::vector<std::pair<uint32_t, uint32_t>>& vertexMap)
+        {
+            auto& targetFaces = mPointFaces[target];
+
+            for (auto it = mPointFaces[point].cbegin(); it != mPointFaces[point].cend(); ++it)
+            {
+                if (!mFaceLive[*it])
+                    continue;
+
+                if (corner(*it, target) != UNUSED32)
+                {
+                    mFaceLive[*it] = false;
+                    --mLiveFaces;
+                    continue;
+                }
+
+                uint32_t& v = mIndices[*it * 3 + corner(*it, point)];
+                for (auto m = vertexMap.cbegin(); m != vertexMap.cend(); ++m)
+                {
+                    if (m->first == v)
+                    {
+                        v = m->second;
+                        break;
+                    }
+                }
+
+                targetFaces.push_back(*it);
+            }
+
+            mPointFaces[point].clear();
+            mPointFaces[point].shrink_to_fit();
+            mPointLive[point] = false;
+
+            targetFaces.erase(std::remove_if(targetFaces.begin(), targetFaces.end(),
+                [this](uint32_t face) { return !mFaceLive[face]; }), targetFaces.end());
+
+            mQuadrics[target].add(mQuadrics[point]);
+
+            // requeue the target and its ring, whose costs and valid collapses changed
+            gather_ring(target, mUpdates);
+
+            ++mVersions[target];
+            update(target);
+
+            for (auto it = mUpdates.cbegin(); it != mUpdates.cend(); ++it)
+            {
+                ++mVersions[it->first];
+                update(it->first);
+            }
+        }
+
+        const XMFLOAT3*                                 mPositions;
+        size_t                                          mnFaces;
+        size_t                                          mLiveFaces;
+        float                                           mMaxError;
+        std::unique_ptr<uint32_t[]>                     mIndices;
+        std::unique_ptr<bool[]>                         mFaceLive;
+        std::unique_ptr<uint32_t[]>                     mPointReps;
+        std::unique_ptr<bool[]>                         mPointLive;
+        std::unique_ptr<uint32_t[]>                     mVersions;
+        std::unique_ptr<Quadric[]>                      mQuadrics;
+        std::vector<std::vector<uint32_t>>              mPointFaces;
+        std::vector<collapse>                           mHeap;
+        std::unique_ptr<uint32_t[]>                     mRingStamps;
+        std::unique_ptr<uint32_t[]>                     mRingSlots;
+        uint32_t                                        mStamp;
+        std::vector<std::pair<uint32_t, uint32_t>>      mRing;
+        std::vector<collapse>                           mCandidates;
+        std::vector<std::pair<uint32_t, uint32_t>>      mUpdates;
+        std::vector<std::pair<uint32_t, uint32_t>>      mVertexMap;
+    };
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT GenerateLODsImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, size_t nVerts,
+        _In_reads_opt_(nVerts) const uint32_t* pointRep,
+        _In_reads_(nLODs) const size_t* targetFaces, size_t nLODs,
+        std::vector<index_t>& lodIndices,
+        std::vector<std::pair<size_t, size_t>>& lodRanges,
+        _Out_writes_opt_(nLODs) float* lodErrors)
+    {
+        if (!indices || !nFaces || !positions || !nVerts || !targetFaces || !nLODs)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        for (size_t j = 1; j < nLODs; ++j)
+        {
+            if (targetFaces[j] > targetFaces[j - 1])
+                return E_INVALIDARG;
+        }
+
+        simplifier simp;
+        HRESULT hr = simp.initialize(indices, nFaces, positions, nVerts, pointRep);
+        if (FAILED(hr))
+            return hr;
+
+        lodIndices.clear();
+        lodIndices.reserve(std::min(simp.live_faces(), targetFaces[0]) * 3 * 2);
+
+        lodRanges.clear();
+        lodRanges.reserve(nLODs);
+
+        // each LOD continues from the previous one with the same queue of collapses
+        for (size_t j = 0; j < nLODs; ++j)
+        {
+            simp.simplify(targetFaces[j]);
+
+            size_t offset = lodIndices.size();
+            simp.emit(lodIndices);
+            lodRanges.emplace_back(offset, lodIndices.size() - offset);
+
+            if (lodErrors)
+            {
+                lodErrors[j] = simp.max_error();
+            }
+        }
+
+        return S_OK;
+    }
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateLODs(
+    const uint16_t* indices, size_t nFaces,
+    const XMFLOAT3* positions, size_t nVerts,
+    const uint32_t* pointRep,
+    const size_t* targetFaces, size_t nLODs,
+    std::vector<uint16_t>& lodIndices,
+    std::vector<std::pair<size_t, size_t>>& lodRanges,
+    float* lodErrors)
+{
+    return GenerateLODsImpl<uint16_t>(indices, nFaces, positions, nVerts, pointRep, targetFaces, nLODs, lodIndices, lodRanges, lodErrors);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateLODs(
+    const uint32_t* indices, size_t nFaces,
+    const XMFLOAT3* positions, size_t nVerts,
+    const uint32_t* pointRep,
+    const size_t* targetFaces, size_t nLODs,
+    std::vector<uint32_t>& lodIndices,
+    std::vector<std::pair<size_t, size_t>>& lodRanges,
+    float* lodErrors)
+{
+    return GenerateLODsImpl<uint32_t>(indices, nFaces, positions, nVerts, pointRep, targetFaces, nLODs, lodIndices, lodRanges, lodErrors);
+}
@@ -0,0 +1,500 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshSimplifyClustering.cpp
+//
+// DirectX Mesh Geometry Library - Mesh simplification by vertex clustering
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+//
+// Rossignac & Borrel, "Multi-resolution 3D approximations for rendering complex scenes", 1993
+//
+// Points are snapped to a uniform grid and every point in a cell is moved onto the vertex
+// nearest the centroid of the cell, so the result indexes the input vertex buffer. The
+// points are bucketed by a hash of their cell with a counting sort, after which each bucket
+// holds whole cells and is clustered independently. Every pass is linear in the number of
+// points or faces, and the per-block and per-bucket passes run in parallel when built with
+// OpenMP.
+//
+
+namespace
+{
+    const size_t c_MaxGridSize = 1024;
+    const size_t c_BlockSize = 16384;
+    const uint32_t c_BucketBits = 8;
+    const uint32_t c_EmptyCell = UINT32_MAX;
+
+    // Murmur3 finalizer, as the high bits pick the bucket and the low bits the table slot
+    inline uint32_t hash_cell(uint32_t cell)
+    {
+        cell ^= cell >> 16;
+        cell *= 0x85ebca6bu;
+        cell ^= cell >> 13;
+        cell *= 0xc2b2ae35u;
+        cell ^= cell >> 16;
+        return cell;
+    }
+
+    inline uint32_t hash_face(uint32_t i0, uint32_t i1, uint32_t i2)
+    {
+        return (i0 * 73856093u) ^ (i1 * 19349663u) ^ (i2 * 83492791u);
+    }
+
+    inline size_t table_size(size_t count)
+    {
+        size_t size = 1;
+        while (size < count * 2)
+            size <<= 1;
+        return size;
+    }
+
+    // Rotates the face so the lowest index is first, which keeps the winding
+    template<class index_t>
+    inline void canonical_face(_In_reads_(3) const index_t* face, uint32_t& i0, uint32_t& i1, uint32_t& i2)
+    {
+        uint32_t a = face[0];
+        uint32_t b = face[1];
+        uint32_t c = face[2];
+
+        if (b < a && b < c)
+        {
+            i0 = b; i1 = c; i2 = a;
+        }
+        else if (c < a && c < b)
+        {
+            i0 = c; i1 = a; i2 = b;
+        }
+        else
+        {
+            i0 = a; i1 = b; i2 = c;
+        }
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT SimplifyByClusteringImpl(
+        _Inout_updates_all_(nFaces * 3) index_t* indices, size_t nFaces,
+        _In_reads_(nVerts) const XMFLOAT3* positions, size_t nVerts,
+        _In_reads_opt_(nVerts) const uint32_t* pointRep,
+        size_t gridSize,
+        _Out_writes_opt_(nVerts) uint32_t* clusterRep,
+        _Out_opt_ size_t* remainingFaces)
+    {
+        if (!indices || !nFaces || !positions || !nVerts)
+            return E_INVALIDARG;
+
+        if (!gridSize || gridSize > c_MaxGridSize)
+            return E_INVALIDARG;
+
+        if (nVerts >= index_t(-1))
+            return E_INVALIDARG;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        if (pointRep)
+        {
+            for (size_t j = 0; j < nVerts; ++j)
+            {
+                uint32_t rep = pointRep[j];
+                if (rep >= nVerts || pointRep[rep] != rep)
+                    return E_INVALIDARG;
+            }
+        }
+
+        // Validate before anything is written so a bad index leaves the inputs untouched
+        for (size_t j = 0; j < nFaces * 3; ++j)
+        {
+            index_t i = indices[j];
+            if (i != index_t(-1) && i >= nVerts)
+                return E_UNEXPECTED;
+        }
+
+        const size_t nBlocks = (nVerts + c_BlockSize - 1) / c_BlockSize;
+        const uint32_t bucketBits = (nVerts > c_BlockSize) ? c_BucketBits : 0;
+        const size_t nBuckets = size_t(1) << bucketBits;
+
+        std::unique_ptr<XMFLOAT3[]> blockBounds(new (std::nothrow) XMFLOAT3[nBlocks * 2]);
+        std::unique_ptr<uint32_t[]> histogram(new (std::nothrow) uint32_t[nBlocks * nBuckets]);
+        std::unique_ptr<uint32_t[]> bucketOffsets(new (std::nothrow) uint32_t[nBuckets + 1]);
+        std::unique_ptr<uint32_t[]> tableOffsets(new (std::nothrow) uint32_t[nBuckets + 1]);
+        std::unique_ptr<uint32_t[]> cells(new (std::nothrow) uint32_t[nVerts]);
+        std::unique_ptr<uint32_t[]> order(new (std::nothrow) uint32_t[nVerts]);
+        std::unique_ptr<uint32_t[]> pointCluster(new (std::nothrow) uint32_t[nVerts]);
+        std::unique_ptr<XMFLOAT4[]> centroids(new (std::nothrow) XMFLOAT4[nVerts]);
+        std::unique_ptr<float[]> bestDist(new (std::nothrow) float[nVerts]);
+        std::unique_ptr<uint32_t[]> reps(new (std::nothrow) uint32_t[nVerts]);
+        if (!blockBounds || !histogram || !bucketOffsets || !tableOffsets || !cells || !order
+            || !pointCluster || !centroids || !bestDist || !reps)
+            return E_OUTOFMEMORY;
+
+        // Bounds of the points
+        const int blockCount = static_cast<int>(nBlocks);
+
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif
+        for (int block = 0; block < blockCount; ++block)
+        {
+            size_t first = size_t(block) * c_BlockSize;
+            size_t last = std::min(first + c_BlockSize, nVerts);
+
+            XMVECTOR vMin = g_XMFltMax;
+            XMVECTOR vMax = XMVectorNegate(g_XMFltMax);
+
+            for (size_t j = first; j < last; ++j)
+            {
+                if (pointRep && pointRep[j] != j)
+                    continue;
+
+                XMVECTOR p = XMLoadFloat3(&positions[j]);
+                vMin = XMVectorMin(vMin, p);
+                vMax = XMVectorMax(vMax, p);
+            }
+
+            XMStoreFloat3(&blockBounds[size_t(block) * 2], vMin);
+            XMStoreFloat3(&blockBounds[size_t(block) * 2 + 1], vMax);
+        }
+
+        XMVECTOR vMin = g_XMFltMax;
+        XMVECTOR vMax = XMVectorNegate(g_XMFltMax);
+        for (size_t block = 0; block < nBlocks; ++block)
+        {
+            vMin = XMVectorMin(vMin, XMLoadFloat3(&blockBounds[block * 2]));
+            vMax = XMVectorMax(vMax, XMLoadFloat3(&blockBounds[block * 2 + 1]));
+        }
+
+        XMFLOAT3 extent;
+        XMStoreFloat3(&extent, XMVectorMax(XMVectorSubtract(vMax, vMin), g_XMZero));
+
+        XMFLOAT3 origin;
+        XMStoreFloat3(&origin, vMin);
+
+        float maxExtent = std::max(std::max(extent.x, extent.y), extent.z);
+        float cellScale = (maxExtent > 0.f) ? float(gridSize) / maxExtent : 0.f;
+
+        uint32_t dims[3];
+        dims[0] = uint32_t(std::min<float>(float(gridSize), std::max(1.f, std::ceil(extent.x * cellScale))));
+        dims[1] = uint32_t(std::min<float>(float(gridSize), std::max(1.f, std::ceil(extent.y * cellScale))));
+        dims[2] = uint32_t(std::min<float>(float(gridSize), std::max(1.f, std::ceil(extent.z * cellScale))));
+
+        const XMVECTOR vOrigin = XMLoadFloat3(&origin);
+        const XMVECTOR vScale = XMVectorReplicate(cellScale);
+        const XMVECTOR vLimit = XMVectorSet(float(dims[0] - 1), float(dims[1] - 1), float(dims[2] - 1), 0.f);
+
+        // Snap each point to its cell and count the cells of each block per bucket
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif
+        for (int block = 0; block < blockCount; ++block)
+        {
+            size_t first = size_t(block) * c_BlockSize;
+            size_t last = std::min(first + c_BlockSize, nVerts);
+
+            uint32_t* counts = &histogram[size_t(block) * nBuckets];
+            memset(counts, 0, sizeof(uint32_t) * nBuckets);
+
+            for (size_t j = first; j < last; ++j)
+            {
+                if (pointRep && pointRep[j] != j)
+                {
+                    cells[j] = c_EmptyCell;
+                    continue;
+                }
+
+                XMVECTOR p = XMVectorMultiply(XMVectorSubtract(XMLoadFloat3(&positions[j]), vOrigin), vScale);
+
+                // NaN positions clamp to the first cell
+                p = XMVectorMin(XMVectorMax(p, g_XMZero), vLimit);
+
+                XMFLOAT3 c;
+                XMStoreFloat3(&c, p);
+
+                uint32_t cell = uint32_t(c.x) + dims[0] * (uint32_t(c.y) + dims[1] * uint32_t(c.z));
+                cells[j] = cell;
+
+                if (bucketBits)
+                {
+                    ++counts[hash_cell(cell) >> (32 - bucketBits)];
+                }
+                else
+                {
+                    ++counts[0];
+                }
+            }
+        }
+
+        // Prefix sums give each block its slice of each bucket
+        uint32_t offset = 0;
+        uint32_t tableOffset = 0;
+        for (size_t bucket = 0; bucket < nBuckets; ++bucket)
+        {
+            bucketOffsets[bucket] = offset;
+            tableOffsets[bucket] = tableOffset;
+
+            uint32_t count = 0;
+            for (size_t block = 0; block < nBlocks; ++block)
+            {
+                uint32_t n = histogram[block * nBuckets + bucket];
+                histogram[block * nBuckets + bucket] = offset + count;
+                count += n;
+            }
+
+            offset += count;
+            tableOffset += (count > 0) ? uint32_t(table_size(count)) : 0;
+        }
+        bucketOffsets[nBuckets] = offset;
+        tableOffsets[nBuckets] = tableOffset;
+
+        std::unique_ptr<uint32_t[]> table(new (std::nothrow) uint32_t[size_t(tableOffset) * 2]);
+        if (!table)
+            return E_OUTOFMEMORY;
+
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif
+        for (int block = 0; block < blockCount; ++block)
+        {
+            size_t first = size_t(block) * c_BlockSize;
+            size_t last = std::min(first + c_BlockSize, nVerts);
+
+            uint32_t* slots = &histogram[size_t(block) * nBuckets];
+
+            for (size_t j = first; j < last; ++j)
+            {
+                uint32_t cell = cells[j];
+                if (cell == c_EmptyCell)
+                    continue;
+
+                uint32_t bucket = (bucketBits) ? (hash_cell(cell) >> (32 - bucketBits)) : 0;
+                order[slots[bucket]++] = uint32_t(j);
+            }
+        }
+
+        // Cluster each bucket, which holds every point of its cells
+        const int bucketCount = static_cast<int>(nBuckets);
+
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (int bucket = 0; bucket < bucketCount; ++bucket)
+        {
+            uint32_t first = bucketOffsets[bucket];
+            uint32_t last = bucketOffsets[bucket + 1];
+            if (first == last)
+                continue;
+
+            uint32_t* cellTable = &table[size_t(tableOffsets[bucket]) * 2];
+            uint32_t mask = tableOffsets[bucket + 1] - tableOffsets[bucket] - 1;
+
+            for (uint32_t j = 0; j <= mask; ++j)
+            {
+                cellTable[j * 2] = c_EmptyCell;
+            }
+
+            // Clusters of the bucket are numbered from its first point
+            uint32_t nClusters = first;
+
+            for (uint32_t j = first; j < last; ++j)
+            {
+                uint32_t point = order[j];
+                uint32_t cell = cells[point];
+
+                uint32_t slot = hash_cell(cell) & mask;
+                while (cellTable[slot * 2] != c_EmptyCell && cellTable[slot * 2] != cell)
+                {
+                    slot = (slot + 1) & mask;
+                }
+
+                uint32_t cluster;
+                if (cellTable[slot * 2] == c_EmptyCell)
+                {
+                    cluster = nClusters++;
+                    cellTable[slot * 2] = cell;
+                    cellTable[slot * 2 + 1] = cluster;
+
+                    centroids[cluster] = XMFLOAT4(0.f, 0.f, 0.f, 0.f);
+                    bestDist[cluster] = FLT_MAX;
+                    reps[cluster] = point;
+                }
+                else
+                {
+                    cluster = cellTable[slot * 2 + 1];
+                }
+
+                pointCluster[point] = cluster;
+
+                XMFLOAT4& c = centroids[cluster];
+                c.x += positions[point].x;
+                c.y += positions[point].y;
+                c.z += positions[point].z;
+                c.w += 1.f;
+            }
+
+            for (uint32_t cluster = first; cluster < nClusters; ++cluster)
+            {
+                XMFLOAT4& c = centroids[cluster];
+                float scale = 1.f / c.w;
+                c.x *= scale;
+                c.y *= scale;
+                c.z *= scale;
+            }
+
+            // Points are in vertex order within a bucket, so ties keep the lowest vertex
+            for (uint32_t j = first; j < last; ++j)
+            {
+                uint32_t point = order[j];
+                uint32_t cluster = pointCluster[point];
+
+                XMVECTOR delta = XMVectorSubtract(XMLoadFloat3(&positions[point]), XMLoadFloat4(&centroids[cluster]));
+                float dist = XMVectorGetX(XMVector3LengthSq(delta));
+                if (dist < bestDist[cluster])
+                {
+                    bestDist[cluster] = dist;
+                    reps[cluster] = point;
+                }
+            }
+        }
+
+        // Every vertex follows its point onto the representative of the cluster
+        const int vertCount = static_cast<int>(nVerts);
+
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif
+        for (int vert = 0; vert < vertCount; ++vert)
+        {
+            uint32_t point = (pointRep) ? pointRep[vert] : uint32_t(vert);
+
+            // the cells are no longer needed, so they hold the vertex map
+            cells[vert] = reps[pointCluster[point]];
+        }
+
+        if (clusterRep)
+        {
+            memcpy(clusterRep, cells.get(), sizeof(uint32_t) * nVerts);
+        }
+
+        // Remap the faces, marking collapsed faces as unused
+        const int faceCount = static_cast<int>(nFaces);
+        const uint32_t* vertexMap = cells.get();
+
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif
+        for (int face = 0; face < faceCount; ++face)
+        {
+            index_t* f = &indices[size_t(face) * 3];
+
+            if (f[0] == index_t(-1)
+                || f[1] == index_t(-1)
+                || f[2] == index_t(-1))
+            {
+                f[0] = f[1] = f[2] = index_t(-1);
+                continue;
+            }
+
+            index_t i0 = index_t(vertexMap[f[0]]);
+            index_t i1 = index_t(vertexMap[f[1]]);
+            index_t i2 = index_t(vertexMap[f[2]]);
+
+            if (i0 == i1 || i0 == i2 || i1 == i2)
+            {
+                f[0] = f[1] = f[2] = index_t(-1);
+            }
+            else
+            {
+                f[0] = i0;
+                f[1] = i1;
+                f[2] = i2;
+            }
+        }
+
+        // Drop repeats of a face with the same winding, keeping the first
+        size_t faceTableSize = table_size(nFaces);
+        std::unique_ptr<uint32_t[]> faceTable(new (std::nothrow) uint32_t[faceTableSize]);
+        if (!faceTable)
+            return E_OUTOFMEMORY;
+
+        memset(faceTable.get(), 0xff, sizeof(uint32_t) * faceTableSize);
+
+        size_t faceMask = faceTableSize - 1;
+        size_t remaining = 0;
+
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            index_t* f = &indices[face * 3];
+            if (f[0] == index_t(-1))
+                continue;
+
+            uint32_t i0, i1, i2;
+            canonical_face(f, i0, i1, i2);
+
+            size_t slot = hash_face(i0, i1, i2) & faceMask;
+            bool repeat = false;
+            while (faceTable[slot] != UNUSED32)
+            {
+                uint32_t j0, j1, j2;
+                canonical_face(&indices[size_t(faceTable[slot]) * 3], j0, j1, j2);
+                if (i0 == j0 && i1 == j1 && i2 == j2)
+                {
+                    repeat = true;
+                    break;
+                }
+
+                slot = (slot + 1) & faceMask;
+            }
+
+            if (repeat)
+            {
+                f[0] = f[1] = f[2] = index_t(-1);
+            }
+            else
+            {
+                faceTable[slot] = uint32_t(face);
+                ++remaining;
+            }
+        }
+
+        if (remainingFaces)
+            *remainingFaces = remaining;
+
+        return S_OK;
+    }
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+_Use_decl_annotations_
+HRESULT DirectX::SimplifyByClustering(
+    uint16_t* indices, size_t nFaces,
+    const XMFLOAT3* positions, size_t nVerts,
+    const uint32_t* pointRep,
+    size_t gridSize,
+    uint32_t* clusterRep,
+    size_t* remainingFaces)
+{
+    return SimplifyByClusteringImpl<uint16_t>(indices, nFaces, positions, nVerts, pointRep, gridSize, clusterRep, remainingFaces);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::SimplifyByClustering(
+    uint32_t* indices, size_t nFaces,
+    const XMFLOAT3* positions, size_t nVerts,
+    const uint32_t* pointRep,
+    size_t gridSize,
+    uint32_t* clusterRep,
+    size_t* remainingFaces)
+{
+    return SimplifyByClusteringImpl<uint32_t>(indices, nFaces, positions, nVerts, pointRep, gridSize, clusterRep, remainingFaces);
+}
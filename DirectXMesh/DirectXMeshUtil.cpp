@@ -49,6 +49,8 @@ size_t DirectX::BytesPerElement(DXGI_FORMAT fmt)
     case DXGI_FORMAT_R32G32_FLOAT:
     case DXGI_FORMAT_R32G32_UINT:
     case DXGI_FORMAT_R32G32_SINT:
+    case VBFORMAT_OCTAHEDRAL_TANGENT_16:
+    case VBFORMAT_QUANTIZED_POSITION_16:
         return 8;
 
     case DXGI_FORMAT_R10G10B10A2_UNORM:
@@ -69,6 +71,8 @@ size_t DirectX::BytesPerElement(DXGI_FORMAT fmt)
     case DXGI_FORMAT_B8G8R8A8_UNORM:
     case DXGI_FORMAT_B8G8R8X8_UNORM:
     case XBOX_DXGI_FORMAT_R10G10B10_SNORM_A2_UNORM:
+    case VBFORMAT_OCTAHEDRAL_NORMAL_16:
+    case VBFORMAT_OCTAHEDRAL_TANGENT_8:
         return 4;
 
     case DXGI_FORMAT_R8G8_UNORM:
@@ -82,6 +86,7 @@ size_t DirectX::BytesPerElement(DXGI_FORMAT fmt)
     case DXGI_FORMAT_R16_SINT:
     case DXGI_FORMAT_B5G6R5_UNORM:
     case DXGI_FORMAT_B5G5R5A1_UNORM:
+    case VBFORMAT_OCTAHEDRAL_NORMAL_8:
         return 2;
 
     case DXGI_FORMAT_R8_UNORM:
@@ -100,6 +105,53 @@ size_t DirectX::BytesPerElement(DXGI_FORMAT fmt)
 }
 
 
+//-------------------------------------------------------------------------------------
+// Returns the DXGI format used to store a virtual vertex format
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+DXGI_FORMAT DirectX::GetStorageFormat(DXGI_FORMAT fmt)
+{
+    switch (static_cast<int>(fmt))
+    {
+    case VBFORMAT_OCTAHEDRAL_NORMAL_8:      return DXGI_FORMAT_R8G8_SNORM;
+    case VBFORMAT_OCTAHEDRAL_NORMAL_16:     return DXGI_FORMAT_R16G16_SNORM;
+    case VBFORMAT_OCTAHEDRAL_TANGENT_8:     return DXGI_FORMAT_R8G8B8A8_SNORM;
+    case VBFORMAT_OCTAHEDRAL_TANGENT_16:    return DXGI_FORMAT_R16G16B16A16_SNORM;
+    case VBFORMAT_QUANTIZED_POSITION_16:    return DXGI_FORMAT_R16G16B16A16_UNORM;
+    default:                                return fmt;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------
+// Computes the dequantization transform that maps the bounds of the positions to [0,1]
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+void DirectX::ComputeQuantization(const XMFLOAT3* positions, size_t nVerts, XMFLOAT3& scale, XMFLOAT3& bias)
+{
+    if (!positions || !nVerts)
+    {
+        scale = XMFLOAT3(1.f, 1.f, 1.f);
+        bias = XMFLOAT3(0.f, 0.f, 0.f);
+        return;
+    }
+
+    XMVECTOR vMin = XMLoadFloat3(positions);
+    XMVECTOR vMax = vMin;
+
+    for (size_t j = 1; j < nVerts; ++j)
+    {
+        XMVECTOR p = XMLoadFloat3(&positions[j]);
+        vMin = XMVectorMin(vMin, p);
+        vMax = XMVectorMax(vMax, p);
+    }
+
+    // A flat axis keeps a scale of 0, so every position on it dequantizes to the bias
+    XMStoreFloat3(&scale, XMVectorSubtract(vMax, vMin));
+    XMStoreFloat3(&bias, vMin);
+}
+
+
 //=====================================================================================
 // Input Layout Descriptor Utilities
 //=====================================================================================
@@ -440,15 +492,28 @@ std::vector<std::pair<size_t, size_t>> DirectX::ComputeSubsets(const uint32_t* a
 
 namespace
 {
+    //---------------------------------------------------------------------------------
+    // Simulates a FIFO cache for each requested size in a single pass. Each vertex
+    // records the miss count at the time it was inserted (plus one, zero meaning never
+    // inserted), so a vertex is still in the cache if fewer than cacheSize misses have
+    // happened since then.
+    //---------------------------------------------------------------------------------
     template<class index_t>
     void ComputeVertexCacheMissRateImpl(
-        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts, size_t cacheSize,
-        float& acmr, float& atvr)
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+        _In_reads_(count) const size_t* cacheSizes, size_t count,
+        _Out_writes_(count) float* acmr, _Out_writes_(count) float* atvr)
     {
-        acmr = -1.f;
-        atvr = -1.f;
+        if (!acmr || !atvr || !count)
+            return;
+
+        for (size_t k = 0; k < count; ++k)
+        {
+            acmr[k] = -1.f;
+            atvr[k] = -1.f;
+        }
 
-        if (!indices || !nFaces || !nVerts || !cacheSize)
+        if (!indices || !nFaces || !nVerts || !cacheSizes)
             return;
 
         if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
@@ -457,42 +522,104 @@ namespace
         if (nVerts >= index_t(-1))
             return;
 
-        size_t misses = 0;
+        for (size_t k = 0; k < count; ++k)
+        {
+            if (!cacheSizes[k])
+                return;
+        }
+
+        if (uint64_t(nVerts) * count >= SIZE_MAX / sizeof(uint32_t))
+            return;
 
-        std::unique_ptr<uint32_t[]> fifo(new uint32_t[cacheSize]);
-        size_t tail = 0;
+        std::unique_ptr<uint32_t[]> stamps(new (std::nothrow) uint32_t[nVerts * count]);
+        std::unique_ptr<uint32_t[]> misses(new (std::nothrow) uint32_t[count]);
+        if (!stamps || !misses)
+            return;
 
-        memset(fifo.get(), 0xff, sizeof(uint32_t) * cacheSize);
+        memset(stamps.get(), 0, sizeof(uint32_t) * nVerts * count);
+        memset(misses.get(), 0, sizeof(uint32_t) * count);
 
         for (size_t j = 0; j < (nFaces * 3); ++j)
         {
-            if (indices[j] == index_t(-1))
+            index_t v = indices[j];
+            if (v == index_t(-1))
                 continue;
 
-            bool found = false;
+            if (v >= nVerts)
+                return;
 
-            for (size_t ptr = 0; ptr < cacheSize; ++ptr)
+            uint32_t* vstamps = &stamps[size_t(v) * count];
+            for (size_t k = 0; k < count; ++k)
             {
-                if (fifo[ptr] == indices[j])
+                if (!vstamps[k] || size_t(misses[k] - vstamps[k]) >= cacheSizes[k])
                 {
-                    found = true;
-                    break;
+                    vstamps[k] = ++misses[k];
                 }
             }
+        }
 
-            if (!found)
+        for (size_t k = 0; k < count; ++k)
+        {
+            // ideal is 0.5, individual tris have 3.0
+            acmr[k] = float(misses[k]) / float(nFaces);
+
+            // ideal is 1.0, worst case is 6.0
+            atvr[k] = float(misses[k]) / float(nVerts);
+        }
+    }
+
+
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    void ComputeVertexCacheMissRateImpl(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces, size_t nVerts,
+        size_t cacheSize, VCACHE_MODEL model, float& acmr, float& atvr)
+    {
+        if (model == VCACHE_MODEL_FIFO)
+        {
+            ComputeVertexCacheMissRateImpl<index_t>(indices, nFaces, nVerts, &cacheSize, 1, &acmr, &atvr);
+            return;
+        }
+
+        acmr = -1.f;
+        atvr = -1.f;
+
+        if (!indices || !nFaces || !nVerts || !cacheSize || cacheSize >= UINT32_MAX)
+            return;
+
+        if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+            return;
+
+        if (nVerts >= index_t(-1))
+            return;
+
+        vcache_sim vcache;
+        if (FAILED(vcache.initialize(nVerts, nFaces * 3, uint32_t(cacheSize), model)))
+            return;
+
+        uint32_t misses = 0;
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            uint32_t i[3];
+            for (size_t point = 0; point < 3; ++point)
             {
-                ++misses;
-                fifo[tail] = indices[j];
-                ++tail;
-                if (tail == cacheSize) tail = 0;
+                index_t v = indices[face * 3 + point];
+                if (v == index_t(-1))
+                {
+                    i[point] = UNUSED32;
+                    continue;
+                }
+
+                if (v >= nVerts)
+                    return;
+
+                i[point] = v;
             }
+
+            misses += vcache.access(i[0], i[1], i[2]);
         }
 
-        // ideal is 0.5, individual tris have 3.0
         acmr = float(misses) / float(nFaces);
-
-        // ideal is 1.0, worst case is 6.0
         atvr = float(misses) / float(nVerts);
     }
 }
@@ -503,7 +630,7 @@ void DirectX::ComputeVertexCacheMissRate(
     const uint16_t* indices, size_t nFaces, size_t nVerts, size_t cacheSize,
     float& acmr, float& atvr)
 {
-    ComputeVertexCacheMissRateImpl<uint16_t>(indices, nFaces, nVerts, cacheSize, acmr, atvr);
+    ComputeVertexCacheMissRateImpl<uint16_t>(indices, nFaces, nVerts, &cacheSize, 1, &acmr, &atvr);
 }
 
 _Use_decl_annotations_
@@ -511,5 +638,41 @@ void DirectX::ComputeVertexCacheMissRate(
     const uint32_t* indices, size_t nFaces, size_t nVerts, size_t cacheSize,
     float& acmr, float& atvr)
 {
-    ComputeVertexCacheMissRateImpl<uint32_t>(indices, nFaces, nVerts, cacheSize, acmr, atvr);
+    ComputeVertexCacheMissRateImpl<uint32_t>(indices, nFaces, nVerts, &cacheSize, 1, &acmr, &atvr);
+}
+
+_Use_decl_annotations_
+void DirectX::ComputeVertexCacheMissRate(
+    const uint16_t* indices, size_t nFaces, size_t nVerts,
+    const size_t* cacheSizes, size_t count,
+    float* acmr, float* atvr)
+{
+    ComputeVertexCacheMissRateImpl<uint16_t>(indices, nFaces, nVerts, cacheSizes, count, acmr, atvr);
+}
+
+_Use_decl_annotations_
+void DirectX::ComputeVertexCacheMissRate(
+    const uint32_t* indices, size_t nFaces, size_t nVerts,
+    const size_t* cacheSizes, size_t count,
+    float* acmr, float* atvr)
+{
+    ComputeVertexCacheMissRateImpl<uint32_t>(indices, nFaces, nVerts, cacheSizes, count, acmr, atvr);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+void DirectX::ComputeVertexCacheMissRate(
+    const uint16_t* indices, size_t nFaces, size_t nVerts, size_t cacheSize,
+    VCACHE_MODEL model, float& acmr, float& atvr)
+{
+    ComputeVertexCacheMissRateImpl<uint16_t>(indices, nFaces, nVerts, cacheSize, model, acmr, atvr);
+}
+
+_Use_decl_annotations_
+void DirectX::ComputeVertexCacheMissRate(
+    const uint32_t* indices, size_t nFaces, size_t nVerts, size_t cacheSize,
+    VCACHE_MODEL model, float& acmr, float& atvr)
+{
+    ComputeVertexCacheMissRateImpl<uint32_t>(indices, nFaces, nVerts, cacheSize, model, acmr, atvr);
 }
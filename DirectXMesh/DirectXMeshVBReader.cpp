@@ -18,6 +18,7 @@ namespace
 {
     const size_t c_MaxSlot = 32;
     const size_t c_MaxStride = 2048;
+    const size_t c_ParallelBlock = 16384;
 
     enum INPUT_CLASSIFICATION
     {
@@ -51,6 +52,821 @@ namespace
     static_assert(c_MaxSlot == D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT, "D3D12 mismatch");
     static_assert(c_MaxStride == D3D12_REQ_MULTI_ELEMENT_STRUCTURE_SIZE_IN_BYTES, "D3D12 mismatch");
 #endif
+
+    //---------------------------------------------------------------------------------
+    // Element loaders, one per vertex format
+    //---------------------------------------------------------------------------------
+
+#define ELEMENT_LOADER( name, type, func )\
+    inline XMVECTOR XM_CALLCONV name(_In_ const uint8_t* ptr, bool)\
+    {\
+        return func(reinterpret_cast<const type*>(ptr));\
+    }
+
+#define ELEMENT_LOADER_X2( name, type, func, select )\
+    inline XMVECTOR XM_CALLCONV name(_In_ const uint8_t* ptr, bool x2bias)\
+    {\
+        XMVECTOR v = func(reinterpret_cast<const type*>(ptr));\
+        if (x2bias)\
+        {\
+            XMVECTOR v2 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);\
+            v = XMVectorSelect(v, v2, select);\
+        }\
+        return v;\
+    }
+
+    ELEMENT_LOADER(LoadR32G32B32A32_UINT, XMUINT4, XMLoadUInt4)
+    ELEMENT_LOADER(LoadR32G32B32A32_SINT, XMINT4, XMLoadSInt4)
+    ELEMENT_LOADER(LoadR32G32B32_UINT, XMUINT3, XMLoadUInt3)
+    ELEMENT_LOADER(LoadR32G32B32_SINT, XMINT3, XMLoadSInt3)
+    ELEMENT_LOADER(LoadR16G16B16A16_FLOAT, XMHALF4, XMLoadHalf4)
+    ELEMENT_LOADER_X2(LoadR16G16B16A16_UNORM, XMUSHORTN4, XMLoadUShortN4, g_XMSelect1111)
+    ELEMENT_LOADER(LoadR16G16B16A16_UINT, XMUSHORT4, XMLoadUShort4)
+    ELEMENT_LOADER(LoadR16G16B16A16_SNORM, XMSHORTN4, XMLoadShortN4)
+    ELEMENT_LOADER(LoadR16G16B16A16_SINT, XMSHORT4, XMLoadShort4)
+    ELEMENT_LOADER(LoadR32G32_UINT, XMUINT2, XMLoadUInt2)
+    ELEMENT_LOADER(LoadR32G32_SINT, XMINT2, XMLoadSInt2)
+    ELEMENT_LOADER_X2(LoadR10G10B10A2_UNORM, XMUDECN4, XMLoadUDecN4, g_XMSelect1110)
+    ELEMENT_LOADER(LoadR10G10B10A2_UINT, XMUDEC4, XMLoadUDec4)
+    ELEMENT_LOADER_X2(LoadR11G11B10_FLOAT, XMFLOAT3PK, XMLoadFloat3PK, g_XMSelect1110)
+    ELEMENT_LOADER_X2(LoadR8G8B8A8_UNORM, XMUBYTEN4, XMLoadUByteN4, g_XMSelect1111)
+    ELEMENT_LOADER(LoadR8G8B8A8_UINT, XMUBYTE4, XMLoadUByte4)
+    ELEMENT_LOADER(LoadR8G8B8A8_SNORM, XMBYTEN4, XMLoadByteN4)
+    ELEMENT_LOADER(LoadR8G8B8A8_SINT, XMBYTE4, XMLoadByte4)
+    ELEMENT_LOADER(LoadR16G16_FLOAT, XMHALF2, XMLoadHalf2)
+    ELEMENT_LOADER_X2(LoadR16G16_UNORM, XMUSHORTN2, XMLoadUShortN2, g_XMSelect1100)
+    ELEMENT_LOADER(LoadR16G16_UINT, XMUSHORT2, XMLoadUShort2)
+    ELEMENT_LOADER(LoadR16G16_SNORM, XMSHORTN2, XMLoadShortN2)
+    ELEMENT_LOADER(LoadR16G16_SINT, XMSHORT2, XMLoadShort2)
+    ELEMENT_LOADER_X2(LoadR8G8_UNORM, XMUBYTEN2, XMLoadUByteN2, g_XMSelect1100)
+    ELEMENT_LOADER(LoadR8G8_UINT, XMUBYTE2, XMLoadUByte2)
+    ELEMENT_LOADER(LoadR8G8_SNORM, XMBYTEN2, XMLoadByteN2)
+    ELEMENT_LOADER(LoadR8G8_SINT, XMBYTE2, XMLoadByte2)
+    ELEMENT_LOADER(LoadR10G10B10_SNORM_A2_UNORM, XMXDECN4, XMLoadXDecN4)
+
+    inline XMVECTOR XM_CALLCONV LoadR32_UINT(_In_ const uint8_t* ptr, bool)
+    {
+        XMVECTOR v = XMLoadInt(reinterpret_cast<const uint32_t*>(ptr));
+        return XMConvertVectorUIntToFloat(v, 0);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadR32_SINT(_In_ const uint8_t* ptr, bool)
+    {
+        XMVECTOR v = XMLoadInt(reinterpret_cast<const uint32_t*>(ptr));
+        return XMConvertVectorIntToFloat(v, 0);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadR16_FLOAT(_In_ const uint8_t* ptr, bool)
+    {
+        float v = XMConvertHalfToFloat(*reinterpret_cast<const HALF*>(ptr));
+        return XMVectorSet(v, 0.f, 0.f, 0.f);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadR16_UNORM(_In_ const uint8_t* ptr, bool x2bias)
+    {
+        auto i = *reinterpret_cast<const uint16_t*>(ptr);
+        float f = static_cast<float>(i) / 65535.f;
+        if (x2bias)
+        {
+            f = f*2.f - 1.f;
+        }
+        return XMVectorSet(f, 0.f, 0.f, 0.f);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadR16_UINT(_In_ const uint8_t* ptr, bool)
+    {
+        auto i = *reinterpret_cast<const uint16_t*>(ptr);
+        return XMVectorSet(static_cast<float>(i), 0.f, 0.f, 0.f);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadR16_SNORM(_In_ const uint8_t* ptr, bool)
+    {
+        auto i = *reinterpret_cast<const int16_t*>(ptr);
+        return XMVectorSet(static_cast<float>(i) / 32767.f, 0.f, 0.f, 0.f);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadR16_SINT(_In_ const uint8_t* ptr, bool)
+    {
+        auto i = *reinterpret_cast<const int16_t*>(ptr);
+        return XMVectorSet(static_cast<float>(i), 0.f, 0.f, 0.f);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadR8_UNORM(_In_ const uint8_t* ptr, bool x2bias)
+    {
+        const uint8_t i = *ptr;
+        float f = static_cast<float>(i) / 255.f;
+        if (x2bias)
+        {
+            f = f*2.f - 1.f;
+        }
+        return XMVectorSet(f, 0.f, 0.f, 0.f);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadR8_UINT(_In_ const uint8_t* ptr, bool)
+    {
+        const uint8_t i = *ptr;
+        return XMVectorSet(static_cast<float>(i), 0.f, 0.f, 0.f);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadR8_SNORM(_In_ const uint8_t* ptr, bool)
+    {
+        auto i = *reinterpret_cast<const int8_t*>(ptr);
+        return XMVectorSet(static_cast<float>(i) / 127.f, 0.f, 0.f, 0.f);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadR8_SINT(_In_ const uint8_t* ptr, bool)
+    {
+        auto i = *reinterpret_cast<const int8_t*>(ptr);
+        return XMVectorSet(static_cast<float>(i), 0.f, 0.f, 0.f);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadB5G6R5_UNORM(_In_ const uint8_t* ptr, bool x2bias)
+    {
+        static const XMVECTORF32 s_Scale = { { { 1.f / 31.f, 1.f / 63.f, 1.f / 31.f, 1.f } } };
+        XMVECTOR v = XMLoadU565(reinterpret_cast<const XMU565*>(ptr));
+        v = XMVectorMultiply(v, s_Scale);
+        if (x2bias)
+        {
+            XMVECTOR v2 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
+            v = XMVectorSelect(v, v2, g_XMSelect1110);
+        }
+        return XMVectorSwizzle<2, 1, 0, 3>(v);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadB5G5R5A1_UNORM(_In_ const uint8_t* ptr, bool x2bias)
+    {
+        static const XMVECTORF32 s_Scale = { { { 1.f / 31.f, 1.f / 31.f, 1.f / 31.f, 1.f } } };
+        XMVECTOR v = XMLoadU555(reinterpret_cast<const XMU555*>(ptr));
+        v = XMVectorMultiply(v, s_Scale);
+        if (x2bias)
+        {
+            XMVECTOR v2 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
+            v = XMVectorSelect(v, v2, g_XMSelect1110);
+        }
+        return XMVectorSwizzle<2, 1, 0, 3>(v);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadB8G8R8A8_UNORM(_In_ const uint8_t* ptr, bool x2bias)
+    {
+        XMVECTOR v = XMLoadUByteN4(reinterpret_cast<const XMUBYTEN4*>(ptr));
+        if (x2bias)
+        {
+            v = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
+        }
+        return XMVectorSwizzle<2, 1, 0, 3>(v);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadB8G8R8X8_UNORM(_In_ const uint8_t* ptr, bool x2bias)
+    {
+        XMVECTOR v = XMLoadUByteN4(reinterpret_cast<const XMUBYTEN4*>(ptr));
+        if (x2bias)
+        {
+            XMVECTOR v2 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
+            v = XMVectorSelect(v, v2, g_XMSelect1110);
+        }
+        v = XMVectorSwizzle<2, 1, 0, 3>(v);
+        return XMVectorSelect(g_XMZero, v, g_XMSelect1110);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadB4G4R4A4_UNORM(_In_ const uint8_t* ptr, bool x2bias)
+    {
+        static const XMVECTORF32 s_Scale = { { { 1.f / 15.f, 1.f / 15.f, 1.f / 15.f, 1.f / 15.f } } };
+        XMVECTOR v = XMLoadUNibble4(reinterpret_cast<const XMUNIBBLE4*>(ptr));
+        v = XMVectorMultiply(v, s_Scale);
+        if (x2bias)
+        {
+            v = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
+        }
+        return XMVectorSwizzle<2, 1, 0, 3>(v);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadOctahedralNormal8(_In_ const uint8_t* ptr, bool)
+    {
+        return OctahedralDecode(XMLoadByteN2(reinterpret_cast<const XMBYTEN2*>(ptr)));
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadOctahedralNormal16(_In_ const uint8_t* ptr, bool)
+    {
+        return OctahedralDecode(XMLoadShortN2(reinterpret_cast<const XMSHORTN2*>(ptr)));
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadOctahedralTangent8(_In_ const uint8_t* ptr, bool)
+    {
+        XMVECTOR v = XMLoadByteN4(reinterpret_cast<const XMBYTEN4*>(ptr));
+        XMVECTOR sign = (XMVectorGetW(v) < 0.f) ? g_XMNegativeOne : g_XMOne;
+        return XMVectorSelect(sign, OctahedralDecode(v), g_XMSelect1110);
+    }
+
+    inline XMVECTOR XM_CALLCONV LoadOctahedralTangent16(_In_ const uint8_t* ptr, bool)
+    {
+        XMVECTOR v = XMLoadShortN4(reinterpret_cast<const XMSHORTN4*>(ptr));
+        XMVECTOR sign = (XMVectorGetW(v) < 0.f) ? g_XMNegativeOne : g_XMOne;
+        return XMVectorSelect(sign, OctahedralDecode(v), g_XMSelect1110);
+    }
+
+#undef ELEMENT_LOADER
+#undef ELEMENT_LOADER_X2
+
+
+    //---------------------------------------------------------------------------------
+    // Decoders, specialized for each format and destination type
+    //---------------------------------------------------------------------------------
+
+    // Stores a decoded element to each supported destination type
+    inline void StoreVertex(_Out_ XMVECTOR* dest, FXMVECTOR v) { *dest = v; }
+    inline void StoreVertex(_Out_ float* dest, FXMVECTOR v) { XMStoreFloat(dest, v); }
+    inline void StoreVertex(_Out_ XMFLOAT2* dest, FXMVECTOR v) { XMStoreFloat2(dest, v); }
+    inline void StoreVertex(_Out_ XMFLOAT3* dest, FXMVECTOR v) { XMStoreFloat3(dest, v); }
+    inline void StoreVertex(_Out_ XMFLOAT4* dest, FXMVECTOR v) { XMStoreFloat4(dest, v); }
+
+    template<size_t size, XMVECTOR(XM_CALLCONV *load)(const uint8_t*, bool), class T>
+    HRESULT DecodeElements(
+        _Out_writes_(count) T* buffer,
+        _In_ const uint8_t* ptr, _In_ const uint8_t* eptr, size_t stride,
+        size_t count, bool x2bias)
+    {
+        for (size_t icount = 0; icount < count; ++icount)
+        {
+            if ((ptr + size) > eptr)
+                return E_UNEXPECTED;
+            StoreVertex(buffer++, load(ptr, x2bias));
+            ptr += stride;
+        }
+
+        return S_OK;
+    }
+
+    // Copies float components straight to the destination, zero filling as the XMLoadFloat* functions do
+    template<size_t n, class T>
+    HRESULT DecodeFloats(
+        _Out_writes_(count) T* buffer,
+        _In_ const uint8_t* ptr, _In_ const uint8_t* eptr, size_t stride,
+        size_t count, bool)
+    {
+        static_assert(sizeof(T) <= sizeof(float) * 4, "Destination too large");
+
+        for (size_t icount = 0; icount < count; ++icount)
+        {
+            if ((ptr + sizeof(float) * n) > eptr)
+                return E_UNEXPECTED;
+            float v[4] = {};
+            memcpy(v, ptr, sizeof(float) * n);
+            memcpy(buffer++, v, sizeof(T));
+            ptr += stride;
+        }
+
+        return S_OK;
+    }
+
+    // Quantized positions take the element's transform, so they are not in the decoder tables
+    template<class T>
+    HRESULT XM_CALLCONV DecodeQuantized(
+        _Out_writes_(count) T* buffer,
+        _In_ const uint8_t* ptr, _In_ const uint8_t* eptr, size_t stride,
+        size_t count, FXMVECTOR scale, FXMVECTOR bias)
+    {
+        for (size_t icount = 0; icount < count; ++icount)
+        {
+            if ((ptr + sizeof(XMUSHORTN4)) > eptr)
+                return E_UNEXPECTED;
+            XMVECTOR v = XMLoadUShortN4(reinterpret_cast<const XMUSHORTN4*>(ptr));
+            StoreVertex(buffer++, XMVectorMultiplyAdd(v, scale, bias));
+            ptr += stride;
+        }
+
+        return S_OK;
+    }
+
+    template<class T>
+    using DecodeFunc = HRESULT(*)(T* buffer, const uint8_t* ptr, const uint8_t* eptr, size_t stride, size_t count, bool x2bias);
+
+    struct FormatDecoders
+    {
+        DXGI_FORMAT             format;
+        DecodeFunc<XMVECTOR>    vector;
+        DecodeFunc<float>       float1;
+        DecodeFunc<XMFLOAT2>    float2;
+        DecodeFunc<XMFLOAT3>    float3;
+        DecodeFunc<XMFLOAT4>    float4;
+    };
+
+#define DECODERS( format, type, load )\
+    { format,\
+      DecodeElements<sizeof(type), load, XMVECTOR>,\
+      DecodeElements<sizeof(type), load, float>,\
+      DecodeElements<sizeof(type), load, XMFLOAT2>,\
+      DecodeElements<sizeof(type), load, XMFLOAT3>,\
+      DecodeElements<sizeof(type), load, XMFLOAT4> }
+
+#define FLOAT_DECODERS( format, n )\
+    { format,\
+      DecodeFloats<n, XMVECTOR>,\
+      DecodeFloats<n, float>,\
+      DecodeFloats<n, XMFLOAT2>,\
+      DecodeFloats<n, XMFLOAT3>,\
+      DecodeFloats<n, XMFLOAT4> }
+
+    const FormatDecoders g_Decoders[] =
+    {
+        FLOAT_DECODERS(DXGI_FORMAT_R32G32B32A32_FLOAT, 4),
+        DECODERS(DXGI_FORMAT_R32G32B32A32_UINT, XMUINT4, LoadR32G32B32A32_UINT),
+        DECODERS(DXGI_FORMAT_R32G32B32A32_SINT, XMINT4, LoadR32G32B32A32_SINT),
+        FLOAT_DECODERS(DXGI_FORMAT_R32G32B32_FLOAT, 3),
+        DECODERS(DXGI_FORMAT_R32G32B32_UINT, XMUINT3, LoadR32G32B32_UINT),
+        DECODERS(DXGI_FORMAT_R32G32B32_SINT, XMINT3, LoadR32G32B32_SINT),
+        DECODERS(DXGI_FORMAT_R16G16B16A16_FLOAT, XMHALF4, LoadR16G16B16A16_FLOAT),
+        DECODERS(DXGI_FORMAT_R16G16B16A16_UNORM, XMUSHORTN4, LoadR16G16B16A16_UNORM),
+        DECODERS(DXGI_FORMAT_R16G16B16A16_UINT, XMUSHORT4, LoadR16G16B16A16_UINT),
+        DECODERS(DXGI_FORMAT_R16G16B16A16_SNORM, XMSHORTN4, LoadR16G16B16A16_SNORM),
+        DECODERS(DXGI_FORMAT_R16G16B16A16_SINT, XMSHORT4, LoadR16G16B16A16_SINT),
+        FLOAT_DECODERS(DXGI_FORMAT_R32G32_FLOAT, 2),
+        DECODERS(DXGI_FORMAT_R32G32_UINT, XMUINT2, LoadR32G32_UINT),
+        DECODERS(DXGI_FORMAT_R32G32_SINT, XMINT2, LoadR32G32_SINT),
+        DECODERS(DXGI_FORMAT_R10G10B10A2_UNORM, XMUDECN4, LoadR10G10B10A2_UNORM),
+        DECODERS(DXGI_FORMAT_R10G10B10A2_UINT, XMUDEC4, LoadR10G10B10A2_UINT),
+        DECODERS(DXGI_FORMAT_R11G11B10_FLOAT, XMFLOAT3PK, LoadR11G11B10_FLOAT),
+        DECODERS(DXGI_FORMAT_R8G8B8A8_UNORM, XMUBYTEN4, LoadR8G8B8A8_UNORM),
+        DECODERS(DXGI_FORMAT_R8G8B8A8_UINT, XMUBYTE4, LoadR8G8B8A8_UINT),
+        DECODERS(DXGI_FORMAT_R8G8B8A8_SNORM, XMBYTEN4, LoadR8G8B8A8_SNORM),
+        DECODERS(DXGI_FORMAT_R8G8B8A8_SINT, XMBYTE4, LoadR8G8B8A8_SINT),
+        DECODERS(DXGI_FORMAT_R16G16_FLOAT, XMHALF2, LoadR16G16_FLOAT),
+        DECODERS(DXGI_FORMAT_R16G16_UNORM, XMUSHORTN2, LoadR16G16_UNORM),
+        DECODERS(DXGI_FORMAT_R16G16_UINT, XMUSHORT2, LoadR16G16_UINT),
+        DECODERS(DXGI_FORMAT_R16G16_SNORM, XMSHORTN2, LoadR16G16_SNORM),
+        DECODERS(DXGI_FORMAT_R16G16_SINT, XMSHORT2, LoadR16G16_SINT),
+        FLOAT_DECODERS(DXGI_FORMAT_R32_FLOAT, 1),
+        DECODERS(DXGI_FORMAT_R32_UINT, uint32_t, LoadR32_UINT),
+        DECODERS(DXGI_FORMAT_R32_SINT, int32_t, LoadR32_SINT),
+        DECODERS(DXGI_FORMAT_R8G8_UNORM, XMUBYTEN2, LoadR8G8_UNORM),
+        DECODERS(DXGI_FORMAT_R8G8_UINT, XMUBYTE2, LoadR8G8_UINT),
+        DECODERS(DXGI_FORMAT_R8G8_SNORM, XMBYTEN2, LoadR8G8_SNORM),
+        DECODERS(DXGI_FORMAT_R8G8_SINT, XMBYTE2, LoadR8G8_SINT),
+        DECODERS(DXGI_FORMAT_R16_FLOAT, HALF, LoadR16_FLOAT),
+        DECODERS(DXGI_FORMAT_R16_UNORM, uint16_t, LoadR16_UNORM),
+        DECODERS(DXGI_FORMAT_R16_UINT, uint16_t, LoadR16_UINT),
+        DECODERS(DXGI_FORMAT_R16_SNORM, int16_t, LoadR16_SNORM),
+        DECODERS(DXGI_FORMAT_R16_SINT, int16_t, LoadR16_SINT),
+        DECODERS(DXGI_FORMAT_R8_UNORM, uint8_t, LoadR8_UNORM),
+        DECODERS(DXGI_FORMAT_R8_UINT, uint8_t, LoadR8_UINT),
+        DECODERS(DXGI_FORMAT_R8_SNORM, int8_t, LoadR8_SNORM),
+        DECODERS(DXGI_FORMAT_R8_SINT, int8_t, LoadR8_SINT),
+        DECODERS(DXGI_FORMAT_B5G6R5_UNORM, XMU565, LoadB5G6R5_UNORM),
+        DECODERS(DXGI_FORMAT_B5G5R5A1_UNORM, XMU555, LoadB5G5R5A1_UNORM),
+        DECODERS(DXGI_FORMAT_B8G8R8A8_UNORM, XMUBYTEN4, LoadB8G8R8A8_UNORM),
+        DECODERS(DXGI_FORMAT_B8G8R8X8_UNORM, XMUBYTEN4, LoadB8G8R8X8_UNORM),
+        DECODERS(DXGI_FORMAT_B4G4R4A4_UNORM, XMUNIBBLE4, LoadB4G4R4A4_UNORM),
+
+        // Xbox One specific format
+        DECODERS(XBOX_DXGI_FORMAT_R10G10B10_SNORM_A2_UNORM, XMXDECN4, LoadR10G10B10_SNORM_A2_UNORM),
+
+        // Virtual formats
+        DECODERS(VBFORMAT_OCTAHEDRAL_NORMAL_8, XMBYTEN2, LoadOctahedralNormal8),
+        DECODERS(VBFORMAT_OCTAHEDRAL_NORMAL_16, XMSHORTN2, LoadOctahedralNormal16),
+        DECODERS(VBFORMAT_OCTAHEDRAL_TANGENT_8, XMBYTEN4, LoadOctahedralTangent8),
+        DECODERS(VBFORMAT_OCTAHEDRAL_TANGENT_16, XMSHORTN4, LoadOctahedralTangent16),
+        DECODERS(VBFORMAT_QUANTIZED_POSITION_16, XMUSHORTN4, LoadR16G16B16A16_UNORM),
+    };
+
+#undef DECODERS
+#undef FLOAT_DECODERS
+
+#ifdef _XM_SSE_INTRINSICS_
+    //---------------------------------------------------------------------------------
+    // AVX2 + F16C batch decoders, converting 8 elements per iteration
+    //---------------------------------------------------------------------------------
+
+    const size_t c_Batch = 8;
+
+    // Describes a format whose element is one or two dwords of packed integer fields.
+    // Each component is decoded exactly as the DirectXMath load does it, that is the
+    // integer field converted to float, times the reciprocal scale, then clamped.
+    struct PackedLayout
+    {
+        int32_t     dword[4];       // Source dword of each component
+        int32_t     shiftLeft[4];   // Moves the top bit of the field to bit 31 (32 clears the component)
+        int32_t     shiftRight[4];  // Moves the field back down to bit 0
+        uint32_t    sign[4];        // Components that are sign extended
+        float       scale[4];
+        float       minimum[4];
+        uint32_t    x2bias[4];      // Components remapped to [-1,1] by x2bias
+        uint32_t    mask[4];        // Components kept, the others are zero
+        bool        bgr;            // Swizzle B,G,R,A to R,G,B,A
+    };
+
+    const uint32_t c_On = 0xFFFFFFFF;
+    const float c_NoMin = -FLT_MAX;
+
+    const float c_UNorm16 = 1.f / 65535.f;
+    const float c_SNorm16 = 1.f / 32767.f;
+    const float c_UNorm10 = 1.f / 1023.f;
+    const float c_SNorm10 = 1.f / 511.f;
+    const float c_UNorm8 = 1.f / 255.f;
+    const float c_SNorm8 = 1.f / 127.f;
+    const float c_UNorm5 = 1.f / 31.f;
+    const float c_UNorm4 = 1.f / 15.f;
+
+    const PackedLayout s_R16G16B16A16_UNORM =
+    {
+        { 0, 0, 1, 1 }, { 16, 0, 16, 0 }, { 16, 16, 16, 16 }, {},
+        { c_UNorm16, c_UNorm16, c_UNorm16, c_UNorm16 }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        { c_On, c_On, c_On, c_On }, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R16G16B16A16_UINT =
+    {
+        { 0, 0, 1, 1 }, { 16, 0, 16, 0 }, { 16, 16, 16, 16 }, {},
+        { 1.f, 1.f, 1.f, 1.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R16G16B16A16_SNORM =
+    {
+        { 0, 0, 1, 1 }, { 16, 0, 16, 0 }, { 16, 16, 16, 16 }, { c_On, c_On, c_On, c_On },
+        { c_SNorm16, c_SNorm16, c_SNorm16, c_SNorm16 }, { -1.f, -1.f, -1.f, -1.f },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R16G16B16A16_SINT =
+    {
+        { 0, 0, 1, 1 }, { 16, 0, 16, 0 }, { 16, 16, 16, 16 }, { c_On, c_On, c_On, c_On },
+        { 1.f, 1.f, 1.f, 1.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R10G10B10A2_UNORM =
+    {
+        {}, { 22, 12, 2, 0 }, { 22, 22, 22, 30 }, {},
+        { c_UNorm10, c_UNorm10, c_UNorm10, 1.f / 3.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        { c_On, c_On, c_On, 0 }, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R10G10B10A2_UINT =
+    {
+        {}, { 22, 12, 2, 0 }, { 22, 22, 22, 30 }, {},
+        { 1.f, 1.f, 1.f, 1.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R8G8B8A8_UNORM =
+    {
+        {}, { 24, 16, 8, 0 }, { 24, 24, 24, 24 }, {},
+        { c_UNorm8, c_UNorm8, c_UNorm8, c_UNorm8 }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        { c_On, c_On, c_On, c_On }, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R8G8B8A8_UINT =
+    {
+        {}, { 24, 16, 8, 0 }, { 24, 24, 24, 24 }, {},
+        { 1.f, 1.f, 1.f, 1.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R8G8B8A8_SNORM =
+    {
+        {}, { 24, 16, 8, 0 }, { 24, 24, 24, 24 }, { c_On, c_On, c_On, c_On },
+        { c_SNorm8, c_SNorm8, c_SNorm8, c_SNorm8 }, { -1.f, -1.f, -1.f, -1.f },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R8G8B8A8_SINT =
+    {
+        {}, { 24, 16, 8, 0 }, { 24, 24, 24, 24 }, { c_On, c_On, c_On, c_On },
+        { 1.f, 1.f, 1.f, 1.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R16G16_UNORM =
+    {
+        {}, { 16, 0, 32, 32 }, { 16, 16, 16, 16 }, {},
+        { c_UNorm16, c_UNorm16, 0.f, 0.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        { c_On, c_On, 0, 0 }, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R16G16_UINT =
+    {
+        {}, { 16, 0, 32, 32 }, { 16, 16, 16, 16 }, {},
+        { 1.f, 1.f, 0.f, 0.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R16G16_SNORM =
+    {
+        {}, { 16, 0, 32, 32 }, { 16, 16, 16, 16 }, { c_On, c_On, c_On, c_On },
+        { c_SNorm16, c_SNorm16, 0.f, 0.f }, { -1.f, -1.f, -1.f, -1.f },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R16G16_SINT =
+    {
+        {}, { 16, 0, 32, 32 }, { 16, 16, 16, 16 }, { c_On, c_On, c_On, c_On },
+        { 1.f, 1.f, 0.f, 0.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R8G8_UNORM =
+    {
+        {}, { 24, 16, 32, 32 }, { 24, 24, 24, 24 }, {},
+        { c_UNorm8, c_UNorm8, 0.f, 0.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        { c_On, c_On, 0, 0 }, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R8G8_UINT =
+    {
+        {}, { 24, 16, 32, 32 }, { 24, 24, 24, 24 }, {},
+        { 1.f, 1.f, 0.f, 0.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R8G8_SNORM =
+    {
+        {}, { 24, 16, 32, 32 }, { 24, 24, 24, 24 }, { c_On, c_On, c_On, c_On },
+        { c_SNorm8, c_SNorm8, 0.f, 0.f }, { -1.f, -1.f, -1.f, -1.f },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_R8G8_SINT =
+    {
+        {}, { 24, 16, 32, 32 }, { 24, 24, 24, 24 }, { c_On, c_On, c_On, c_On },
+        { 1.f, 1.f, 0.f, 0.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    const PackedLayout s_B5G6R5_UNORM =
+    {
+        {}, { 27, 21, 16, 32 }, { 27, 26, 27, 32 }, {},
+        { c_UNorm5, 1.f / 63.f, c_UNorm5, 1.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        { c_On, c_On, c_On, 0 }, { c_On, c_On, c_On, c_On }, true
+    };
+
+    const PackedLayout s_B5G5R5A1_UNORM =
+    {
+        {}, { 27, 22, 17, 16 }, { 27, 27, 27, 31 }, {},
+        { c_UNorm5, c_UNorm5, c_UNorm5, 1.f }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        { c_On, c_On, c_On, 0 }, { c_On, c_On, c_On, c_On }, true
+    };
+
+    const PackedLayout s_B8G8R8A8_UNORM =
+    {
+        {}, { 24, 16, 8, 0 }, { 24, 24, 24, 24 }, {},
+        { c_UNorm8, c_UNorm8, c_UNorm8, c_UNorm8 }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        { c_On, c_On, c_On, c_On }, { c_On, c_On, c_On, c_On }, true
+    };
+
+    const PackedLayout s_B8G8R8X8_UNORM =
+    {
+        {}, { 24, 16, 8, 0 }, { 24, 24, 24, 24 }, {},
+        { c_UNorm8, c_UNorm8, c_UNorm8, c_UNorm8 }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        { c_On, c_On, c_On, 0 }, { c_On, c_On, c_On, 0 }, true
+    };
+
+    const PackedLayout s_B4G4R4A4_UNORM =
+    {
+        {}, { 28, 24, 20, 16 }, { 28, 28, 28, 28 }, {},
+        { c_UNorm4, c_UNorm4, c_UNorm4, c_UNorm4 }, { c_NoMin, c_NoMin, c_NoMin, c_NoMin },
+        { c_On, c_On, c_On, c_On }, { c_On, c_On, c_On, c_On }, true
+    };
+
+    const PackedLayout s_R10G10B10_SNORM_A2_UNORM =
+    {
+        {}, { 22, 12, 2, 0 }, { 22, 22, 22, 30 }, { c_On, c_On, c_On, 0 },
+        { c_SNorm10, c_SNorm10, c_SNorm10, 1.f / 3.f }, { -1.f, -1.f, -1.f, -1.f },
+        {}, { c_On, c_On, c_On, c_On }, false
+    };
+
+    // Only VEX encoded instructions are used while the upper halves of the YMM registers are live,
+    // and each batch ends with vzeroupper so the SSE code that stores the results pays no transition
+    inline __m256i BroadcastLanes(_In_reads_(4) const void* lanes)
+    {
+        return _mm256_castps_si256(_mm256_broadcast_ps(static_cast<const __m128*>(lanes)));
+    }
+
+    inline __m256i GatherOffsets(size_t stride)
+    {
+        return _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(stride)));
+    }
+
+    // Decodes a batch, held as pairs of elements with the source dwords of each in one 128-bit lane
+    template<const PackedLayout& layout>
+    void ConvertPacked(_Out_writes_(c_Batch) XMVECTOR* out, _In_reads_(c_Batch / 2) const __m256i* pairs, bool x2bias)
+    {
+        const __m256i shiftLeft = BroadcastLanes(layout.shiftLeft);
+        const __m256i shiftRight = BroadcastLanes(layout.shiftRight);
+        const __m256i sign = BroadcastLanes(layout.sign);
+
+        // Unsigned fields need only one shift down to bit 0 and a mask of the field width
+        const __m256i offset = _mm256_sub_epi32(shiftRight, shiftLeft);
+        const __m256i bits = _mm256_srlv_epi32(_mm256_set1_epi32(-1), shiftRight);
+
+        const bool allSigned = (layout.sign[0] & layout.sign[1] & layout.sign[2] & layout.sign[3]) != 0;
+        const bool anySigned = (layout.sign[0] | layout.sign[1] | layout.sign[2] | layout.sign[3]) != 0;
+        const __m256 scale = _mm256_castsi256_ps(BroadcastLanes(layout.scale));
+        const __m256 minimum = _mm256_castsi256_ps(BroadcastLanes(layout.minimum));
+        const __m256 x2mask = _mm256_castsi256_ps(BroadcastLanes(layout.x2bias));
+        const __m256 mask = _mm256_castsi256_ps(BroadcastLanes(layout.mask));
+
+        for (size_t j = 0; j < c_Batch / 2; ++j)
+        {
+            __m256i v;
+            if (allSigned)
+            {
+                v = _mm256_srav_epi32(_mm256_sllv_epi32(pairs[j], shiftLeft), shiftRight);
+            }
+            else if (anySigned)
+            {
+                __m256i u = _mm256_and_si256(_mm256_srlv_epi32(pairs[j], offset), bits);
+                __m256i i = _mm256_srav_epi32(_mm256_sllv_epi32(pairs[j], shiftLeft), shiftRight);
+                v = _mm256_blendv_epi8(u, i, sign);
+            }
+            else
+            {
+                v = _mm256_and_si256(_mm256_srlv_epi32(pairs[j], offset), bits);
+            }
+
+            __m256 f = _mm256_cvtepi32_ps(v);
+            f = _mm256_mul_ps(f, scale);
+            f = _mm256_max_ps(f, minimum);
+
+            if (x2bias)
+            {
+                __m256 f2 = _mm256_add_ps(_mm256_mul_ps(f, _mm256_set1_ps(2.f)), _mm256_set1_ps(-1.f));
+                f = _mm256_blendv_ps(f, f2, x2mask);
+            }
+
+            if (layout.bgr)
+            {
+                f = _mm256_permute_ps(f, _MM_SHUFFLE(3, 0, 1, 2));
+            }
+
+            f = _mm256_and_ps(f, mask);
+
+            _mm256_storeu_ps(reinterpret_cast<float*>(out + j * 2), f);
+        }
+
+        _mm256_zeroupper();
+    }
+
+    // Elements of one dword
+    template<const PackedLayout& layout>
+    void DecodePacked32(_Out_writes_(c_Batch) XMVECTOR* out, _In_ const uint8_t* ptr, size_t stride, bool x2bias)
+    {
+        const __m256i raw = _mm256_i32gather_epi32(reinterpret_cast<const int*>(ptr), GatherOffsets(stride), 1);
+
+        __m256i pairs[c_Batch / 2];
+        pairs[0] = _mm256_permutevar8x32_epi32(raw, _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1));
+        pairs[1] = _mm256_permutevar8x32_epi32(raw, _mm256_setr_epi32(2, 2, 2, 2, 3, 3, 3, 3));
+        pairs[2] = _mm256_permutevar8x32_epi32(raw, _mm256_setr_epi32(4, 4, 4, 4, 5, 5, 5, 5));
+        pairs[3] = _mm256_permutevar8x32_epi32(raw, _mm256_setr_epi32(6, 6, 6, 6, 7, 7, 7, 7));
+
+        ConvertPacked<layout>(out, pairs, x2bias);
+    }
+
+    // Elements of two dwords
+    template<const PackedLayout& layout>
+    void DecodePacked64(_Out_writes_(c_Batch) XMVECTOR* out, _In_ const uint8_t* ptr, size_t stride, bool x2bias)
+    {
+        const __m256i offsets = GatherOffsets(stride);
+        const __m256i lo = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(ptr), _mm256_castsi256_si128(offsets), 1);
+        const __m256i hi = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(ptr), _mm256_extracti128_si256(offsets, 1), 1);
+
+        const __m256i dword = BroadcastLanes(layout.dword);
+
+        __m256i pairs[c_Batch / 2];
+        pairs[0] = _mm256_permutevar8x32_epi32(lo, _mm256_add_epi32(_mm256_setr_epi32(0, 0, 0, 0, 2, 2, 2, 2), dword));
+        pairs[1] = _mm256_permutevar8x32_epi32(lo, _mm256_add_epi32(_mm256_setr_epi32(4, 4, 4, 4, 6, 6, 6, 6), dword));
+        pairs[2] = _mm256_permutevar8x32_epi32(hi, _mm256_add_epi32(_mm256_setr_epi32(0, 0, 0, 0, 2, 2, 2, 2), dword));
+        pairs[3] = _mm256_permutevar8x32_epi32(hi, _mm256_add_epi32(_mm256_setr_epi32(4, 4, 4, 4, 6, 6, 6, 6), dword));
+
+        ConvertPacked<layout>(out, pairs, x2bias);
+    }
+
+    void DecodeHalf2(_Out_writes_(c_Batch) XMVECTOR* out, _In_ const uint8_t* ptr, size_t stride, bool)
+    {
+        const __m256i raw = _mm256_i32gather_epi32(reinterpret_cast<const int*>(ptr), GatherOffsets(stride), 1);
+
+        // Zero extending each dword gives x, y, 0, 0 halfs per element
+        const __m256i lo = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(raw));
+        const __m256i hi = _mm256_cvtepu32_epi64(_mm256_extracti128_si256(raw, 1));
+
+        _mm256_storeu_ps(reinterpret_cast<float*>(out), _mm256_cvtph_ps(_mm256_castsi256_si128(lo)));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + 2), _mm256_cvtph_ps(_mm256_extracti128_si256(lo, 1)));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + 4), _mm256_cvtph_ps(_mm256_castsi256_si128(hi)));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + 6), _mm256_cvtph_ps(_mm256_extracti128_si256(hi, 1)));
+
+        _mm256_zeroupper();
+    }
+
+    void DecodeHalf4(_Out_writes_(c_Batch) XMVECTOR* out, _In_ const uint8_t* ptr, size_t stride, bool)
+    {
+        const __m256i offsets = GatherOffsets(stride);
+
+        const __m256i lo = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(ptr), _mm256_castsi256_si128(offsets), 1);
+        const __m256i hi = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(ptr), _mm256_extracti128_si256(offsets, 1), 1);
+
+        _mm256_storeu_ps(reinterpret_cast<float*>(out), _mm256_cvtph_ps(_mm256_castsi256_si128(lo)));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + 2), _mm256_cvtph_ps(_mm256_extracti128_si256(lo, 1)));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + 4), _mm256_cvtph_ps(_mm256_castsi256_si128(hi)));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + 6), _mm256_cvtph_ps(_mm256_extracti128_si256(hi, 1)));
+
+        _mm256_zeroupper();
+    }
+
+    // Decodes whole batches while the gathers stay inside the buffer, and the rest with the scalar loader.
+    // 'read' is the bytes each gather touches per element, which can be more than the element size.
+    template<size_t size, size_t read, XMVECTOR(XM_CALLCONV *load)(const uint8_t*, bool), void(*batch)(XMVECTOR*, const uint8_t*, size_t, bool), class T>
+    HRESULT DecodeBatched(
+        _Out_writes_(count) T* buffer,
+        _In_ const uint8_t* ptr, _In_ const uint8_t* eptr, size_t stride,
+        size_t count, bool x2bias)
+    {
+        for (; count >= c_Batch; count -= c_Batch)
+        {
+            if ((ptr + stride * (c_Batch - 1) + read) > eptr)
+                break;
+
+            XMVECTOR v[c_Batch];
+            batch(v, ptr, stride, x2bias);
+
+            for (size_t j = 0; j < c_Batch; ++j)
+            {
+                StoreVertex(buffer++, v[j]);
+            }
+
+            ptr += stride * c_Batch;
+        }
+
+        return DecodeElements<size, load>(buffer, ptr, eptr, stride, count, x2bias);
+    }
+
+#define BATCH_DECODERS( format, type, load, read, batch )\
+    { format,\
+      DecodeBatched<sizeof(type), read, load, batch, XMVECTOR>,\
+      DecodeBatched<sizeof(type), read, load, batch, float>,\
+      DecodeBatched<sizeof(type), read, load, batch, XMFLOAT2>,\
+      DecodeBatched<sizeof(type), read, load, batch, XMFLOAT3>,\
+      DecodeBatched<sizeof(type), read, load, batch, XMFLOAT4> }
+
+    const FormatDecoders g_DecodersAVX2[] =
+    {
+        BATCH_DECODERS(DXGI_FORMAT_R16G16B16A16_FLOAT, XMHALF4, LoadR16G16B16A16_FLOAT, 8, DecodeHalf4),
+        BATCH_DECODERS(DXGI_FORMAT_R16G16B16A16_UNORM, XMUSHORTN4, LoadR16G16B16A16_UNORM, 8, DecodePacked64<s_R16G16B16A16_UNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_R16G16B16A16_UINT, XMUSHORT4, LoadR16G16B16A16_UINT, 8, DecodePacked64<s_R16G16B16A16_UINT>),
+        BATCH_DECODERS(DXGI_FORMAT_R16G16B16A16_SNORM, XMSHORTN4, LoadR16G16B16A16_SNORM, 8, DecodePacked64<s_R16G16B16A16_SNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_R16G16B16A16_SINT, XMSHORT4, LoadR16G16B16A16_SINT, 8, DecodePacked64<s_R16G16B16A16_SINT>),
+        BATCH_DECODERS(DXGI_FORMAT_R16G16_FLOAT, XMHALF2, LoadR16G16_FLOAT, 4, DecodeHalf2),
+        BATCH_DECODERS(DXGI_FORMAT_R10G10B10A2_UNORM, XMUDECN4, LoadR10G10B10A2_UNORM, 4, DecodePacked32<s_R10G10B10A2_UNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_R10G10B10A2_UINT, XMUDEC4, LoadR10G10B10A2_UINT, 4, DecodePacked32<s_R10G10B10A2_UINT>),
+        BATCH_DECODERS(DXGI_FORMAT_R8G8B8A8_UNORM, XMUBYTEN4, LoadR8G8B8A8_UNORM, 4, DecodePacked32<s_R8G8B8A8_UNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_R8G8B8A8_UINT, XMUBYTE4, LoadR8G8B8A8_UINT, 4, DecodePacked32<s_R8G8B8A8_UINT>),
+        BATCH_DECODERS(DXGI_FORMAT_R8G8B8A8_SNORM, XMBYTEN4, LoadR8G8B8A8_SNORM, 4, DecodePacked32<s_R8G8B8A8_SNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_R8G8B8A8_SINT, XMBYTE4, LoadR8G8B8A8_SINT, 4, DecodePacked32<s_R8G8B8A8_SINT>),
+        BATCH_DECODERS(DXGI_FORMAT_R16G16_UNORM, XMUSHORTN2, LoadR16G16_UNORM, 4, DecodePacked32<s_R16G16_UNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_R16G16_UINT, XMUSHORT2, LoadR16G16_UINT, 4, DecodePacked32<s_R16G16_UINT>),
+        BATCH_DECODERS(DXGI_FORMAT_R16G16_SNORM, XMSHORTN2, LoadR16G16_SNORM, 4, DecodePacked32<s_R16G16_SNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_R16G16_SINT, XMSHORT2, LoadR16G16_SINT, 4, DecodePacked32<s_R16G16_SINT>),
+        BATCH_DECODERS(DXGI_FORMAT_R8G8_UNORM, XMUBYTEN2, LoadR8G8_UNORM, 4, DecodePacked32<s_R8G8_UNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_R8G8_UINT, XMUBYTE2, LoadR8G8_UINT, 4, DecodePacked32<s_R8G8_UINT>),
+        BATCH_DECODERS(DXGI_FORMAT_R8G8_SNORM, XMBYTEN2, LoadR8G8_SNORM, 4, DecodePacked32<s_R8G8_SNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_R8G8_SINT, XMBYTE2, LoadR8G8_SINT, 4, DecodePacked32<s_R8G8_SINT>),
+        BATCH_DECODERS(DXGI_FORMAT_B5G6R5_UNORM, XMU565, LoadB5G6R5_UNORM, 4, DecodePacked32<s_B5G6R5_UNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_B5G5R5A1_UNORM, XMU555, LoadB5G5R5A1_UNORM, 4, DecodePacked32<s_B5G5R5A1_UNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_B8G8R8A8_UNORM, XMUBYTEN4, LoadB8G8R8A8_UNORM, 4, DecodePacked32<s_B8G8R8A8_UNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_B8G8R8X8_UNORM, XMUBYTEN4, LoadB8G8R8X8_UNORM, 4, DecodePacked32<s_B8G8R8X8_UNORM>),
+        BATCH_DECODERS(DXGI_FORMAT_B4G4R4A4_UNORM, XMUNIBBLE4, LoadB4G4R4A4_UNORM, 4, DecodePacked32<s_B4G4R4A4_UNORM>),
+
+        // Xbox One specific format
+        BATCH_DECODERS(XBOX_DXGI_FORMAT_R10G10B10_SNORM_A2_UNORM, XMXDECN4, LoadR10G10B10_SNORM_A2_UNORM, 4, DecodePacked32<s_R10G10B10_SNORM_A2_UNORM>),
+    };
+
+#undef BATCH_DECODERS
+#endif // _XM_SSE_INTRINSICS_
+
+    const FormatDecoders* GetDecoders(DXGI_FORMAT format)
+    {
+#ifdef _XM_SSE_INTRINSICS_
+        if (IsAVX2Supported())
+        {
+            for (size_t j = 0; j < _countof(g_DecodersAVX2); ++j)
+            {
+                if (g_DecodersAVX2[j].format == format)
+                    return &g_DecodersAVX2[j];
+            }
+        }
+#endif
+
+        for (size_t j = 0; j < _countof(g_Decoders); ++j)
+        {
+            if (g_Decoders[j].format == format)
+                return &g_Decoders[j];
+        }
+
+        return nullptr;
+    }
+
+    inline DecodeFunc<XMVECTOR> GetDecoder(const FormatDecoders& decoders, const XMVECTOR*) { return decoders.vector; }
+    inline DecodeFunc<float> GetDecoder(const FormatDecoders& decoders, const float*) { return decoders.float1; }
+    inline DecodeFunc<XMFLOAT2> GetDecoder(const FormatDecoders& decoders, const XMFLOAT2*) { return decoders.float2; }
+    inline DecodeFunc<XMFLOAT3> GetDecoder(const FormatDecoders& decoders, const XMFLOAT3*) { return decoders.float3; }
+    inline DecodeFunc<XMFLOAT4> GetDecoder(const FormatDecoders& decoders, const XMFLOAT4*) { return decoders.float4; }
 }
 
 class VBReader::Impl
@@ -61,21 +877,38 @@ public:
         mBuffers{},
         mVerts{},
         mDefaultStrides{},
-        mTempSize(0) {}
+        mThreads(0) {}
 
     HRESULT Initialize(_In_reads_(nDecl) const InputElementDesc* vbDecl, size_t nDecl);
     HRESULT AddStream(_In_reads_bytes_(stride*nVerts) const void* vb, size_t nVerts, size_t inputSlot, size_t stride);
-    HRESULT Read(_Out_writes_(count) XMVECTOR* buffer, _In_z_ const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const;
+    HRESULT GetHandle(_In_z_ const char* semanticName, unsigned int semanticIndex, _Out_ Handle& handle) const;
+    template<class T>
+    HRESULT Read(_Out_writes_(count) T* buffer, const Handle& handle, size_t count, bool x2bias) const;
+    template<class T>
+    HRESULT Read(_Out_writes_(count) T* buffer, _In_z_ const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const;
+
+    HRESULT SetQuantization(_In_z_ const char* semanticName, unsigned int semanticIndex, const XMFLOAT3& scale, const XMFLOAT3& bias);
+
+    void SetThreadCount(size_t threads) noexcept
+    {
+#ifdef _OPENMP
+        // num_threads takes an int, so never ask for more than the runtime would use anyway
+        const size_t maxThreads = static_cast<size_t>(std::max(omp_get_max_threads(), 1));
+        mThreads = std::min(threads, maxThreads);
+#else
+        mThreads = threads;
+#endif
+    }
 
     void Release()
     {
         mInputDesc.clear();
+        mQuantization.clear();
         mSemantics.clear();
         memset(mStrides, 0, sizeof(mStrides));
         memset(mBuffers, 0, sizeof(mBuffers));
         memset(mVerts, 0, sizeof(mVerts));
         memset(mDefaultStrides, 0, sizeof(mDefaultStrides));
-        mTempBuffer.reset();
     }
 
     const InputElementDesc* GetElement(_In_z_ const char* semanticName, _In_ unsigned int semanticIndex) const
@@ -95,37 +928,35 @@ public:
         return &mInputDesc[it->second];
     }
 
-    XMVECTOR* GetTemporaryBuffer(size_t count) const
+private:
+    typedef std::multimap<std::string, uint32_t> SemanticMap;
+
+    struct Quantization
+    {
+        XMFLOAT3 scale;
+        XMFLOAT3 bias;
+    };
+
+    const Quantization& GetQuantization(const Handle& handle) const
     {
-        if (!mTempBuffer || (mTempSize < count))
+        for (size_t j = 0; j < mInputDesc.size(); ++j)
         {
-            mTempSize = count;
-
-            for (size_t j = 0; j < c_MaxSlot; ++j)
-            {
-                if (mVerts[j] > mTempSize)
-                    mTempSize = mVerts[j];
-            }
-
-            mTempBuffer.reset(static_cast<XMVECTOR*>(_aligned_malloc(sizeof(XMVECTOR) * mTempSize, 16)));
-            if (!mTempBuffer)
-                mTempSize = 0;
+            if (mInputDesc[j].InputSlot == handle.slot && mInputDesc[j].AlignedByteOffset == handle.offset)
+                return mQuantization[j];
         }
 
-        return mTempBuffer.get();
+        static const Quantization s_identity = { XMFLOAT3(1.f, 1.f, 1.f), XMFLOAT3(0.f, 0.f, 0.f) };
+        return s_identity;
     }
 
-private:
-    typedef std::multimap<std::string, uint32_t> SemanticMap;
-
     std::vector<InputElementDesc>           mInputDesc;
+    std::vector<Quantization>               mQuantization;
     SemanticMap                             mSemantics;
     uint32_t                                mStrides[c_MaxSlot];
     const void*                             mBuffers[c_MaxSlot];
     size_t                                  mVerts[c_MaxSlot];
     uint32_t                                mDefaultStrides[c_MaxSlot];
-    mutable size_t                          mTempSize;
-    mutable ScopedAlignedArrayXMVECTOR      mTempBuffer;
+    size_t                                  mThreads;
 };
 
 
@@ -171,6 +1002,9 @@ HRESULT VBReader::Impl::Initialize(const InputElementDesc* vbDecl, size_t nDecl)
 
         mInputDesc[j].AlignedByteOffset = offsets[j];
 
+        Quantization identity = { XMFLOAT3(1.f, 1.f, 1.f), XMFLOAT3(0.f, 0.f, 0.f) };
+        mQuantization.push_back(identity);
+
         auto decl = SemanticMap::value_type(vbDecl[j].SemanticName, j);
         mSemantics.insert(decl);
 
@@ -216,425 +1050,129 @@ HRESULT VBReader::Impl::AddStream(const void* vb, size_t nVerts, size_t inputSlo
 
 
 //-------------------------------------------------------------------------------------
-#define LOAD_VERTS( type, func )\
-        for(size_t icount = 0; icount < count; ++icount)\
-        {\
-            if ((ptr + sizeof(type)) > eptr)\
-                return E_UNEXPECTED;\
-            *buffer++ = func(reinterpret_cast<const type*>(ptr));\
-            ptr += stride;\
-        }\
-        break;
+_Use_decl_annotations_
+HRESULT VBReader::Impl::GetHandle(const char* semanticName, unsigned int semanticIndex, Handle& handle) const
+{
+    handle = {};
 
-#define LOAD_VERTS4_X2( type, func, x2bias )\
-        for(size_t icount = 0; icount < count; ++icount)\
-        {\
-            if ((ptr + sizeof(type)) > eptr)\
-                return E_UNEXPECTED;\
-            XMVECTOR v = func(reinterpret_cast<const type*>(ptr));\
-            if (x2bias)\
-            {\
-                v = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);\
-            }\
-            *buffer++ = v;\
-            ptr += stride;\
-        }\
-        break;
+    if (!semanticName)
+        return E_INVALIDARG;
 
-#define LOAD_VERTS3_X2( type, func, x2bias )\
-        for(size_t icount = 0; icount < count; ++icount)\
-        {\
-            if ((ptr + sizeof(type)) > eptr)\
-                return E_UNEXPECTED;\
-            XMVECTOR v = func(reinterpret_cast<const type*>(ptr));\
-            if (x2bias)\
-            {\
-                XMVECTOR v2 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);\
-                v = XMVectorSelect(v, v2, g_XMSelect1110);\
-            }\
-            *buffer++ = v;\
-            ptr += stride;\
-        }\
-        break;
+    auto desc = GetElement(semanticName, semanticIndex);
+    if (!desc)
+        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
 
-#define LOAD_VERTS2_X2( type, func, x2bias )\
-        for(size_t icount = 0; icount < count; ++icount)\
-        {\
-            if ((ptr + sizeof(type)) > eptr)\
-                return E_UNEXPECTED;\
-            XMVECTOR v = func(reinterpret_cast<const type*>(ptr));\
-            if (x2bias)\
-            {\
-                XMVECTOR v2 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);\
-                v = XMVectorSelect(v, v2, g_XMSelect1100);\
-            }\
-            *buffer++ = v;\
-            ptr += stride;\
-        }\
-        break;
+    auto decoders = GetDecoders(desc->Format);
+    if (!decoders)
+        return E_FAIL;
 
-_Use_decl_annotations_
-HRESULT VBReader::Impl::Read(XMVECTOR* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
-{
-    if (!buffer || !semanticName || !count)
-        return E_INVALIDARG;
+    handle.slot = desc->InputSlot;
+    handle.offset = desc->AlignedByteOffset;
+    handle.codec = decoders;
 
-    auto range = mSemantics.equal_range(semanticName);
+    return S_OK;
+}
 
-    auto it = range.first;
-    for (; it != range.second; ++it)
-    {
-        if (mInputDesc[it->second].SemanticIndex == semanticIndex)
-            break;
-    }
 
-    if (it == range.second)
-        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
+//-------------------------------------------------------------------------------------
+template<class T>
+_Use_decl_annotations_
+HRESULT VBReader::Impl::Read(T* buffer, const Handle& handle, size_t count, bool x2bias) const
+{
+    if (!buffer || !count)
+        return E_INVALIDARG;
 
-    uint32_t inputSlot = mInputDesc[it->second].InputSlot;
+    if (!handle.codec || handle.slot >= c_MaxSlot)
+        return E_INVALIDARG;
 
-    auto vb = static_cast<const uint8_t*>(mBuffers[inputSlot]);
+    auto vb = static_cast<const uint8_t*>(mBuffers[handle.slot]);
     if (!vb)
         return E_FAIL;
 
-    if (count > mVerts[inputSlot])
+    if (count > mVerts[handle.slot])
         return E_BOUNDS;
 
-    uint32_t stride = mStrides[inputSlot];
+    uint32_t stride = mStrides[handle.slot];
     if (!stride)
         return E_UNEXPECTED;
 
-    const uint8_t* eptr = vb + stride * mVerts[inputSlot];
-    const uint8_t* ptr = vb + mInputDesc[it->second].AlignedByteOffset;
+    const uint8_t* eptr = vb + stride * mVerts[handle.slot];
+    const uint8_t* ptr = vb + handle.offset;
 
-    switch (static_cast<int>(mInputDesc[it->second].Format))
+    auto decoders = static_cast<const FormatDecoders*>(handle.codec);
+    if (decoders->format == VBFORMAT_QUANTIZED_POSITION_16)
     {
-    case DXGI_FORMAT_R32G32B32A32_FLOAT:
-        LOAD_VERTS(XMFLOAT4, XMLoadFloat4)
-
-    case DXGI_FORMAT_R32G32B32A32_UINT:
-        LOAD_VERTS(XMUINT4, XMLoadUInt4)
-
-    case DXGI_FORMAT_R32G32B32A32_SINT:
-        LOAD_VERTS(XMINT4, XMLoadSInt4)
-
-    case DXGI_FORMAT_R32G32B32_FLOAT:
-        LOAD_VERTS(XMFLOAT3, XMLoadFloat3)
-
-    case DXGI_FORMAT_R32G32B32_UINT:
-        LOAD_VERTS(XMUINT3, XMLoadUInt3)
-
-    case DXGI_FORMAT_R32G32B32_SINT:
-        LOAD_VERTS(XMINT3, XMLoadSInt3)
-
-    case DXGI_FORMAT_R16G16B16A16_FLOAT:
-        LOAD_VERTS(XMHALF4, XMLoadHalf4)
-
-    case DXGI_FORMAT_R16G16B16A16_UNORM:
-        LOAD_VERTS4_X2(XMUSHORTN4, XMLoadUShortN4, x2bias)
-
-    case DXGI_FORMAT_R16G16B16A16_UINT:
-        LOAD_VERTS(XMUSHORT4, XMLoadUShort4)
-
-    case DXGI_FORMAT_R16G16B16A16_SNORM:
-        LOAD_VERTS(XMSHORTN4, XMLoadShortN4)
-
-    case DXGI_FORMAT_R16G16B16A16_SINT:
-        LOAD_VERTS(XMSHORT4, XMLoadShort4)
-
-    case DXGI_FORMAT_R32G32_FLOAT:
-        LOAD_VERTS(XMFLOAT2, XMLoadFloat2)
-
-    case DXGI_FORMAT_R32G32_UINT:
-        LOAD_VERTS(XMUINT2, XMLoadUInt2)
-
-    case DXGI_FORMAT_R32G32_SINT:
-        LOAD_VERTS(XMINT2, XMLoadSInt2)
-
-    case DXGI_FORMAT_R10G10B10A2_UNORM:
-        LOAD_VERTS3_X2(XMUDECN4, XMLoadUDecN4, x2bias)
-
-    case DXGI_FORMAT_R10G10B10A2_UINT:
-        LOAD_VERTS(XMUDEC4, XMLoadUDec4);
-
-    case DXGI_FORMAT_R11G11B10_FLOAT:
-        LOAD_VERTS3_X2(XMFLOAT3PK, XMLoadFloat3PK, x2bias)
-
-    case DXGI_FORMAT_R8G8B8A8_UNORM:
-        LOAD_VERTS4_X2(XMUBYTEN4, XMLoadUByteN4, x2bias)
-
-    case DXGI_FORMAT_R8G8B8A8_UINT:
-        LOAD_VERTS(XMUBYTE4, XMLoadUByte4)
-
-    case DXGI_FORMAT_R8G8B8A8_SNORM:
-        LOAD_VERTS(XMBYTEN4, XMLoadByteN4)
-
-    case DXGI_FORMAT_R8G8B8A8_SINT:
-        LOAD_VERTS(XMBYTE4, XMLoadByte4)
-
-    case DXGI_FORMAT_R16G16_FLOAT:
-        LOAD_VERTS(XMHALF2, XMLoadHalf2)
-
-    case DXGI_FORMAT_R16G16_UNORM:
-        LOAD_VERTS2_X2(XMUSHORTN2, XMLoadUShortN2, x2bias)
-
-    case DXGI_FORMAT_R16G16_UINT:
-        LOAD_VERTS(XMUSHORT2, XMLoadUShort2)
-
-    case DXGI_FORMAT_R16G16_SNORM:
-        LOAD_VERTS(XMSHORTN2, XMLoadShortN2)
-
-    case DXGI_FORMAT_R16G16_SINT:
-        LOAD_VERTS(XMSHORT2, XMLoadShort2)
-
-    case DXGI_FORMAT_R32_FLOAT:
-        LOAD_VERTS(float, XMLoadFloat)
-
-    case DXGI_FORMAT_R32_UINT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(uint32_t)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMLoadInt(reinterpret_cast<const uint32_t*>(ptr));
-            *buffer++ = XMConvertVectorUIntToFloat(v, 0);
-            ptr += stride;
-        }
-        break;
-
-    case DXGI_FORMAT_R32_SINT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(int32_t)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMLoadInt(reinterpret_cast<const uint32_t*>(ptr));
-            *buffer++ = XMConvertVectorIntToFloat(v, 0);
-            ptr += stride;
-        }
-        break;
-
-    case DXGI_FORMAT_R8G8_UNORM:
-        LOAD_VERTS2_X2(XMUBYTEN2, XMLoadUByteN2, x2bias)
-
-    case DXGI_FORMAT_R8G8_UINT:
-        LOAD_VERTS(XMUBYTE2, XMLoadUByte2)
-
-    case DXGI_FORMAT_R8G8_SNORM:
-        LOAD_VERTS(XMBYTEN2, XMLoadByteN2)
-
-    case DXGI_FORMAT_R8G8_SINT:
-        LOAD_VERTS(XMBYTE2, XMLoadByte2)
-
-    case DXGI_FORMAT_R16_FLOAT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(HALF)) > eptr)
-                return E_UNEXPECTED;
-            float v = XMConvertHalfToFloat(*reinterpret_cast<const HALF*>(ptr));
-            *buffer++ = XMVectorSet(v, 0.f, 0.f, 0.f);
-            ptr += stride;
-        }
-        break;
+        auto& quantization = GetQuantization(handle);
+        return DecodeQuantized(buffer, ptr, eptr, stride, count,
+            XMLoadFloat3(&quantization.scale), XMLoadFloat3(&quantization.bias));
+    }
 
-    case DXGI_FORMAT_R16_UNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(uint16_t)) > eptr)
-                return E_UNEXPECTED;
-            auto i = *reinterpret_cast<const uint16_t*>(ptr);
-            float f = static_cast<float>(i) / 65535.f;
-            if (x2bias)
-            {
-                f = f*2.f - 1.f;
-            }
-            XMVECTOR v = XMVectorSet(f, 0.f, 0.f, 0.f);
-            *buffer++ = v;
-            ptr += stride;
-        }
-        break;
+    auto decode = GetDecoder(*decoders, buffer);
 
-    case DXGI_FORMAT_R16_UINT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(uint16_t)) > eptr)
-                return E_UNEXPECTED;
-            auto i = *reinterpret_cast<const uint16_t*>(ptr);
-            *buffer++ = XMVectorSet(static_cast<float>(i), 0.f, 0.f, 0.f);
-            ptr += stride;
-        }
-        break;
+#ifdef _OPENMP
+    if (mThreads > 1 && count > c_ParallelBlock)
+    {
+        // Each block is an independent range of elements, so no scratch is shared between threads
+        const int blockCount = static_cast<int>((count + c_ParallelBlock - 1) / c_ParallelBlock);
 
-    case DXGI_FORMAT_R16_SNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(int16_t)) > eptr)
-                return E_UNEXPECTED;
-            auto i = *reinterpret_cast<const int16_t*>(ptr);
-            *buffer++ = XMVectorSet(static_cast<float>(i) / 32767.f, 0.f, 0.f, 0.f);
-            ptr += stride;
-        }
-        break;
+        HRESULT hr = S_OK;
 
-    case DXGI_FORMAT_R16_SINT:
-        for (size_t icount = 0; icount < count; ++icount)
+        #pragma omp parallel for num_threads(static_cast<int>(mThreads))
+        for (int block = 0; block < blockCount; ++block)
         {
-            if ((ptr + sizeof(int16_t)) > eptr)
-                return E_UNEXPECTED;
-            auto i = *reinterpret_cast<const int16_t*>(ptr);
-            *buffer++ = XMVectorSet(static_cast<float>(i), 0.f, 0.f, 0.f);
-            ptr += stride;
-        }
-        break;
+            size_t first = size_t(block) * c_ParallelBlock;
+            size_t blockSize = std::min(c_ParallelBlock, count - first);
 
-    case DXGI_FORMAT_R8_UNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(uint8_t)) > eptr)
-                return E_UNEXPECTED;
-            const uint8_t i = *ptr;
-            float f = static_cast<float>(i) / 255.f;
-            if (x2bias)
+            HRESULT hrBlock = decode(buffer + first, ptr + first * stride, eptr, stride, blockSize, x2bias);
+            if (FAILED(hrBlock))
             {
-                f = f*2.f - 1.f;
+                #pragma omp critical
+                hr = hrBlock;
             }
-            XMVECTOR v = XMVectorSet(f, 0.f, 0.f, 0.f);
-            *buffer++ = v;
-            ptr += stride;
         }
-        break;
 
-    case DXGI_FORMAT_R8_UINT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(uint8_t)) > eptr)
-                return E_UNEXPECTED;
-            const uint8_t i = *ptr;
-            *buffer++ = XMVectorSet(static_cast<float>(i), 0.f, 0.f, 0.f);
-            ptr += stride;
-        }
-        break;
+        return hr;
+    }
+#endif
 
-    case DXGI_FORMAT_R8_SNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(int8_t)) > eptr)
-                return E_UNEXPECTED;
-            auto i = *reinterpret_cast<const int8_t*>(ptr);
-            *buffer++ = XMVectorSet(static_cast<float>(i) / 127.f, 0.f, 0.f, 0.f);
-            ptr += stride;
-        }
-        break;
+    return decode(buffer, ptr, eptr, stride, count, x2bias);
+}
 
-    case DXGI_FORMAT_R8_SINT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(int8_t)) > eptr)
-                return E_UNEXPECTED;
-            auto i = *reinterpret_cast<const int8_t*>(ptr);
-            *buffer++ = XMVectorSet(static_cast<float>(i), 0.f, 0.f, 0.f);
-            ptr += stride;
-        }
-        break;
+_Use_decl_annotations_
+HRESULT VBReader::Impl::SetQuantization(const char* semanticName, unsigned int semanticIndex, const XMFLOAT3& scale, const XMFLOAT3& bias)
+{
+    if (!semanticName)
+        return E_INVALIDARG;
 
-    case DXGI_FORMAT_B5G6R5_UNORM:
-    {
-        static const XMVECTORF32 s_Scale = { { { 1.f / 31.f, 1.f / 63.f, 1.f / 31.f, 1.f } } };
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMU565)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMLoadU565(reinterpret_cast<const XMU565*>(ptr));
-            v = XMVectorMultiply(v, s_Scale);
-            if (x2bias)
-            {
-                XMVECTOR v2 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
-                v = XMVectorSelect(v, v2, g_XMSelect1110);
-            }
-            *buffer++ = XMVectorSwizzle<2, 1, 0, 3>(v);
-            ptr += stride;
-        }
-    }
-    break;
+    auto desc = GetElement(semanticName, semanticIndex);
+    if (!desc)
+        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
 
-    case DXGI_FORMAT_B5G5R5A1_UNORM:
-    {
-        static const XMVECTORF32 s_Scale = { { { 1.f / 31.f, 1.f / 31.f, 1.f / 31.f, 1.f } } };
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMU555)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMLoadU555(reinterpret_cast<const XMU555*>(ptr));
-            v = XMVectorMultiply(v, s_Scale);
-            if (x2bias)
-            {
-                XMVECTOR v2 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
-                v = XMVectorSelect(v, v2, g_XMSelect1110);
-            }
-            *buffer++ = XMVectorSwizzle<2, 1, 0, 3>(v);
-            ptr += stride;
-        }
-    }
-    break;
+    if (desc->Format != VBFORMAT_QUANTIZED_POSITION_16)
+        return E_INVALIDARG;
 
-    case DXGI_FORMAT_B8G8R8A8_UNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMUBYTEN4)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMLoadUByteN4(reinterpret_cast<const XMUBYTEN4*>(ptr));
-            if (x2bias)
-            {
-                v = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
-            }
-            *buffer++ = XMVectorSwizzle<2, 1, 0, 3>(v);
-            ptr += stride;
-        }
-        break;
+    auto& quantization = mQuantization[size_t(desc - mInputDesc.data())];
+    quantization.scale = scale;
+    quantization.bias = bias;
 
-    case DXGI_FORMAT_B8G8R8X8_UNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMUBYTEN4)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMLoadUByteN4(reinterpret_cast<const XMUBYTEN4*>(ptr));
-            if (x2bias)
-            {
-                XMVECTOR v2 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
-                v = XMVectorSelect(v, v2, g_XMSelect1110);
-            }
-            v = XMVectorSwizzle<2, 1, 0, 3>(v);
-            *buffer++ = XMVectorSelect(g_XMZero, v, g_XMSelect1110);
-            ptr += stride;
-        }
-        break;
+    return S_OK;
+}
 
-    case DXGI_FORMAT_B4G4R4A4_UNORM:
-    {
-        static const XMVECTORF32 s_Scale = { { { 1.f / 15.f, 1.f / 15.f, 1.f / 15.f, 1.f / 15.f } } };
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMUNIBBLE4)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMLoadUNibble4(reinterpret_cast<const XMUNIBBLE4*>(ptr));
-            v = XMVectorMultiply(v, s_Scale);
-            if (x2bias)
-            {
-                v = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
-            }
-            *buffer++ = XMVectorSwizzle<2, 1, 0, 3>(v);
-            ptr += stride;
-        }
-    }
-    break;
 
-    case XBOX_DXGI_FORMAT_R10G10B10_SNORM_A2_UNORM:
-        // Xbox One specific format
-        LOAD_VERTS(XMXDECN4, XMLoadXDecN4);
+//-------------------------------------------------------------------------------------
+template<class T>
+_Use_decl_annotations_
+HRESULT VBReader::Impl::Read(T* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+{
+    if (!buffer || !semanticName || !count)
+        return E_INVALIDARG;
 
-    default:
-        return E_FAIL;
-    }
+    Handle handle;
+    HRESULT hr = GetHandle(semanticName, semanticIndex, handle);
+    if (FAILED(hr))
+        return hr;
 
-    return S_OK;
+    return Read(buffer, handle, count, x2bias);
 }
 
 
@@ -707,85 +1245,77 @@ HRESULT VBReader::Read(XMVECTOR* buffer, const char* semanticName, unsigned int
 _Use_decl_annotations_
 HRESULT VBReader::Read(float* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
 {
-    XMVECTOR* temp = pImpl->GetTemporaryBuffer(count);
-    if (!temp)
-        return E_OUTOFMEMORY;
-
-    HRESULT hr = pImpl->Read(temp, semanticName, semanticIndex, count, x2bias);
-    if (FAILED(hr))
-        return hr;
-
-    float* dptr = buffer;
-    for (size_t j = 0; j < count; ++j)
-    {
-        XMVECTOR v = *(temp)++;
-        XMStoreFloat(dptr++, v);
-    }
-
-    return S_OK;
+    return pImpl->Read(buffer, semanticName, semanticIndex, count, x2bias);
 }
 
 _Use_decl_annotations_
 HRESULT VBReader::Read(XMFLOAT2* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
 {
-    XMVECTOR* temp = pImpl->GetTemporaryBuffer(count);
-    if (!temp)
-        return E_OUTOFMEMORY;
+    return pImpl->Read(buffer, semanticName, semanticIndex, count, x2bias);
+}
 
-    HRESULT hr = pImpl->Read(temp, semanticName, semanticIndex, count, x2bias);
-    if (FAILED(hr))
-        return hr;
+_Use_decl_annotations_
+HRESULT VBReader::Read(XMFLOAT3* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+{
+    return pImpl->Read(buffer, semanticName, semanticIndex, count, x2bias);
+}
 
-    XMFLOAT2* dptr = buffer;
-    for (size_t j = 0; j < count; ++j)
-    {
-        XMVECTOR v = *(temp)++;
-        XMStoreFloat2(dptr++, v);
-    }
+_Use_decl_annotations_
+HRESULT VBReader::Read(XMFLOAT4* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+{
+    return pImpl->Read(buffer, semanticName, semanticIndex, count, x2bias);
+}
 
-    return S_OK;
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT VBReader::GetHandle(const char* semanticName, unsigned int semanticIndex, Handle& handle) const
+{
+    return pImpl->GetHandle(semanticName, semanticIndex, handle);
 }
 
 _Use_decl_annotations_
-HRESULT VBReader::Read(XMFLOAT3* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+HRESULT VBReader::Read(XMVECTOR* buffer, const Handle& handle, size_t count, bool x2bias) const
 {
-    XMVECTOR* temp = pImpl->GetTemporaryBuffer(count);
-    if (!temp)
-        return E_OUTOFMEMORY;
+    return pImpl->Read(buffer, handle, count, x2bias);
+}
 
-    HRESULT hr = pImpl->Read(temp, semanticName, semanticIndex, count, x2bias);
-    if (FAILED(hr))
-        return hr;
+_Use_decl_annotations_
+HRESULT VBReader::Read(float* buffer, const Handle& handle, size_t count, bool x2bias) const
+{
+    return pImpl->Read(buffer, handle, count, x2bias);
+}
 
-    XMFLOAT3* dptr = buffer;
-    for (size_t j = 0; j < count; ++j)
-    {
-        XMVECTOR v = *(temp)++;
-        XMStoreFloat3(dptr++, v);
-    }
+_Use_decl_annotations_
+HRESULT VBReader::Read(XMFLOAT2* buffer, const Handle& handle, size_t count, bool x2bias) const
+{
+    return pImpl->Read(buffer, handle, count, x2bias);
+}
 
-    return S_OK;
+_Use_decl_annotations_
+HRESULT VBReader::Read(XMFLOAT3* buffer, const Handle& handle, size_t count, bool x2bias) const
+{
+    return pImpl->Read(buffer, handle, count, x2bias);
 }
 
 _Use_decl_annotations_
-HRESULT VBReader::Read(XMFLOAT4* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+HRESULT VBReader::Read(XMFLOAT4* buffer, const Handle& handle, size_t count, bool x2bias) const
 {
-    XMVECTOR* temp = pImpl->GetTemporaryBuffer(count);
-    if (!temp)
-        return E_OUTOFMEMORY;
+    return pImpl->Read(buffer, handle, count, x2bias);
+}
 
-    HRESULT hr = pImpl->Read(temp, semanticName, semanticIndex, count, x2bias);
-    if (FAILED(hr))
-        return hr;
 
-    XMFLOAT4* dptr = buffer;
-    for (size_t j = 0; j < count; ++j)
-    {
-        XMVECTOR v = *(temp)++;
-        XMStoreFloat4(dptr++, v);
-    }
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT VBReader::SetQuantization(const char* semanticName, unsigned int semanticIndex, const XMFLOAT3& scale, const XMFLOAT3& bias)
+{
+    return pImpl->SetQuantization(semanticName, semanticIndex, scale, bias);
+}
 
-    return S_OK;
+_Use_decl_annotations_
+void VBReader::SetThreadCount(size_t threads) noexcept
+{
+    pImpl->SetThreadCount(threads);
 }
 
 
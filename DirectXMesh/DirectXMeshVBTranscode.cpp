@@ -0,0 +1,360 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshVBTranscode.cpp
+//
+// DirectX Mesh Geometry Library - Vertex Buffer layout conversion
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // Vertices converted per block, so the scratch stays in cache with the block's source and destination
+    const size_t c_BlockVerts = 2048;
+
+    enum TRANSCODE_OP
+    {
+        OP_COPY = 0,    // Same semantic and format, copied as bytes
+        OP_CONVERT,     // Decoded by the reader and encoded by the writer
+        OP_ZERO,        // Semantic missing from the source
+    };
+
+    struct TranscodeStep
+    {
+        TRANSCODE_OP        op;
+        uint32_t            inOffset;
+        uint32_t            outOffset;
+        uint32_t            size;
+        VBReader::Handle    reader;
+        VBWriter::Handle    writer;
+    };
+
+    // The reader and writer keep the layouts with append aligned offsets resolved
+#if defined(__d3d11_h__) || defined(__d3d11_x_h__)
+    inline const D3D11_INPUT_ELEMENT_DESC* GetElement(const VBReader& reader, const D3D11_INPUT_ELEMENT_DESC& element)
+    {
+        return reader.GetElement11(element.SemanticName, element.SemanticIndex);
+    }
+
+    inline const D3D11_INPUT_ELEMENT_DESC* GetElement(const VBWriter& writer, const D3D11_INPUT_ELEMENT_DESC& element)
+    {
+        return writer.GetElement11(element.SemanticName, element.SemanticIndex);
+    }
+#endif
+
+#if defined(__d3d12_h__) || defined(__d3d12_x_h__)
+    inline const D3D12_INPUT_ELEMENT_DESC* GetElement(const VBReader& reader, const D3D12_INPUT_ELEMENT_DESC& element)
+    {
+        return reader.GetElement12(element.SemanticName, element.SemanticIndex);
+    }
+
+    inline const D3D12_INPUT_ELEMENT_DESC* GetElement(const VBWriter& writer, const D3D12_INPUT_ELEMENT_DESC& element)
+    {
+        return writer.GetElement12(element.SemanticName, element.SemanticIndex);
+    }
+#endif
+
+    //---------------------------------------------------------------------------------
+    // Builds the steps for each output element, with adjacent copies merged into one
+    //---------------------------------------------------------------------------------
+    template<class element_t>
+    HRESULT CompilePlan(
+        _In_ const VBReader& reader,
+        _In_ const VBWriter& writer,
+        _In_reads_(nOutDecl) const element_t* outDecl, size_t nOutDecl,
+        std::vector<TranscodeStep>& plan)
+    {
+        plan.clear();
+        plan.reserve(nOutDecl);
+
+        std::vector<TranscodeStep> copies;
+
+        for (size_t j = 0; j < nOutDecl; ++j)
+        {
+            auto outElement = GetElement(writer, outDecl[j]);
+            if (!outElement)
+                return E_UNEXPECTED;
+
+            TranscodeStep step = {};
+            step.outOffset = outElement->AlignedByteOffset;
+            step.size = static_cast<uint32_t>(BytesPerElement(outElement->Format));
+
+            auto inElement = GetElement(reader, outDecl[j]);
+            if (!inElement)
+            {
+                step.op = OP_ZERO;
+                plan.push_back(step);
+                continue;
+            }
+
+            step.inOffset = inElement->AlignedByteOffset;
+
+            if (inElement->Format == outElement->Format)
+            {
+                step.op = OP_COPY;
+                copies.push_back(step);
+                continue;
+            }
+
+            if (inElement->Format == VBFORMAT_QUANTIZED_POSITION_16
+                || outElement->Format == VBFORMAT_QUANTIZED_POSITION_16)
+            {
+                // Converting needs a dequantization transform, which only VBReader and VBWriter take
+                return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+            }
+
+            HRESULT hr = reader.GetHandle(outDecl[j].SemanticName, outDecl[j].SemanticIndex, step.reader);
+            if (FAILED(hr))
+                return hr;
+
+            hr = writer.GetHandle(outDecl[j].SemanticName, outDecl[j].SemanticIndex, step.writer);
+            if (FAILED(hr))
+                return hr;
+
+            step.op = OP_CONVERT;
+            plan.push_back(step);
+        }
+
+        std::sort(copies.begin(), copies.end(), [](const TranscodeStep& a, const TranscodeStep& b)
+        {
+            return a.outOffset < b.outOffset;
+        });
+
+        for (auto it = copies.cbegin(); it != copies.cend(); ++it)
+        {
+            if (!plan.empty())
+            {
+                auto& last = plan.back();
+                if (last.op == OP_COPY
+                    && (last.outOffset + last.size) == it->outOffset
+                    && (last.inOffset + last.size) == it->inOffset)
+                {
+                    last.size += it->size;
+                    continue;
+                }
+            }
+
+            plan.push_back(*it);
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    template<class element_t>
+    HRESULT TranscodeImpl(
+        _In_reads_bytes_(inStride * nVerts) const uint8_t* vbin, size_t inStride,
+        _In_ VBReader& reader,
+        _Out_writes_bytes_(outStride * nVerts) uint8_t* vbout, size_t outStride,
+        _In_ VBWriter& writer,
+        _In_reads_(nOutDecl) const element_t* outDecl, size_t nOutDecl,
+        size_t nVerts)
+    {
+        std::vector<TranscodeStep> plan;
+        HRESULT hr = CompilePlan(reader, writer, outDecl, nOutDecl, plan);
+        if (FAILED(hr))
+            return hr;
+
+        // Identical layouts are a single copy per block
+        const bool blockCopy = (plan.size() == 1)
+            && (plan[0].op == OP_COPY)
+            && (plan[0].inOffset == 0 && plan[0].outOffset == 0)
+            && (inStride == outStride) && (plan[0].size == inStride);
+
+        ScopedAlignedArrayXMVECTOR temp(static_cast<XMVECTOR*>(_aligned_malloc(sizeof(XMVECTOR) * c_BlockVerts, 16)));
+        if (!temp)
+            return E_OUTOFMEMORY;
+
+        for (size_t base = 0; base < nVerts; base += c_BlockVerts)
+        {
+            const size_t count = std::min(c_BlockVerts, nVerts - base);
+
+            const uint8_t* sptr = vbin + base * inStride;
+            uint8_t* dptr = vbout + base * outStride;
+
+            if (blockCopy)
+            {
+                memcpy(dptr, sptr, count * inStride);
+                continue;
+            }
+
+            // The reader and writer see the block as the whole stream, which keeps their bounds checks
+            hr = reader.AddStream(sptr, count, 0, inStride);
+            if (FAILED(hr))
+                return hr;
+
+            hr = writer.AddStream(dptr, count, 0, outStride);
+            if (FAILED(hr))
+                return hr;
+
+            for (auto it = plan.cbegin(); it != plan.cend(); ++it)
+            {
+                switch (it->op)
+                {
+                case OP_COPY:
+                    for (size_t v = 0; v < count; ++v)
+                    {
+                        memcpy(dptr + v * outStride + it->outOffset, sptr + v * inStride + it->inOffset, it->size);
+                    }
+                    break;
+
+                case OP_ZERO:
+                    for (size_t v = 0; v < count; ++v)
+                    {
+                        memset(dptr + v * outStride + it->outOffset, 0, it->size);
+                    }
+                    break;
+
+                default:
+                    hr = reader.Read(temp.get(), it->reader, count);
+                    if (FAILED(hr))
+                        return hr;
+
+                    hr = writer.Write(temp.get(), it->writer, count);
+                    if (FAILED(hr))
+                        return hr;
+                    break;
+                }
+            }
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    template<class element_t>
+    HRESULT ValidateSlots(_In_reads_(nDecl) const element_t* vbDecl, size_t nDecl)
+    {
+        for (size_t j = 0; j < nDecl; ++j)
+        {
+            if (vbDecl[j].InputSlot != 0)
+            {
+                // Only single stream layouts are supported
+                return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+            }
+        }
+
+        return S_OK;
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+#if defined(__d3d11_h__) || defined(__d3d11_x_h__)
+_Use_decl_annotations_
+HRESULT DirectX::TranscodeVB(
+    const void* vbin, size_t inStride, const D3D11_INPUT_ELEMENT_DESC* inDecl, size_t nInDecl,
+    void* vbout, size_t outStride, const D3D11_INPUT_ELEMENT_DESC* outDecl, size_t nOutDecl,
+    size_t nVerts)
+{
+    if (!vbin || !inDecl || !nInDecl || !vbout || !outDecl || !nOutDecl || !nVerts)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if (!IsValid(inDecl, nInDecl) || !IsValid(outDecl, nOutDecl))
+        return E_INVALIDARG;
+
+    HRESULT hr = ValidateSlots(inDecl, nInDecl);
+    if (FAILED(hr))
+        return hr;
+
+    hr = ValidateSlots(outDecl, nOutDecl);
+    if (FAILED(hr))
+        return hr;
+
+    uint32_t strides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+    ComputeInputLayout(inDecl, nInDecl, nullptr, strides);
+    if (!inStride)
+        inStride = strides[0];
+
+    if (inStride < strides[0] || inStride > D3D11_REQ_MULTI_ELEMENT_STRUCTURE_SIZE_IN_BYTES)
+        return E_INVALIDARG;
+
+    ComputeInputLayout(outDecl, nOutDecl, nullptr, strides);
+    if (!outStride)
+        outStride = strides[0];
+
+    if (outStride < strides[0] || outStride > D3D11_REQ_MULTI_ELEMENT_STRUCTURE_SIZE_IN_BYTES)
+        return E_INVALIDARG;
+
+    VBReader reader;
+    hr = reader.Initialize(inDecl, nInDecl);
+    if (FAILED(hr))
+        return hr;
+
+    VBWriter writer;
+    hr = writer.Initialize(outDecl, nOutDecl);
+    if (FAILED(hr))
+        return hr;
+
+    return TranscodeImpl(static_cast<const uint8_t*>(vbin), inStride, reader,
+        static_cast<uint8_t*>(vbout), outStride, writer,
+        outDecl, nOutDecl, nVerts);
+}
+#endif
+
+#if defined(__d3d12_h__) || defined(__d3d12_x_h__)
+_Use_decl_annotations_
+HRESULT DirectX::TranscodeVB(
+    const void* vbin, size_t inStride, const D3D12_INPUT_LAYOUT_DESC& inDecl,
+    void* vbout, size_t outStride, const D3D12_INPUT_LAYOUT_DESC& outDecl,
+    size_t nVerts)
+{
+    if (!vbin || !inDecl.NumElements || !vbout || !outDecl.NumElements || !nVerts)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if (!IsValid(inDecl) || !IsValid(outDecl))
+        return E_INVALIDARG;
+
+    HRESULT hr = ValidateSlots(inDecl.pInputElementDescs, inDecl.NumElements);
+    if (FAILED(hr))
+        return hr;
+
+    hr = ValidateSlots(outDecl.pInputElementDescs, outDecl.NumElements);
+    if (FAILED(hr))
+        return hr;
+
+    uint32_t strides[D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+    ComputeInputLayout(inDecl, nullptr, strides);
+    if (!inStride)
+        inStride = strides[0];
+
+    if (inStride < strides[0] || inStride > D3D12_REQ_MULTI_ELEMENT_STRUCTURE_SIZE_IN_BYTES)
+        return E_INVALIDARG;
+
+    ComputeInputLayout(outDecl, nullptr, strides);
+    if (!outStride)
+        outStride = strides[0];
+
+    if (outStride < strides[0] || outStride > D3D12_REQ_MULTI_ELEMENT_STRUCTURE_SIZE_IN_BYTES)
+        return E_INVALIDARG;
+
+    VBReader reader;
+    hr = reader.Initialize(inDecl);
+    if (FAILED(hr))
+        return hr;
+
+    VBWriter writer;
+    hr = writer.Initialize(outDecl);
+    if (FAILED(hr))
+        return hr;
+
+    return TranscodeImpl(static_cast<const uint8_t*>(vbin), inStride, reader,
+        static_cast<uint8_t*>(vbout), outStride, writer,
+        outDecl.pInputElementDescs, outDecl.NumElements, nVerts);
+}
+#endif
@@ -18,6 +18,7 @@ namespace
 {
     const size_t c_MaxSlot = 32;
     const size_t c_MaxStride = 2048;
+    const size_t c_ParallelBlock = 16384;
 
     enum INPUT_CLASSIFICATION
     {
@@ -51,8 +52,735 @@ namespace
     static_assert(c_MaxSlot == D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT, "D3D12 mismatch");
     static_assert(c_MaxStride == D3D12_REQ_MULTI_ELEMENT_STRUCTURE_SIZE_IN_BYTES, "D3D12 mismatch");
 #endif
+
+
+    //---------------------------------------------------------------------------------
+    // Element storers, one per vertex format
+    //---------------------------------------------------------------------------------
+
+#define ELEMENT_STORER( name, type, func )\
+    inline void XM_CALLCONV name(_Out_ uint8_t* ptr, FXMVECTOR v, bool)\
+    {\
+        func(reinterpret_cast<type*>(ptr), v);\
+    }
+
+#define ELEMENT_STORER_X2( name, type, func )\
+    inline void XM_CALLCONV name(_Out_ uint8_t* ptr, FXMVECTOR v, bool x2bias)\
+    {\
+        XMVECTOR v2 = v;\
+        if (x2bias)\
+        {\
+            v2 = XMVectorClamp(v2, g_XMNegativeOne, g_XMOne);\
+            v2 = XMVectorMultiplyAdd(v2, g_XMOneHalf, g_XMOneHalf);\
+        }\
+        func(reinterpret_cast<type*>(ptr), v2);\
+    }
+
+    ELEMENT_STORER(StoreR32G32B32A32_UINT, XMUINT4, XMStoreUInt4)
+    ELEMENT_STORER(StoreR32G32B32A32_SINT, XMINT4, XMStoreSInt4)
+    ELEMENT_STORER(StoreR32G32B32_UINT, XMUINT3, XMStoreUInt3)
+    ELEMENT_STORER(StoreR32G32B32_SINT, XMINT3, XMStoreSInt3)
+    ELEMENT_STORER(StoreR16G16B16A16_FLOAT, XMHALF4, XMStoreHalf4)
+    ELEMENT_STORER_X2(StoreR16G16B16A16_UNORM, XMUSHORTN4, XMStoreUShortN4)
+    ELEMENT_STORER(StoreR16G16B16A16_UINT, XMUSHORT4, XMStoreUShort4)
+    ELEMENT_STORER(StoreR16G16B16A16_SNORM, XMSHORTN4, XMStoreShortN4)
+    ELEMENT_STORER(StoreR16G16B16A16_SINT, XMSHORT4, XMStoreShort4)
+    ELEMENT_STORER(StoreR32G32_UINT, XMUINT2, XMStoreUInt2)
+    ELEMENT_STORER(StoreR32G32_SINT, XMINT2, XMStoreSInt2)
+    ELEMENT_STORER(StoreR10G10B10A2_UINT, XMUDEC4, XMStoreUDec4)
+    ELEMENT_STORER_X2(StoreR11G11B10_FLOAT, XMFLOAT3PK, XMStoreFloat3PK)
+    ELEMENT_STORER_X2(StoreR8G8B8A8_UNORM, XMUBYTEN4, XMStoreUByteN4)
+    ELEMENT_STORER(StoreR8G8B8A8_UINT, XMUBYTE4, XMStoreUByte4)
+    ELEMENT_STORER(StoreR8G8B8A8_SNORM, XMBYTEN4, XMStoreByteN4)
+    ELEMENT_STORER(StoreR8G8B8A8_SINT, XMBYTE4, XMStoreByte4)
+    ELEMENT_STORER(StoreR16G16_FLOAT, XMHALF2, XMStoreHalf2)
+    ELEMENT_STORER_X2(StoreR16G16_UNORM, XMUSHORTN2, XMStoreUShortN2)
+    ELEMENT_STORER(StoreR16G16_UINT, XMUSHORT2, XMStoreUShort2)
+    ELEMENT_STORER(StoreR16G16_SNORM, XMSHORTN2, XMStoreShortN2)
+    ELEMENT_STORER(StoreR16G16_SINT, XMSHORT2, XMStoreShort2)
+    ELEMENT_STORER_X2(StoreR8G8_UNORM, XMUBYTEN2, XMStoreUByteN2)
+    ELEMENT_STORER(StoreR8G8_UINT, XMUBYTE2, XMStoreUByte2)
+    ELEMENT_STORER(StoreR8G8_SNORM, XMBYTEN2, XMStoreByteN2)
+    ELEMENT_STORER(StoreR8G8_SINT, XMBYTE2, XMStoreByte2)
+    ELEMENT_STORER(StoreR10G10B10_SNORM_A2_UNORM, XMXDECN4, XMStoreXDecN4)
+
+    inline void XM_CALLCONV StoreR10G10B10A2_UNORM(_Out_ uint8_t* ptr, FXMVECTOR v, bool x2bias)
+    {
+        XMVECTOR v1 = v;
+        if (x2bias)
+        {
+            XMVECTOR v2 = XMVectorClamp(v1, g_XMNegativeOne, g_XMOne);
+            v2 = XMVectorMultiplyAdd(v2, g_XMOneHalf, g_XMOneHalf);
+            v1 = XMVectorSelect(v1, v2, g_XMSelect1110);
+        }
+        XMStoreUDecN4(reinterpret_cast<XMUDECN4*>(ptr), v1);
+    }
+
+    inline void XM_CALLCONV StoreR32_UINT(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        XMVECTOR v1 = XMConvertVectorFloatToUInt(v, 0);
+        XMStoreInt(reinterpret_cast<uint32_t*>(ptr), v1);
+    }
+
+    inline void XM_CALLCONV StoreR32_SINT(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        XMVECTOR v1 = XMConvertVectorFloatToInt(v, 0);
+        XMStoreInt(reinterpret_cast<uint32_t*>(ptr), v1);
+    }
+
+    inline void XM_CALLCONV StoreR16_FLOAT(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        float f = XMVectorGetX(v);
+        *reinterpret_cast<HALF*>(ptr) = XMConvertFloatToHalf(f);
+    }
+
+    inline void XM_CALLCONV StoreR16_UNORM(_Out_ uint8_t* ptr, FXMVECTOR v, bool x2bias)
+    {
+        float f = XMVectorGetX(v);
+        if (x2bias)
+        {
+            f = std::max<float>(std::min<float>(f, 1.f), -1.f);
+            f = f * 0.5f + 0.5f;
+        }
+        else
+        {
+            f = std::max<float>(std::min<float>(f, 1.f), 0.f);
+        }
+        *reinterpret_cast<uint16_t*>(ptr) = static_cast<uint16_t>(f*65535.f + 0.5f);
+    }
+
+    inline void XM_CALLCONV StoreR16_UINT(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        float f = XMVectorGetX(v);
+        f = std::max<float>(std::min<float>(f, 65535.f), 0.f);
+        *reinterpret_cast<uint16_t*>(ptr) = static_cast<uint16_t>(f);
+    }
+
+    inline void XM_CALLCONV StoreR16_SNORM(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        float f = XMVectorGetX(v);
+        f = std::max<float>(std::min<float>(f, 1.f), -1.f);
+        *reinterpret_cast<int16_t*>(ptr) = static_cast<int16_t>(f * 32767.f);
+    }
+
+    inline void XM_CALLCONV StoreR16_SINT(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        float f = XMVectorGetX(v);
+        f = std::max<float>(std::min<float>(f, 32767.f), -32767.f);
+        *reinterpret_cast<int16_t*>(ptr) = static_cast<int16_t>(f);
+    }
+
+    inline void XM_CALLCONV StoreR8_UNORM(_Out_ uint8_t* ptr, FXMVECTOR v, bool x2bias)
+    {
+        float f = XMVectorGetX(v);
+        if (x2bias)
+        {
+            f = std::max<float>(std::min<float>(f, 1.f), -1.f);
+            f = f * 0.5f + 0.5f;
+        }
+        else
+        {
+            f = std::max<float>(std::min<float>(f, 1.f), 0.f);
+        }
+        *ptr = static_cast<uint8_t>(f * 255.f);
+    }
+
+    inline void XM_CALLCONV StoreR8_UINT(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        float f = XMVectorGetX(v);
+        f = std::max<float>(std::min<float>(f, 255.f), 0.f);
+        *ptr = static_cast<uint8_t>(f);
+    }
+
+    inline void XM_CALLCONV StoreR8_SNORM(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        float f = XMVectorGetX(v);
+        f = std::max<float>(std::min<float>(f, 1.f), -1.f);
+        *reinterpret_cast<int8_t*>(ptr) = static_cast<int8_t>(f * 127.f);
+    }
+
+    inline void XM_CALLCONV StoreR8_SINT(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        float f = XMVectorGetX(v);
+        f = std::max<float>(std::min<float>(f, 127.f), -127.f);
+        *reinterpret_cast<int8_t*>(ptr) = static_cast<int8_t>(f);
+    }
+
+    inline void XM_CALLCONV StoreB5G6R5_UNORM(_Out_ uint8_t* ptr, FXMVECTOR v, bool x2bias)
+    {
+        static const XMVECTORF32 s_Scale = { { { 31.f, 63.f, 31.f, 1.f } } };
+        XMVECTOR v1 = XMVectorSwizzle<2, 1, 0, 3>(v);
+        if (x2bias)
+        {
+            v1 = XMVectorClamp(v1, g_XMNegativeOne, g_XMOne);
+            v1 = XMVectorMultiplyAdd(v1, g_XMOneHalf, g_XMOneHalf);
+        }
+        v1 = XMVectorMultiply(v1, s_Scale);
+        XMStoreU565(reinterpret_cast<XMU565*>(ptr), v1);
+    }
+
+    inline void XM_CALLCONV StoreB5G5R5A1_UNORM(_Out_ uint8_t* ptr, FXMVECTOR v, bool x2bias)
+    {
+        static const XMVECTORF32 s_Scale = { { { 31.f, 31.f, 31.f, 1.f } } };
+        XMVECTOR v1 = XMVectorSwizzle<2, 1, 0, 3>(v);
+        if (x2bias)
+        {
+            XMVECTOR v2 = XMVectorClamp(v1, g_XMNegativeOne, g_XMOne);
+            v2 = XMVectorMultiplyAdd(v2, g_XMOneHalf, g_XMOneHalf);
+            v1 = XMVectorSelect(v1, v2, g_XMSelect1110);
+        }
+        v1 = XMVectorMultiply(v1, s_Scale);
+        XMStoreU555(reinterpret_cast<XMU555*>(ptr), v1);
+        reinterpret_cast<XMU555*>(ptr)->w = (XMVectorGetW(v1) > 0.5f) ? 1 : 0;
+    }
+
+    inline void XM_CALLCONV StoreB8G8R8A8_UNORM(_Out_ uint8_t* ptr, FXMVECTOR v, bool x2bias)
+    {
+        XMVECTOR v1 = XMVectorSwizzle<2, 1, 0, 3>(v);
+        if (x2bias)
+        {
+            v1 = XMVectorClamp(v1, g_XMNegativeOne, g_XMOne);
+            v1 = XMVectorMultiplyAdd(v1, g_XMOneHalf, g_XMOneHalf);
+        }
+        XMStoreUByteN4(reinterpret_cast<XMUBYTEN4*>(ptr), v1);
+    }
+
+    inline void XM_CALLCONV StoreB8G8R8X8_UNORM(_Out_ uint8_t* ptr, FXMVECTOR v, bool x2bias)
+    {
+        XMVECTOR v1 = XMVectorSwizzle<2, 1, 0, 3>(v);
+        if (x2bias)
+        {
+            v1 = XMVectorClamp(v1, g_XMNegativeOne, g_XMOne);
+            v1 = XMVectorMultiplyAdd(v1, g_XMOneHalf, g_XMOneHalf);
+        }
+        v1 = XMVectorSelect(g_XMZero, v1, g_XMSelect1110);
+        XMStoreUByteN4(reinterpret_cast<XMUBYTEN4*>(ptr), v1);
+    }
+
+    inline void XM_CALLCONV StoreB4G4R4A4_UNORM(_Out_ uint8_t* ptr, FXMVECTOR v, bool x2bias)
+    {
+        static const XMVECTORF32 s_Scale = { { { 15.f, 15.f, 15.f, 15.f } } };
+        XMVECTOR v1 = XMVectorSwizzle<2, 1, 0, 3>(v);
+        if (x2bias)
+        {
+            v1 = XMVectorClamp(v1, g_XMNegativeOne, g_XMOne);
+            v1 = XMVectorMultiplyAdd(v1, g_XMOneHalf, g_XMOneHalf);
+        }
+        v1 = XMVectorMultiply(v1, s_Scale);
+        XMStoreUNibble4(reinterpret_cast<XMUNIBBLE4*>(ptr), v1);
+    }
+
+    inline void XM_CALLCONV StoreOctahedralNormal8(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        XMStoreByteN2(reinterpret_cast<XMBYTEN2*>(ptr), OctahedralEncode(v));
+    }
+
+    inline void XM_CALLCONV StoreOctahedralNormal16(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        XMStoreShortN2(reinterpret_cast<XMSHORTN2*>(ptr), OctahedralEncode(v));
+    }
+
+    inline void XM_CALLCONV StoreOctahedralTangent8(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        XMVECTOR sign = (XMVectorGetW(v) < 0.f) ? g_XMNegativeOne : g_XMOne;
+        XMStoreByteN4(reinterpret_cast<XMBYTEN4*>(ptr), XMVectorSelect(sign, OctahedralEncode(v), g_XMSelect1110));
+    }
+
+    inline void XM_CALLCONV StoreOctahedralTangent16(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        XMVECTOR sign = (XMVectorGetW(v) < 0.f) ? g_XMNegativeOne : g_XMOne;
+        XMStoreShortN4(reinterpret_cast<XMSHORTN4*>(ptr), XMVectorSelect(sign, OctahedralEncode(v), g_XMSelect1110));
+    }
+
+    inline void XM_CALLCONV StoreQuantizedPosition16(_Out_ uint8_t* ptr, FXMVECTOR v, bool)
+    {
+        XMStoreUShortN4(reinterpret_cast<XMUSHORTN4*>(ptr), XMVectorSelect(g_XMZero, v, g_XMSelect1110));
+    }
+
+#undef ELEMENT_STORER
+#undef ELEMENT_STORER_X2
+
+
+    //---------------------------------------------------------------------------------
+    // Encoders, specialized for each format and source type
+    //---------------------------------------------------------------------------------
+
+    // Loads an element to encode from each supported source type
+    inline XMVECTOR XM_CALLCONV LoadVertex(_In_ const XMVECTOR* src) { return *src; }
+    inline XMVECTOR XM_CALLCONV LoadVertex(_In_ const float* src) { return XMLoadFloat(src); }
+    inline XMVECTOR XM_CALLCONV LoadVertex(_In_ const XMFLOAT2* src) { return XMLoadFloat2(src); }
+    inline XMVECTOR XM_CALLCONV LoadVertex(_In_ const XMFLOAT3* src) { return XMLoadFloat3(src); }
+    inline XMVECTOR XM_CALLCONV LoadVertex(_In_ const XMFLOAT4* src) { return XMLoadFloat4(src); }
+
+    template<size_t size, void(XM_CALLCONV *store)(uint8_t*, FXMVECTOR, bool), class T>
+    HRESULT EncodeElements(
+        _In_reads_(count) const T* buffer,
+        _Out_ uint8_t* ptr, _In_ const uint8_t* eptr, size_t stride,
+        size_t count, bool x2bias)
+    {
+        for (size_t icount = 0; icount < count; ++icount)
+        {
+            if ((ptr + size) > eptr)
+                return E_UNEXPECTED;
+            store(ptr, LoadVertex(buffer++), x2bias);
+            ptr += stride;
+        }
+
+        return S_OK;
+    }
+
+    // Copies float components straight from the source, zero filling as the XMLoadFloat* functions do
+    template<size_t n, class T>
+    HRESULT EncodeFloats(
+        _In_reads_(count) const T* buffer,
+        _Out_ uint8_t* ptr, _In_ const uint8_t* eptr, size_t stride,
+        size_t count, bool)
+    {
+        static_assert(sizeof(T) <= sizeof(float) * 4, "Source too large");
+
+        for (size_t icount = 0; icount < count; ++icount)
+        {
+            if ((ptr + sizeof(float) * n) > eptr)
+                return E_UNEXPECTED;
+            float v[4] = {};
+            memcpy(v, buffer++, sizeof(T));
+            memcpy(ptr, v, sizeof(float) * n);
+            ptr += stride;
+        }
+
+        return S_OK;
+    }
+
+    // Quantized positions take the element's transform, so they are not in the encoder tables
+    template<class T>
+    HRESULT XM_CALLCONV EncodeQuantized(
+        _In_reads_(count) const T* buffer,
+        _Out_ uint8_t* ptr, _In_ const uint8_t* eptr, size_t stride,
+        size_t count, FXMVECTOR invScale, FXMVECTOR bias)
+    {
+        for (size_t icount = 0; icount < count; ++icount)
+        {
+            if ((ptr + sizeof(XMUSHORTN4)) > eptr)
+                return E_UNEXPECTED;
+            XMVECTOR v = XMVectorMultiply(XMVectorSubtract(LoadVertex(buffer++), bias), invScale);
+            StoreQuantizedPosition16(ptr, v, false);
+            ptr += stride;
+        }
+
+        return S_OK;
+    }
+
+    template<class T>
+    using EncodeFunc = HRESULT(*)(const T* buffer, uint8_t* ptr, const uint8_t* eptr, size_t stride, size_t count, bool x2bias);
+
+    struct FormatEncoders
+    {
+        DXGI_FORMAT             format;
+        EncodeFunc<XMVECTOR>    vector;
+        EncodeFunc<float>       float1;
+        EncodeFunc<XMFLOAT2>    float2;
+        EncodeFunc<XMFLOAT3>    float3;
+        EncodeFunc<XMFLOAT4>    float4;
+    };
+
+#define ENCODERS( format, type, store )\
+    { format,\
+      EncodeElements<sizeof(type), store, XMVECTOR>,\
+      EncodeElements<sizeof(type), store, float>,\
+      EncodeElements<sizeof(type), store, XMFLOAT2>,\
+      EncodeElements<sizeof(type), store, XMFLOAT3>,\
+      EncodeElements<sizeof(type), store, XMFLOAT4> }
+
+#define FLOAT_ENCODERS( format, n )\
+    { format,\
+      EncodeFloats<n, XMVECTOR>,\
+      EncodeFloats<n, float>,\
+      EncodeFloats<n, XMFLOAT2>,\
+      EncodeFloats<n, XMFLOAT3>,\
+      EncodeFloats<n, XMFLOAT4> }
+
+    const FormatEncoders g_Encoders[] =
+    {
+        FLOAT_ENCODERS(DXGI_FORMAT_R32G32B32A32_FLOAT, 4),
+        ENCODERS(DXGI_FORMAT_R32G32B32A32_UINT, XMUINT4, StoreR32G32B32A32_UINT),
+        ENCODERS(DXGI_FORMAT_R32G32B32A32_SINT, XMINT4, StoreR32G32B32A32_SINT),
+        FLOAT_ENCODERS(DXGI_FORMAT_R32G32B32_FLOAT, 3),
+        ENCODERS(DXGI_FORMAT_R32G32B32_UINT, XMUINT3, StoreR32G32B32_UINT),
+        ENCODERS(DXGI_FORMAT_R32G32B32_SINT, XMINT3, StoreR32G32B32_SINT),
+        ENCODERS(DXGI_FORMAT_R16G16B16A16_FLOAT, XMHALF4, StoreR16G16B16A16_FLOAT),
+        ENCODERS(DXGI_FORMAT_R16G16B16A16_UNORM, XMUSHORTN4, StoreR16G16B16A16_UNORM),
+        ENCODERS(DXGI_FORMAT_R16G16B16A16_UINT, XMUSHORT4, StoreR16G16B16A16_UINT),
+        ENCODERS(DXGI_FORMAT_R16G16B16A16_SNORM, XMSHORTN4, StoreR16G16B16A16_SNORM),
+        ENCODERS(DXGI_FORMAT_R16G16B16A16_SINT, XMSHORT4, StoreR16G16B16A16_SINT),
+        FLOAT_ENCODERS(DXGI_FORMAT_R32G32_FLOAT, 2),
+        ENCODERS(DXGI_FORMAT_R32G32_UINT, XMUINT2, StoreR32G32_UINT),
+        ENCODERS(DXGI_FORMAT_R32G32_SINT, XMINT2, StoreR32G32_SINT),
+        ENCODERS(DXGI_FORMAT_R10G10B10A2_UNORM, XMUDECN4, StoreR10G10B10A2_UNORM),
+        ENCODERS(DXGI_FORMAT_R10G10B10A2_UINT, XMUDEC4, StoreR10G10B10A2_UINT),
+        ENCODERS(DXGI_FORMAT_R11G11B10_FLOAT, XMFLOAT3PK, StoreR11G11B10_FLOAT),
+        ENCODERS(DXGI_FORMAT_R8G8B8A8_UNORM, XMUBYTEN4, StoreR8G8B8A8_UNORM),
+        ENCODERS(DXGI_FORMAT_R8G8B8A8_UINT, XMUBYTE4, StoreR8G8B8A8_UINT),
+        ENCODERS(DXGI_FORMAT_R8G8B8A8_SNORM, XMBYTEN4, StoreR8G8B8A8_SNORM),
+        ENCODERS(DXGI_FORMAT_R8G8B8A8_SINT, XMBYTE4, StoreR8G8B8A8_SINT),
+        ENCODERS(DXGI_FORMAT_R16G16_FLOAT, XMHALF2, StoreR16G16_FLOAT),
+        ENCODERS(DXGI_FORMAT_R16G16_UNORM, XMUSHORTN2, StoreR16G16_UNORM),
+        ENCODERS(DXGI_FORMAT_R16G16_UINT, XMUSHORT2, StoreR16G16_UINT),
+        ENCODERS(DXGI_FORMAT_R16G16_SNORM, XMSHORTN2, StoreR16G16_SNORM),
+        ENCODERS(DXGI_FORMAT_R16G16_SINT, XMSHORT2, StoreR16G16_SINT),
+        FLOAT_ENCODERS(DXGI_FORMAT_R32_FLOAT, 1),
+        ENCODERS(DXGI_FORMAT_R32_UINT, uint32_t, StoreR32_UINT),
+        ENCODERS(DXGI_FORMAT_R32_SINT, int32_t, StoreR32_SINT),
+        ENCODERS(DXGI_FORMAT_R8G8_UNORM, XMUBYTEN2, StoreR8G8_UNORM),
+        ENCODERS(DXGI_FORMAT_R8G8_UINT, XMUBYTE2, StoreR8G8_UINT),
+        ENCODERS(DXGI_FORMAT_R8G8_SNORM, XMBYTEN2, StoreR8G8_SNORM),
+        ENCODERS(DXGI_FORMAT_R8G8_SINT, XMBYTE2, StoreR8G8_SINT),
+        ENCODERS(DXGI_FORMAT_R16_FLOAT, HALF, StoreR16_FLOAT),
+        ENCODERS(DXGI_FORMAT_R16_UNORM, uint16_t, StoreR16_UNORM),
+        ENCODERS(DXGI_FORMAT_R16_UINT, uint16_t, StoreR16_UINT),
+        ENCODERS(DXGI_FORMAT_R16_SNORM, int16_t, StoreR16_SNORM),
+        ENCODERS(DXGI_FORMAT_R16_SINT, int16_t, StoreR16_SINT),
+        ENCODERS(DXGI_FORMAT_R8_UNORM, uint8_t, StoreR8_UNORM),
+        ENCODERS(DXGI_FORMAT_R8_UINT, uint8_t, StoreR8_UINT),
+        ENCODERS(DXGI_FORMAT_R8_SNORM, int8_t, StoreR8_SNORM),
+        ENCODERS(DXGI_FORMAT_R8_SINT, int8_t, StoreR8_SINT),
+        ENCODERS(DXGI_FORMAT_B5G6R5_UNORM, XMU565, StoreB5G6R5_UNORM),
+        ENCODERS(DXGI_FORMAT_B5G5R5A1_UNORM, XMU555, StoreB5G5R5A1_UNORM),
+        ENCODERS(DXGI_FORMAT_B8G8R8A8_UNORM, XMUBYTEN4, StoreB8G8R8A8_UNORM),
+        ENCODERS(DXGI_FORMAT_B8G8R8X8_UNORM, XMUBYTEN4, StoreB8G8R8X8_UNORM),
+        ENCODERS(DXGI_FORMAT_B4G4R4A4_UNORM, XMUNIBBLE4, StoreB4G4R4A4_UNORM),
+
+        // Xbox One specific format
+        ENCODERS(XBOX_DXGI_FORMAT_R10G10B10_SNORM_A2_UNORM, XMXDECN4, StoreR10G10B10_SNORM_A2_UNORM),
+
+        // Virtual formats
+        ENCODERS(VBFORMAT_OCTAHEDRAL_NORMAL_8, XMBYTEN2, StoreOctahedralNormal8),
+        ENCODERS(VBFORMAT_OCTAHEDRAL_NORMAL_16, XMSHORTN2, StoreOctahedralNormal16),
+        ENCODERS(VBFORMAT_OCTAHEDRAL_TANGENT_8, XMBYTEN4, StoreOctahedralTangent8),
+        ENCODERS(VBFORMAT_OCTAHEDRAL_TANGENT_16, XMSHORTN4, StoreOctahedralTangent16),
+        ENCODERS(VBFORMAT_QUANTIZED_POSITION_16, XMUSHORTN4, StoreQuantizedPosition16),
+    };
+
+#undef ENCODERS
+#undef FLOAT_ENCODERS
+
+#ifdef _XM_SSE_INTRINSICS_
+    //---------------------------------------------------------------------------------
+    // AVX2 + F16C batch encoders, converting 8 elements per iteration
+    //---------------------------------------------------------------------------------
+
+    const size_t c_Batch = 8;
+
+    // Rounding of the scaled components, as done by the DirectXMath store for the format
+    enum PACKED_ROUNDING
+    {
+        ROUND_NEAREST = 0,  // Convert under the default round to nearest even mode
+        ROUND_HALF_UP,      // Add one half, then truncate
+        ROUND_TRUNCATE,
+    };
+
+    // Describes a format whose element is one or two dwords of packed integer fields, with
+    // x and y in the first dword and z and w in the second for two dword elements.
+    // Each component is encoded exactly as the scalar storer does it, that is the optional
+    // x2bias remap, then the clamp, scale and rounding of the DirectXMath store.
+    struct PackedEncoding
+    {
+        int32_t         shift[4];       // Bit offset of the field in its dword
+        uint32_t        bits[4];        // Field mask, zero for components that are not stored
+        float           minimum[4];
+        float           maximum[4];
+        float           scale[4];
+        uint32_t        x2bias[4];      // Components remapped from [-1,1] by x2bias
+        PACKED_ROUNDING rounding;
+        bool            bgr;            // Swizzle R,G,B,A to B,G,R,A
+    };
+
+    const uint32_t c_On = 0xFFFFFFFF;
+
+    const PackedEncoding s_R16G16B16A16_UNORM =
+    {
+        { 0, 16, 0, 16 }, { 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF },
+        { 0.f, 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f, 1.f }, { 65535.f, 65535.f, 65535.f, 65535.f },
+        { c_On, c_On, c_On, c_On }, ROUND_HALF_UP, false
+    };
+
+    const PackedEncoding s_R16G16B16A16_SNORM =
+    {
+        { 0, 16, 0, 16 }, { 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF },
+        { -1.f, -1.f, -1.f, -1.f }, { 1.f, 1.f, 1.f, 1.f }, { 32767.f, 32767.f, 32767.f, 32767.f },
+        {}, ROUND_NEAREST, false
+    };
+
+    const PackedEncoding s_R10G10B10A2_UNORM =
+    {
+        { 0, 10, 20, 30 }, { 0x3FF, 0x3FF, 0x3FF, 0x3 },
+        { 0.f, 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f, 1.f }, { 1023.f, 1023.f, 1023.f, 3.f },
+        { c_On, c_On, c_On, 0 }, ROUND_TRUNCATE, false
+    };
+
+    const PackedEncoding s_R8G8B8A8_UNORM =
+    {
+        { 0, 8, 16, 24 }, { 0xFF, 0xFF, 0xFF, 0xFF },
+        { 0.f, 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f, 1.f }, { 255.f, 255.f, 255.f, 255.f },
+        { c_On, c_On, c_On, c_On }, ROUND_NEAREST, false
+    };
+
+    const PackedEncoding s_R8G8B8A8_SNORM =
+    {
+        { 0, 8, 16, 24 }, { 0xFF, 0xFF, 0xFF, 0xFF },
+        { -1.f, -1.f, -1.f, -1.f }, { 1.f, 1.f, 1.f, 1.f }, { 127.f, 127.f, 127.f, 127.f },
+        {}, ROUND_NEAREST, false
+    };
+
+    const PackedEncoding s_R16G16_UNORM =
+    {
+        { 0, 16, 0, 0 }, { 0xFFFF, 0xFFFF, 0, 0 },
+        { 0.f, 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f, 1.f }, { 65535.f, 65535.f, 65535.f, 65535.f },
+        { c_On, c_On, 0, 0 }, ROUND_HALF_UP, false
+    };
+
+    const PackedEncoding s_R16G16_SNORM =
+    {
+        { 0, 16, 0, 0 }, { 0xFFFF, 0xFFFF, 0, 0 },
+        { -1.f, -1.f, -1.f, -1.f }, { 1.f, 1.f, 1.f, 1.f }, { 32767.f, 32767.f, 32767.f, 32767.f },
+        {}, ROUND_NEAREST, false
+    };
+
+    const PackedEncoding s_R8G8_UNORM =
+    {
+        { 0, 8, 0, 0 }, { 0xFF, 0xFF, 0, 0 },
+        { 0.f, 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f, 1.f }, { 255.f, 255.f, 255.f, 255.f },
+        { c_On, c_On, 0, 0 }, ROUND_NEAREST, false
+    };
+
+    const PackedEncoding s_R8G8_SNORM =
+    {
+        { 0, 8, 0, 0 }, { 0xFF, 0xFF, 0, 0 },
+        { -1.f, -1.f, -1.f, -1.f }, { 1.f, 1.f, 1.f, 1.f }, { 127.f, 127.f, 127.f, 127.f },
+        {}, ROUND_NEAREST, false
+    };
+
+    const PackedEncoding s_B8G8R8A8_UNORM =
+    {
+        { 0, 8, 16, 24 }, { 0xFF, 0xFF, 0xFF, 0xFF },
+        { 0.f, 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f, 1.f }, { 255.f, 255.f, 255.f, 255.f },
+        { c_On, c_On, c_On, c_On }, ROUND_NEAREST, true
+    };
+
+    const PackedEncoding s_B8G8R8X8_UNORM =
+    {
+        { 0, 8, 16, 24 }, { 0xFF, 0xFF, 0xFF, 0 },
+        { 0.f, 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f, 1.f }, { 255.f, 255.f, 255.f, 255.f },
+        { c_On, c_On, c_On, c_On }, ROUND_NEAREST, true
+    };
+
+    // Only VEX encoded instructions are used while the upper halves of the YMM registers are live,
+    // and each batch ends with vzeroupper so the SSE code that follows pays no transition
+    inline __m256 BroadcastLanes(_In_reads_(4) const void* lanes)
+    {
+        return _mm256_broadcast_ps(static_cast<const __m128*>(lanes));
+    }
+
+    // Converts a pair of elements, one per 128-bit lane, to their integer fields shifted in place
+    template<const PackedEncoding& layout>
+    inline __m256i ConvertPacked(__m256 f, bool x2bias)
+    {
+        if (layout.bgr)
+        {
+            f = _mm256_permute_ps(f, _MM_SHUFFLE(3, 0, 1, 2));
+        }
+
+        if (x2bias)
+        {
+            // Same operations as XMVectorClamp and XMVectorMultiplyAdd, without fused multiply-add
+            __m256 f2 = _mm256_min_ps(_mm256_max_ps(f, _mm256_set1_ps(-1.f)), _mm256_set1_ps(1.f));
+            f2 = _mm256_add_ps(_mm256_mul_ps(f2, _mm256_set1_ps(0.5f)), _mm256_set1_ps(0.5f));
+            f = _mm256_blendv_ps(f, f2, BroadcastLanes(layout.x2bias));
+        }
+
+        // NaN clamps to the minimum, as the store does with the vector as the first operand
+        f = _mm256_max_ps(f, BroadcastLanes(layout.minimum));
+        f = _mm256_min_ps(f, BroadcastLanes(layout.maximum));
+        f = _mm256_mul_ps(f, BroadcastLanes(layout.scale));
+
+        __m256i v;
+        switch (layout.rounding)
+        {
+        case ROUND_HALF_UP:
+            v = _mm256_cvttps_epi32(_mm256_add_ps(f, _mm256_set1_ps(0.5f)));
+            break;
+
+        case ROUND_TRUNCATE:
+            v = _mm256_cvttps_epi32(f);
+            break;
+
+        default:
+            v = _mm256_cvtps_epi32(f);
+            break;
+        }
+
+        v = _mm256_and_si256(v, _mm256_castps_si256(BroadcastLanes(layout.bits)));
+        return _mm256_sllv_epi32(v, _mm256_castps_si256(BroadcastLanes(layout.shift)));
+    }
+
+    // Elements of one dword, or less
+    template<size_t size, const PackedEncoding& layout>
+    void EncodePacked32(_Out_ uint8_t* ptr, size_t stride, _In_reads_(c_Batch) const XMVECTOR* in, bool x2bias)
+    {
+        __m256i pairs[c_Batch / 2];
+        for (size_t j = 0; j < c_Batch / 2; ++j)
+        {
+            __m256i v = ConvertPacked<layout>(_mm256_loadu_ps(reinterpret_cast<const float*>(in + j * 2)), x2bias);
+
+            // Combine the fields so dword 0 of each lane holds the element
+            v = _mm256_or_si256(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+            pairs[j] = _mm256_or_si256(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+
+        // The lanes hold elements 0, 2, 4, 6 and 1, 3, 5, 7
+        const __m256i lo = _mm256_unpacklo_epi32(pairs[0], pairs[1]);
+        const __m256i hi = _mm256_unpacklo_epi32(pairs[2], pairs[3]);
+        const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(lo, hi), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+
+        uint32_t out[c_Batch];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+        _mm256_zeroupper();
+
+        for (size_t j = 0; j < c_Batch; ++j)
+        {
+            memcpy(ptr, &out[j], size);
+            ptr += stride;
+        }
+    }
+
+    // Elements of two dwords
+    template<const PackedEncoding& layout>
+    void EncodePacked64(_Out_ uint8_t* ptr, size_t stride, _In_reads_(c_Batch) const XMVECTOR* in, bool x2bias)
+    {
+        __m256i pairs[c_Batch / 2];
+        for (size_t j = 0; j < c_Batch / 2; ++j)
+        {
+            __m256i v = ConvertPacked<layout>(_mm256_loadu_ps(reinterpret_cast<const float*>(in + j * 2)), x2bias);
+
+            // Combine the fields so the low qword of each lane holds the element
+            v = _mm256_or_si256(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+            pairs[j] = _mm256_shuffle_epi32(v, _MM_SHUFFLE(3, 1, 2, 0));
+        }
+
+        uint64_t out[c_Batch];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(pairs[0], pairs[1]), _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4), _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(pairs[2], pairs[3]), _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm256_zeroupper();
+
+        for (size_t j = 0; j < c_Batch; ++j)
+        {
+            memcpy(ptr, &out[j], sizeof(uint64_t));
+            ptr += stride;
+        }
+    }
+
+    // Rounds to nearest even, as XMConvertFloatToHalf does
+    template<size_t size>
+    void EncodeHalf(_Out_ uint8_t* ptr, size_t stride, _In_reads_(c_Batch) const XMVECTOR* in, bool)
+    {
+        uint64_t out[c_Batch];
+        for (size_t j = 0; j < c_Batch; j += 2)
+        {
+            const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(reinterpret_cast<const float*>(in + j)), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j), h);
+        }
+        _mm256_zeroupper();
+
+        for (size_t j = 0; j < c_Batch; ++j)
+        {
+            memcpy(ptr, &out[j], size);
+            ptr += stride;
+        }
+    }
+
+    // Encodes whole batches while they fit in the buffer, and the rest with the scalar storer
+    template<size_t size, void(XM_CALLCONV *store)(uint8_t*, FXMVECTOR, bool), void(*batch)(uint8_t*, size_t, const XMVECTOR*, bool), class T>
+    HRESULT EncodeBatched(
+        _In_reads_(count) const T* buffer,
+        _Out_ uint8_t* ptr, _In_ const uint8_t* eptr, size_t stride,
+        size_t count, bool x2bias)
+    {
+        for (; count >= c_Batch; count -= c_Batch)
+        {
+            if ((ptr + stride * (c_Batch - 1) + size) > eptr)
+                break;
+
+            XMVECTOR v[c_Batch];
+            for (size_t j = 0; j < c_Batch; ++j)
+            {
+                v[j] = LoadVertex(buffer++);
+            }
+
+            batch(ptr, stride, v, x2bias);
+
+            ptr += stride * c_Batch;
+        }
+
+        return EncodeElements<size, store>(buffer, ptr, eptr, stride, count, x2bias);
+    }
+
+#define BATCH_ENCODERS( format, type, store, batch )\
+    { format,\
+      EncodeBatched<sizeof(type), store, batch, XMVECTOR>,\
+      EncodeBatched<sizeof(type), store, batch, float>,\
+      EncodeBatched<sizeof(type), store, batch, XMFLOAT2>,\
+      EncodeBatched<sizeof(type), store, batch, XMFLOAT3>,\
+      EncodeBatched<sizeof(type), store, batch, XMFLOAT4> }
+
+    const FormatEncoders g_EncodersAVX2[] =
+    {
+        BATCH_ENCODERS(DXGI_FORMAT_R16G16B16A16_FLOAT, XMHALF4, StoreR16G16B16A16_FLOAT, EncodeHalf<sizeof(XMHALF4)>),
+        BATCH_ENCODERS(DXGI_FORMAT_R16G16B16A16_UNORM, XMUSHORTN4, StoreR16G16B16A16_UNORM, EncodePacked64<s_R16G16B16A16_UNORM>),
+        BATCH_ENCODERS(DXGI_FORMAT_R16G16B16A16_SNORM, XMSHORTN4, StoreR16G16B16A16_SNORM, EncodePacked64<s_R16G16B16A16_SNORM>),
+        BATCH_ENCODERS(DXGI_FORMAT_R10G10B10A2_UNORM, XMUDECN4, StoreR10G10B10A2_UNORM, (EncodePacked32<sizeof(XMUDECN4), s_R10G10B10A2_UNORM>)),
+        BATCH_ENCODERS(DXGI_FORMAT_R8G8B8A8_UNORM, XMUBYTEN4, StoreR8G8B8A8_UNORM, (EncodePacked32<sizeof(XMUBYTEN4), s_R8G8B8A8_UNORM>)),
+        BATCH_ENCODERS(DXGI_FORMAT_R8G8B8A8_SNORM, XMBYTEN4, StoreR8G8B8A8_SNORM, (EncodePacked32<sizeof(XMBYTEN4), s_R8G8B8A8_SNORM>)),
+        BATCH_ENCODERS(DXGI_FORMAT_R16G16_FLOAT, XMHALF2, StoreR16G16_FLOAT, EncodeHalf<sizeof(XMHALF2)>),
+        BATCH_ENCODERS(DXGI_FORMAT_R16G16_UNORM, XMUSHORTN2, StoreR16G16_UNORM, (EncodePacked32<sizeof(XMUSHORTN2), s_R16G16_UNORM>)),
+        BATCH_ENCODERS(DXGI_FORMAT_R16G16_SNORM, XMSHORTN2, StoreR16G16_SNORM, (EncodePacked32<sizeof(XMSHORTN2), s_R16G16_SNORM>)),
+        BATCH_ENCODERS(DXGI_FORMAT_R8G8_UNORM, XMUBYTEN2, StoreR8G8_UNORM, (EncodePacked32<sizeof(XMUBYTEN2), s_R8G8_UNORM>)),
+        BATCH_ENCODERS(DXGI_FORMAT_R8G8_SNORM, XMBYTEN2, StoreR8G8_SNORM, (EncodePacked32<sizeof(XMBYTEN2), s_R8G8_SNORM>)),
+        BATCH_ENCODERS(DXGI_FORMAT_B8G8R8A8_UNORM, XMUBYTEN4, StoreB8G8R8A8_UNORM, (EncodePacked32<sizeof(XMUBYTEN4), s_B8G8R8A8_UNORM>)),
+        BATCH_ENCODERS(DXGI_FORMAT_B8G8R8X8_UNORM, XMUBYTEN4, StoreB8G8R8X8_UNORM, (EncodePacked32<sizeof(XMUBYTEN4), s_B8G8R8X8_UNORM>)),
+    };
+
+#undef BATCH_ENCODERS
+#endif // _XM_SSE_INTRINSICS_
+
+    const FormatEncoders* GetEncoders(DXGI_FORMAT format)
+    {
+#ifdef _XM_SSE_INTRINSICS_
+        if (IsAVX2Supported())
+        {
+            for (size_t j = 0; j < _countof(g_EncodersAVX2); ++j)
+            {
+                if (g_EncodersAVX2[j].format == format)
+                    return &g_EncodersAVX2[j];
+            }
+        }
+#endif
+
+        for (size_t j = 0; j < _countof(g_Encoders); ++j)
+        {
+            if (g_Encoders[j].format == format)
+                return &g_Encoders[j];
+        }
+
+        return nullptr;
+    }
+
+    inline EncodeFunc<XMVECTOR> GetEncoder(const FormatEncoders& encoders, const XMVECTOR*) { return encoders.vector; }
+    inline EncodeFunc<float> GetEncoder(const FormatEncoders& encoders, const float*) { return encoders.float1; }
+    inline EncodeFunc<XMFLOAT2> GetEncoder(const FormatEncoders& encoders, const XMFLOAT2*) { return encoders.float2; }
+    inline EncodeFunc<XMFLOAT3> GetEncoder(const FormatEncoders& encoders, const XMFLOAT3*) { return encoders.float3; }
+    inline EncodeFunc<XMFLOAT4> GetEncoder(const FormatEncoders& encoders, const XMFLOAT4*) { return encoders.float4; }
 }
 
+
 class VBWriter::Impl
 {
 public:
@@ -61,21 +789,38 @@ public:
         mBuffers{},
         mVerts{},
         mDefaultStrides{},
-        mTempSize(0) {}
+        mThreads(0) {}
 
     HRESULT Initialize(_In_reads_(nDecl) const InputElementDesc* vbDecl, size_t nDecl);
     HRESULT AddStream(_Out_writes_bytes_(stride*nVerts) void* vb, size_t nVerts, size_t inputSlot, size_t stride);
-    HRESULT Write(_In_reads_(count) const XMVECTOR* buffer, _In_z_ const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const;
+    HRESULT GetHandle(_In_z_ const char* semanticName, unsigned int semanticIndex, _Out_ Handle& handle) const;
+    template<class T>
+    HRESULT Write(_In_reads_(count) const T* buffer, const Handle& handle, size_t count, bool x2bias) const;
+    template<class T>
+    HRESULT Write(_In_reads_(count) const T* buffer, _In_z_ const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const;
+
+    HRESULT SetQuantization(_In_z_ const char* semanticName, unsigned int semanticIndex, const XMFLOAT3& scale, const XMFLOAT3& bias);
+
+    void SetThreadCount(size_t threads) noexcept
+    {
+#ifdef _OPENMP
+        // num_threads takes an int, so never ask for more than the runtime would use anyway
+        const size_t maxThreads = static_cast<size_t>(std::max(omp_get_max_threads(), 1));
+        mThreads = std::min(threads, maxThreads);
+#else
+        mThreads = threads;
+#endif
+    }
 
     void Release()
     {
         mInputDesc.clear();
+        mQuantization.clear();
         mSemantics.clear();
         memset(mStrides, 0, sizeof(mStrides));
         memset(mBuffers, 0, sizeof(mBuffers));
         memset(mVerts, 0, sizeof(mVerts));
         memset(mDefaultStrides, 0, sizeof(mDefaultStrides));
-        mTempBuffer.reset();
     }
 
     const InputElementDesc* GetElement(_In_z_ const char* semanticName, _In_ unsigned int semanticIndex) const
@@ -95,39 +840,39 @@ public:
         return &mInputDesc[it->second];
     }
 
-    XMVECTOR* GetTemporaryBuffer(size_t count) const
-    {
-        if (!mTempBuffer || (mTempSize < count))
-        {
-            mTempSize = count;
+private:
+    typedef std::multimap<std::string, uint32_t> SemanticMap;
 
-            for (size_t j = 0; j < c_MaxSlot; ++j)
-            {
-                if (mVerts[j] > mTempSize)
-                    mTempSize = mVerts[j];
-            }
+    // Kept as the inverse scale, with 0 for flat axes
+    struct Quantization
+    {
+        XMFLOAT3 invScale;
+        XMFLOAT3 bias;
+    };
 
-            mTempBuffer.reset(static_cast<XMVECTOR*>(_aligned_malloc(sizeof(XMVECTOR) * mTempSize, 16)));
-            if (!mTempBuffer)
-                mTempSize = 0;
+    const Quantization& GetQuantization(const Handle& handle) const
+    {
+        for (size_t j = 0; j < mInputDesc.size(); ++j)
+        {
+            if (mInputDesc[j].InputSlot == handle.slot && mInputDesc[j].AlignedByteOffset == handle.offset)
+                return mQuantization[j];
         }
 
-        return mTempBuffer.get();
+        static const Quantization s_identity = { XMFLOAT3(1.f, 1.f, 1.f), XMFLOAT3(0.f, 0.f, 0.f) };
+        return s_identity;
     }
 
-private:
-    typedef std::multimap<std::string, uint32_t> SemanticMap;
-
     std::vector<InputElementDesc>           mInputDesc;
+    std::vector<Quantization>               mQuantization;
     SemanticMap                             mSemantics;
     uint32_t                                mStrides[c_MaxSlot];
     void*                                   mBuffers[c_MaxSlot];
     size_t                                  mVerts[c_MaxSlot];
     uint32_t                                mDefaultStrides[c_MaxSlot];
-    mutable size_t                          mTempSize;
-    mutable ScopedAlignedArrayXMVECTOR      mTempBuffer;
+    size_t                                  mThreads;
 };
 
+
 //-------------------------------------------------------------------------------------
 _Use_decl_annotations_
 HRESULT VBWriter::Impl::Initialize(const InputElementDesc* vbDecl, size_t nDecl)
@@ -170,6 +915,9 @@ HRESULT VBWriter::Impl::Initialize(const InputElementDesc* vbDecl, size_t nDecl)
 
         mInputDesc[j].AlignedByteOffset = offsets[j];
 
+        Quantization identity = { XMFLOAT3(1.f, 1.f, 1.f), XMFLOAT3(0.f, 0.f, 0.f) };
+        mQuantization.push_back(identity);
+
         auto decl = SemanticMap::value_type(vbDecl[j].SemanticName, j);
         mSemantics.insert(decl);
 
@@ -215,424 +963,131 @@ HRESULT VBWriter::Impl::AddStream(void* vb, size_t nVerts, size_t inputSlot, siz
 
 
 //-------------------------------------------------------------------------------------
-#define STORE_VERTS( type, func )\
-        for(size_t icount = 0; icount < count; ++icount)\
-        {\
-            if ((ptr + sizeof(type)) > eptr)\
-                return E_UNEXPECTED;\
-            func(reinterpret_cast<type*>(ptr), *buffer++);\
-            ptr += stride;\
-        }\
-        break;
-
-#define STORE_VERTS_X2( type, func, x2bias )\
-        for(size_t icount = 0; icount < count; ++icount)\
-        {\
-            if ((ptr + sizeof(type)) > eptr)\
-                return E_UNEXPECTED;\
-            XMVECTOR v = *buffer++;\
-            if (x2bias)\
-            {\
-                v = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);\
-                v = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);\
-            }\
-            func(reinterpret_cast<type*>(ptr), v);\
-            ptr += stride;\
-        }\
-        break;
-
 _Use_decl_annotations_
-HRESULT VBWriter::Impl::Write(const XMVECTOR* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+HRESULT VBWriter::Impl::GetHandle(const char* semanticName, unsigned int semanticIndex, Handle& handle) const
 {
-    if (!buffer || !semanticName || !count)
+    handle = {};
+
+    if (!semanticName)
         return E_INVALIDARG;
 
-    auto range = mSemantics.equal_range(semanticName);
+    auto desc = GetElement(semanticName, semanticIndex);
+    if (!desc)
+        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
 
-    auto it = range.first;
-    for (; it != range.second; ++it)
-    {
-        if (mInputDesc[it->second].SemanticIndex == semanticIndex)
-            break;
-    }
+    auto encoders = GetEncoders(desc->Format);
+    if (!encoders)
+        return E_FAIL;
 
-    if (it == range.second)
-        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
+    handle.slot = desc->InputSlot;
+    handle.offset = desc->AlignedByteOffset;
+    handle.codec = encoders;
+
+    return S_OK;
+}
+
+
+//-------------------------------------------------------------------------------------
+template<class T>
+_Use_decl_annotations_
+HRESULT VBWriter::Impl::Write(const T* buffer, const Handle& handle, size_t count, bool x2bias) const
+{
+    if (!buffer || !count)
+        return E_INVALIDARG;
 
-    uint32_t inputSlot = mInputDesc[it->second].InputSlot;
+    if (!handle.codec || handle.slot >= c_MaxSlot)
+        return E_INVALIDARG;
 
-    auto vb = static_cast<uint8_t*>(mBuffers[inputSlot]);
+    auto vb = static_cast<uint8_t*>(mBuffers[handle.slot]);
     if (!vb)
         return E_FAIL;
 
-    if (count > mVerts[inputSlot])
+    if (count > mVerts[handle.slot])
         return E_BOUNDS;
 
-    uint32_t stride = mStrides[inputSlot];
+    uint32_t stride = mStrides[handle.slot];
     if (!stride)
         return E_UNEXPECTED;
 
-    const uint8_t* eptr = vb + stride * mVerts[inputSlot];
-    uint8_t* ptr = vb + mInputDesc[it->second].AlignedByteOffset;
+    const uint8_t* eptr = vb + stride * mVerts[handle.slot];
+    uint8_t* ptr = vb + handle.offset;
 
-    switch (static_cast<int>(mInputDesc[it->second].Format))
+    auto encoders = static_cast<const FormatEncoders*>(handle.codec);
+    if (encoders->format == VBFORMAT_QUANTIZED_POSITION_16)
     {
-    case DXGI_FORMAT_R32G32B32A32_FLOAT:
-        STORE_VERTS(XMFLOAT4, XMStoreFloat4)
-
-    case DXGI_FORMAT_R32G32B32A32_UINT:
-        STORE_VERTS(XMUINT4, XMStoreUInt4)
-
-    case DXGI_FORMAT_R32G32B32A32_SINT:
-        STORE_VERTS(XMINT4, XMStoreSInt4)
-
-    case DXGI_FORMAT_R32G32B32_FLOAT:
-        STORE_VERTS(XMFLOAT3, XMStoreFloat3)
-
-    case DXGI_FORMAT_R32G32B32_UINT:
-        STORE_VERTS(XMUINT3, XMStoreUInt3)
-
-    case DXGI_FORMAT_R32G32B32_SINT:
-        STORE_VERTS(XMINT3, XMStoreSInt3)
-
-    case DXGI_FORMAT_R16G16B16A16_FLOAT:
-        STORE_VERTS(XMHALF4, XMStoreHalf4)
-
-    case DXGI_FORMAT_R16G16B16A16_UNORM:
-        STORE_VERTS_X2(XMUSHORTN4, XMStoreUShortN4, x2bias)
-
-    case DXGI_FORMAT_R16G16B16A16_UINT:
-        STORE_VERTS(XMUSHORT4, XMStoreUShort4)
-
-    case DXGI_FORMAT_R16G16B16A16_SNORM:
-        STORE_VERTS(XMSHORTN4, XMStoreShortN4)
-
-    case DXGI_FORMAT_R16G16B16A16_SINT:
-        STORE_VERTS(XMSHORT4, XMStoreShort4)
-
-    case DXGI_FORMAT_R32G32_FLOAT:
-        STORE_VERTS(XMFLOAT2, XMStoreFloat2)
-
-    case DXGI_FORMAT_R32G32_UINT:
-        STORE_VERTS(XMUINT2, XMStoreUInt2)
-
-    case DXGI_FORMAT_R32G32_SINT:
-        STORE_VERTS(XMINT2, XMStoreSInt2)
-
-    case DXGI_FORMAT_R10G10B10A2_UNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMUDECN4)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = *buffer++;
-            if (x2bias)
-            {
-                XMVECTOR v2 = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
-                v2 = XMVectorMultiplyAdd(v2, g_XMOneHalf, g_XMOneHalf);
-                v = XMVectorSelect(v, v2, g_XMSelect1110);
-            }
-            XMStoreUDecN4(reinterpret_cast<XMUDECN4*>(ptr), v);
-            ptr += stride;
-        }
-        break;
-
-    case DXGI_FORMAT_R10G10B10A2_UINT:
-        STORE_VERTS(XMUDEC4, XMStoreUDec4);
-
-    case DXGI_FORMAT_R11G11B10_FLOAT:
-        STORE_VERTS_X2(XMFLOAT3PK, XMStoreFloat3PK, x2bias)
-
-    case DXGI_FORMAT_R8G8B8A8_UNORM:
-        STORE_VERTS_X2(XMUBYTEN4, XMStoreUByteN4, x2bias)
-
-    case DXGI_FORMAT_R8G8B8A8_UINT:
-        STORE_VERTS(XMUBYTE4, XMStoreUByte4)
-
-    case DXGI_FORMAT_R8G8B8A8_SNORM:
-        STORE_VERTS(XMBYTEN4, XMStoreByteN4)
-
-    case DXGI_FORMAT_R8G8B8A8_SINT:
-        STORE_VERTS(XMBYTE4, XMStoreByte4)
-
-    case DXGI_FORMAT_R16G16_FLOAT:
-        STORE_VERTS(XMHALF2, XMStoreHalf2)
-
-    case DXGI_FORMAT_R16G16_UNORM:
-        STORE_VERTS_X2(XMUSHORTN2, XMStoreUShortN2, x2bias)
-
-    case DXGI_FORMAT_R16G16_UINT:
-        STORE_VERTS(XMUSHORT2, XMStoreUShort2)
-
-    case DXGI_FORMAT_R16G16_SNORM:
-        STORE_VERTS(XMSHORTN2, XMStoreShortN2)
-
-    case DXGI_FORMAT_R16G16_SINT:
-        STORE_VERTS(XMSHORT2, XMStoreShort2)
-
-    case DXGI_FORMAT_R32_FLOAT:
-        STORE_VERTS(float, XMStoreFloat)
-
-    case DXGI_FORMAT_R32_UINT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(uint32_t)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMConvertVectorFloatToUInt(*buffer++, 0);
-            XMStoreInt(reinterpret_cast<uint32_t*>(ptr), v);
-            ptr += stride;
-        }
-        break;
-
-    case DXGI_FORMAT_R32_SINT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(int32_t)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMConvertVectorFloatToInt(*buffer++, 0);
-            XMStoreInt(reinterpret_cast<uint32_t*>(ptr), v);
-            ptr += stride;
-        }
-        break;
-
-    case DXGI_FORMAT_R8G8_UNORM:
-        STORE_VERTS_X2(XMUBYTEN2, XMStoreUByteN2, x2bias)
-
-    case DXGI_FORMAT_R8G8_UINT:
-        STORE_VERTS(XMUBYTE2, XMStoreUByte2)
-
-    case DXGI_FORMAT_R8G8_SNORM:
-        STORE_VERTS(XMBYTEN2, XMStoreByteN2)
-
-    case DXGI_FORMAT_R8G8_SINT:
-        STORE_VERTS(XMBYTE2, XMStoreByte2)
-
-    case DXGI_FORMAT_R16_FLOAT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(HALF)) > eptr)
-                return E_UNEXPECTED;
-            float f = XMVectorGetX(*buffer++);
-            *reinterpret_cast<HALF*>(ptr) = XMConvertFloatToHalf(f);
-            ptr += stride;
-        }
-        break;
+        auto& quantization = GetQuantization(handle);
+        return EncodeQuantized(buffer, ptr, eptr, stride, count,
+            XMLoadFloat3(&quantization.invScale), XMLoadFloat3(&quantization.bias));
+    }
 
-    case DXGI_FORMAT_R16_UNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(uint16_t)) > eptr)
-                return E_UNEXPECTED;
-            float f = XMVectorGetX(*buffer++);
-            if (x2bias)
-            {
-                f = std::max<float>(std::min<float>(f, 1.f), -1.f);
-                f = f * 0.5f + 0.5f;
-            }
-            else
-            {
-                f = std::max<float>(std::min<float>(f, 1.f), 0.f);
-            }
-            *reinterpret_cast<uint16_t*>(ptr) = static_cast<uint16_t>(f*65535.f + 0.5f);
-            ptr += stride;
-        }
-        break;
+    auto encode = GetEncoder(*encoders, buffer);
 
-    case DXGI_FORMAT_R16_UINT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(uint16_t)) > eptr)
-                return E_UNEXPECTED;
-            float f = XMVectorGetX(*buffer++);
-            f = std::max<float>(std::min<float>(f, 65535.f), 0.f);
-            *reinterpret_cast<uint16_t*>(ptr) = static_cast<uint16_t>(f);
-            ptr += stride;
-        }
-        break;
+#ifdef _OPENMP
+    if (mThreads > 1 && count > c_ParallelBlock)
+    {
+        // Each block is an independent range of elements, so no scratch is shared between threads
+        const int blockCount = static_cast<int>((count + c_ParallelBlock - 1) / c_ParallelBlock);
 
-    case DXGI_FORMAT_R16_SNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(int16_t)) > eptr)
-                return E_UNEXPECTED;
-            float f = XMVectorGetX(*buffer++);
-            f = std::max<float>(std::min<float>(f, 1.f), -1.f);
-            *reinterpret_cast<int16_t*>(ptr) = static_cast<int16_t>(f * 32767.f);
-            ptr += stride;
-        }
-        break;
+        HRESULT hr = S_OK;
 
-    case DXGI_FORMAT_R16_SINT:
-        for (size_t icount = 0; icount < count; ++icount)
+        #pragma omp parallel for num_threads(static_cast<int>(mThreads))
+        for (int block = 0; block < blockCount; ++block)
         {
-            if ((ptr + sizeof(int16_t)) > eptr)
-                return E_UNEXPECTED;
-            float f = XMVectorGetX(*buffer++);
-            f = std::max<float>(std::min<float>(f, 32767.f), -32767.f);
-            *reinterpret_cast<int16_t*>(ptr) = static_cast<int16_t>(f);
-            ptr += stride;
-        }
-        break;
+            size_t first = size_t(block) * c_ParallelBlock;
+            size_t blockSize = std::min(c_ParallelBlock, count - first);
 
-    case DXGI_FORMAT_R8_UNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(uint8_t)) > eptr)
-                return E_UNEXPECTED;
-            float f = XMVectorGetX(*buffer++);
-            if (x2bias)
+            HRESULT hrBlock = encode(buffer + first, ptr + first * stride, eptr, stride, blockSize, x2bias);
+            if (FAILED(hrBlock))
             {
-                f = std::max<float>(std::min<float>(f, 1.f), -1.f);
-                f = f * 0.5f + 0.5f;
+                #pragma omp critical
+                hr = hrBlock;
             }
-            else
-            {
-                f = std::max<float>(std::min<float>(f, 1.f), 0.f);
-            }
-            *ptr = static_cast<uint8_t>(f * 255.f);
-            ptr += stride;
         }
-        break;
 
-    case DXGI_FORMAT_R8_UINT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(uint8_t)) > eptr)
-                return E_UNEXPECTED;
-            float f = XMVectorGetX(*buffer++);
-            f = std::max<float>(std::min<float>(f, 255.f), 0.f);
-            *ptr = static_cast<uint8_t>(f);
-            ptr += stride;
-        }
-        break;
+        return hr;
+    }
+#endif
 
-    case DXGI_FORMAT_R8_SNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(int8_t)) > eptr)
-                return E_UNEXPECTED;
-            float f = XMVectorGetX(*buffer++);
-            f = std::max<float>(std::min<float>(f, 1.f), -1.f);
-            *reinterpret_cast<int8_t*>(ptr) = static_cast<int8_t>(f * 127.f);
-            ptr += stride;
-        }
-        break;
+    return encode(buffer, ptr, eptr, stride, count, x2bias);
+}
 
-    case DXGI_FORMAT_R8_SINT:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(int8_t)) > eptr)
-                return E_UNEXPECTED;
-            float f = XMVectorGetX(*buffer++);
-            f = std::max<float>(std::min<float>(f, 127.f), -127.f);
-            *reinterpret_cast<int8_t*>(ptr) = static_cast<int8_t>(f);
-            ptr += stride;
-        }
-        break;
+_Use_decl_annotations_
+HRESULT VBWriter::Impl::SetQuantization(const char* semanticName, unsigned int semanticIndex, const XMFLOAT3& scale, const XMFLOAT3& bias)
+{
+    if (!semanticName)
+        return E_INVALIDARG;
 
-    case DXGI_FORMAT_B5G6R5_UNORM:
-    {
-        static const XMVECTORF32 s_Scale = { { { 31.f, 63.f, 31.f, 1.f } } };
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMU565)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMVectorSwizzle<2, 1, 0, 3>(*buffer++);
-            if (x2bias)
-            {
-                v = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
-                v = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
-            }
-            v = XMVectorMultiply(v, s_Scale);
-            XMStoreU565(reinterpret_cast<XMU565*>(ptr), v);
-            ptr += stride;
-        }
-    }
-    break;
+    auto desc = GetElement(semanticName, semanticIndex);
+    if (!desc)
+        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
 
-    case DXGI_FORMAT_B5G5R5A1_UNORM:
-    {
-        static const XMVECTORF32 s_Scale = { { { 31.f, 31.f, 31.f, 1.f } } };
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMU555)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMVectorSwizzle<2, 1, 0, 3>(*buffer++);
-            if (x2bias)
-            {
-                XMVECTOR v2 = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
-                v2 = XMVectorMultiplyAdd(v2, g_XMOneHalf, g_XMOneHalf);
-                v = XMVectorSelect(v, v2, g_XMSelect1110);
-            }
-            v = XMVectorMultiply(v, s_Scale);
-            XMStoreU555(reinterpret_cast<XMU555*>(ptr), v);
-            reinterpret_cast<XMU555*>(ptr)->w = (XMVectorGetW(v) > 0.5f) ? 1 : 0;
-            ptr += stride;
-        }
-    }
-    break;
+    if (desc->Format != VBFORMAT_QUANTIZED_POSITION_16)
+        return E_INVALIDARG;
 
-    case DXGI_FORMAT_B8G8R8A8_UNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMUBYTEN4)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMVectorSwizzle<2, 1, 0, 3>(*buffer++);
-            if (x2bias)
-            {
-                v = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
-                v = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
-            }
-            XMStoreUByteN4(reinterpret_cast<XMUBYTEN4*>(ptr), v);
-            ptr += stride;
-        }
-        break;
+    auto& quantization = mQuantization[size_t(desc - mInputDesc.data())];
+    quantization.invScale.x = (scale.x != 0.f) ? (1.f / scale.x) : 0.f;
+    quantization.invScale.y = (scale.y != 0.f) ? (1.f / scale.y) : 0.f;
+    quantization.invScale.z = (scale.z != 0.f) ? (1.f / scale.z) : 0.f;
+    quantization.bias = bias;
 
-    case DXGI_FORMAT_B8G8R8X8_UNORM:
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMUBYTEN4)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMVectorSwizzle<2, 1, 0, 3>(*buffer++);
-            if (x2bias)
-            {
-                v = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
-                v = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
-            }
-            v = XMVectorSelect(g_XMZero, v, g_XMSelect1110);
-            XMStoreUByteN4(reinterpret_cast<XMUBYTEN4*>(ptr), v);
-            ptr += stride;
-        }
-        break;
+    return S_OK;
+}
 
-    case DXGI_FORMAT_B4G4R4A4_UNORM:
-    {
-        static const XMVECTORF32 s_Scale = { { { 15.f, 15.f, 15.f, 15.f } } };
-        for (size_t icount = 0; icount < count; ++icount)
-        {
-            if ((ptr + sizeof(XMUNIBBLE4)) > eptr)
-                return E_UNEXPECTED;
-            XMVECTOR v = XMVectorSwizzle<2, 1, 0, 3>(*buffer++);
-            if (x2bias)
-            {
-                v = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
-                v = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
-            }
-            v = XMVectorMultiply(v, s_Scale);
-            XMStoreUNibble4(reinterpret_cast<XMUNIBBLE4*>(ptr), v);
-            ptr += stride;
-        }
-    }
-    break;
 
-    case XBOX_DXGI_FORMAT_R10G10B10_SNORM_A2_UNORM:
-        // Xbox One specific format
-        STORE_VERTS(XMXDECN4, XMStoreXDecN4);
+//-------------------------------------------------------------------------------------
+template<class T>
+_Use_decl_annotations_
+HRESULT VBWriter::Impl::Write(const T* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+{
+    if (!buffer || !semanticName || !count)
+        return E_INVALIDARG;
 
-    default:
-        return E_FAIL;
-    }
+    Handle handle;
+    HRESULT hr = GetHandle(semanticName, semanticIndex, handle);
+    if (FAILED(hr))
+        return hr;
 
-    return S_OK;
+    return Write(buffer, handle, count, x2bias);
 }
 
 
@@ -705,73 +1160,77 @@ HRESULT VBWriter::Write(const XMVECTOR* buffer, const char* semanticName, unsign
 _Use_decl_annotations_
 HRESULT VBWriter::Write(const float* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
 {
-    XMVECTOR* temp = pImpl->GetTemporaryBuffer(count);
-    if (!temp)
-        return E_OUTOFMEMORY;
+    return pImpl->Write(buffer, semanticName, semanticIndex, count, x2bias);
+}
 
-    XMVECTOR* dptr = temp;
-    const float* sptr = buffer;
-    for (size_t j = 0; j < count; ++j)
-    {
-        XMVECTOR v = XMLoadFloat(sptr++);
-        *(dptr)++ = v;
-    }
+_Use_decl_annotations_
+HRESULT VBWriter::Write(const XMFLOAT2* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+{
+    return pImpl->Write(buffer, semanticName, semanticIndex, count, x2bias);
+}
 
-    return pImpl->Write(temp, semanticName, semanticIndex, count, x2bias);
+_Use_decl_annotations_
+HRESULT VBWriter::Write(const XMFLOAT3* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+{
+    return pImpl->Write(buffer, semanticName, semanticIndex, count, x2bias);
 }
 
 _Use_decl_annotations_
-HRESULT VBWriter::Write(const XMFLOAT2* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+HRESULT VBWriter::Write(const XMFLOAT4* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
 {
-    XMVECTOR* temp = pImpl->GetTemporaryBuffer(count);
-    if (!temp)
-        return E_OUTOFMEMORY;
+    return pImpl->Write(buffer, semanticName, semanticIndex, count, x2bias);
+}
 
-    XMVECTOR* dptr = temp;
-    const XMFLOAT2* sptr = buffer;
-    for (size_t j = 0; j < count; ++j)
-    {
-        XMVECTOR v = XMLoadFloat2(sptr++);
-        *(dptr)++ = v;
-    }
 
-    return pImpl->Write(temp, semanticName, semanticIndex, count, x2bias);
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT VBWriter::GetHandle(const char* semanticName, unsigned int semanticIndex, Handle& handle) const
+{
+    return pImpl->GetHandle(semanticName, semanticIndex, handle);
+}
+
+_Use_decl_annotations_
+HRESULT VBWriter::Write(const XMVECTOR* buffer, const Handle& handle, size_t count, bool x2bias) const
+{
+    return pImpl->Write(buffer, handle, count, x2bias);
 }
 
 _Use_decl_annotations_
-HRESULT VBWriter::Write(const XMFLOAT3* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+HRESULT VBWriter::Write(const float* buffer, const Handle& handle, size_t count, bool x2bias) const
 {
-    XMVECTOR* temp = pImpl->GetTemporaryBuffer(count);
-    if (!temp)
-        return E_OUTOFMEMORY;
+    return pImpl->Write(buffer, handle, count, x2bias);
+}
 
-    XMVECTOR* dptr = temp;
-    const XMFLOAT3* sptr = buffer;
-    for (size_t j = 0; j < count; ++j)
-    {
-        XMVECTOR v = XMLoadFloat3(sptr++);
-        *(dptr)++ = v;
-    }
+_Use_decl_annotations_
+HRESULT VBWriter::Write(const XMFLOAT2* buffer, const Handle& handle, size_t count, bool x2bias) const
+{
+    return pImpl->Write(buffer, handle, count, x2bias);
+}
 
-    return pImpl->Write(temp, semanticName, semanticIndex, count, x2bias);
+_Use_decl_annotations_
+HRESULT VBWriter::Write(const XMFLOAT3* buffer, const Handle& handle, size_t count, bool x2bias) const
+{
+    return pImpl->Write(buffer, handle, count, x2bias);
 }
 
 _Use_decl_annotations_
-HRESULT VBWriter::Write(const XMFLOAT4* buffer, const char* semanticName, unsigned int semanticIndex, size_t count, bool x2bias) const
+HRESULT VBWriter::Write(const XMFLOAT4* buffer, const Handle& handle, size_t count, bool x2bias) const
 {
-    XMVECTOR* temp = pImpl->GetTemporaryBuffer(count);
-    if (!temp)
-        return E_OUTOFMEMORY;
+    return pImpl->Write(buffer, handle, count, x2bias);
+}
 
-    XMVECTOR* dptr = temp;
-    const XMFLOAT4* sptr = buffer;
-    for (size_t j = 0; j < count; ++j)
-    {
-        XMVECTOR v = XMLoadFloat4(sptr++);
-        *(dptr)++ = v;
-    }
 
-    return pImpl->Write(temp, semanticName, semanticIndex, count, x2bias);
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT VBWriter::SetQuantization(const char* semanticName, unsigned int semanticIndex, const XMFLOAT3& scale, const XMFLOAT3& bias)
+{
+    return pImpl->SetQuantization(semanticName, semanticIndex, scale, bias);
+}
+
+_Use_decl_annotations_
+void VBWriter::SetThreadCount(size_t threads) noexcept
+{
+    pImpl->SetThreadCount(threads);
 }
 
 
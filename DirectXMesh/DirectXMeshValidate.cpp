@@ -15,231 +15,451 @@ using namespace DirectX;
 
 namespace
 {
+    // Faces checked per block, and vertices per block of the bowtie check
+    const size_t c_ValidateBlock = 16384;
+    const size_t c_BowtieBlock = 16384;
+
     //---------------------------------------------------------------------------------
-    // Validates indices and optionally the adjacency information
+    // Checks a single face, calling report(error, face, value) for each problem found.
+    // Returns false as soon as report does, which stops the validation.
     //---------------------------------------------------------------------------------
-    template<class index_t>
-    HRESULT ValidateIndices(
-        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces,
-        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
-        _In_ DWORD flags, _In_opt_ std::wstring* msgs)
+    template<class index_t, class Report>
+    bool ValidateFace(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        DWORD flags, size_t face, Report& report)
     {
-        bool result = true;
-
-        if (!adjacency)
+        // Check for values in-range
+        for (size_t point = 0; point < 3; ++point)
         {
-            if (flags & VALIDATE_BACKFACING)
+            index_t i = indices[face * 3 + point];
+            if (i >= nVerts && i != index_t(-1))
             {
-                if (msgs)
-                    *msgs += L"Missing adjacency information required to check for BACKFACING\n";
-
-                result = false;
+                if (!report(VALIDATE_ERROR_INVALID_INDEX, face, uint32_t(i)))
+                    return false;
             }
 
-            if (flags & VALIDATE_ASYMMETRIC_ADJ)
+            if (adjacency)
             {
-                if (msgs)
-                    *msgs += L"Missing adjacency information required to check for ASYMMETRIC_ADJ\n";
-
-                result = false;
+                uint32_t j = adjacency[face * 3 + point];
+                if (j >= nFaces && j != UNUSED32)
+                {
+                    if (!report(VALIDATE_ERROR_INVALID_NEIGHBOR, face, j))
+                        return false;
+                }
             }
-
-            if (!result)
-                return E_INVALIDARG;
         }
 
-        for (size_t face = 0; face < nFaces; ++face)
+        // Check for unused faces
+        index_t i0 = indices[face * 3];
+        index_t i1 = indices[face * 3 + 1];
+        index_t i2 = indices[face * 3 + 2];
+        if (i0 == index_t(-1)
+            || i1 == index_t(-1)
+            || i2 == index_t(-1))
         {
-            // Check for values in-range
-            for (size_t point = 0; point < 3; ++point)
+            if (flags & VALIDATE_UNUSED)
             {
-                index_t i = indices[face * 3 + point];
-                if (i >= nVerts && i != index_t(-1))
+                if (i0 != i1
+                    || i0 != i2
+                    || i1 != i2)
                 {
-                    if (!msgs)
-                        return E_FAIL;
-
-                    result = false;
-
-                    wchar_t buff[128];
-                    swprintf_s(buff, L"An invalid index value (%u) was found on face %zu\n", i, face);
-                    *msgs += buff;
+                    index_t valid = (i0 != index_t(-1)) ? i0 : ((i1 != index_t(-1)) ? i1 : i2);
+                    if (!report(VALIDATE_ERROR_UNUSED_POINTS, face, uint32_t(valid)))
+                        return false;
                 }
 
                 if (adjacency)
                 {
-                    uint32_t j = adjacency[face * 3 + point];
-                    if (j >= nFaces && j != UNUSED32)
+                    for (size_t point = 0; point < 3; ++point)
                     {
-                        if (!msgs)
-                            return E_FAIL;
-
-                        result = false;
-
-                        wchar_t buff[128];
-                        swprintf_s(buff, L"An invalid neighbor index value (%u) was found on face %zu\n", j, face);
-                        *msgs += buff;
+                        uint32_t k = adjacency[face * 3 + point];
+                        if (k != UNUSED32)
+                        {
+                            if (!report(VALIDATE_ERROR_UNUSED_NEIGHBOR, face, k))
+                                return false;
+                        }
                     }
                 }
             }
 
-            // Check for unused faces
-            index_t i0 = indices[face * 3];
-            index_t i1 = indices[face * 3 + 1];
-            index_t i2 = indices[face * 3 + 2];
-            if (i0 == index_t(-1)
-                || i1 == index_t(-1)
-                || i2 == index_t(-1))
-            {
-                if (flags & VALIDATE_UNUSED)
-                {
-                    if (i0 != i1
-                        || i0 != i2
-                        || i1 != i2)
-                    {
-                        if (!msgs)
-                            return E_FAIL;
+            // ignore unused triangles for remaining tests
+            return true;
+        }
 
-                        result = false;
+        // Check for degenerate triangles
+        if (i0 == i1
+            || i0 == i2
+            || i1 == i2)
+        {
+            if (flags & VALIDATE_DEGENERATE)
+            {
+                index_t bad;
+                if (i0 == i1)
+                    bad = i0;
+                else if (i1 == i2)
+                    bad = i2;
+                else
+                    bad = i0;
 
-                        wchar_t buff[128];
-                        swprintf_s(buff, L"An unused face (%zu) contains 'valid' but ignored vertices (%u,%u,%u)\n", face, i0, i1, i2);
-                        *msgs += buff;
-                    }
+                if (!report(VALIDATE_ERROR_DEGENERATE, face, uint32_t(bad)))
+                    return false;
 
-                    if (adjacency)
+                if (adjacency)
+                {
+                    for (size_t point = 0; point < 3; ++point)
                     {
-                        for (size_t point = 0; point < 3; ++point)
+                        uint32_t k = adjacency[face * 3 + point];
+                        if (k != UNUSED32)
                         {
-                            uint32_t k = adjacency[face * 3 + point];
-                            if (k != UNUSED32)
-                            {
-                                if (!msgs)
-                                    return E_FAIL;
-
-                                result = false;
-
-                                wchar_t buff[128];
-                                swprintf_s(buff, L"An unused face (%zu) has a neighbor %u\n", face, k);
-                                *msgs += buff;
-                            }
+                            if (!report(VALIDATE_ERROR_DEGENERATE_NEIGHBOR, face, k))
+                                return false;
                         }
                     }
                 }
-
-                // ignore unused triangles for remaining tests
-                continue;
             }
 
-            // Check for degenerate triangles
-            if (i0 == i1
-                || i0 == i2
-                || i1 == i2)
+            // ignore degenerate triangles for remaining tests
+            return true;
+        }
+
+        // Check for symmetric neighbors
+        if ((flags & VALIDATE_ASYMMETRIC_ADJ) && adjacency)
+        {
+            for (size_t point = 0; point < 3; ++point)
             {
-                if (flags & VALIDATE_DEGENERATE)
+                uint32_t k = adjacency[face * 3 + point];
+                if (k >= nFaces)
+                    continue;
+
+                uint32_t edge = find_edge<uint32_t>(&adjacency[k * 3], uint32_t(face));
+                if (edge >= 3)
                 {
-                    if (!msgs)
-                        return E_FAIL;
+                    if (!report(VALIDATE_ERROR_ASYMMETRIC_ADJ, face, k))
+                        return false;
+                }
+            }
+        }
 
-                    result = false;
+        // Check for duplicate neighbor
+        if ((flags & VALIDATE_BACKFACING) && adjacency)
+        {
+            uint32_t j0 = adjacency[face * 3];
+            uint32_t j1 = adjacency[face * 3 + 1];
+            uint32_t j2 = adjacency[face * 3 + 2];
 
-                    index_t bad;
-                    if (i0 == i1)
-                        bad = i0;
-                    else if (i1 == i2)
-                        bad = i2;
-                    else
-                        bad = i0;
+            if ((j0 == j1 && j0 != UNUSED32)
+                || (j0 == j2 && j0 != UNUSED32)
+                || (j1 == j2 && j1 != UNUSED32))
+            {
+                uint32_t bad;
+                if (j0 == j1 && j0 != UNUSED32)
+                    bad = j0;
+                else if (j0 == j2 && j0 != UNUSED32)
+                    bad = j0;
+                else
+                    bad = j1;
+
+                if (!report(VALIDATE_ERROR_BACKFACING, face, bad))
+                    return false;
+            }
+        }
 
-                    wchar_t buff[128];
-                    swprintf_s(buff, L"A point (%u) was found more than once in triangle %zu\n", bad, face);
-                    *msgs += buff;
+        return true;
+    }
 
-                    if (adjacency)
-                    {
-                        for (size_t point = 0; point < 3; ++point)
-                        {
-                            uint32_t k = adjacency[face * 3 + point];
-                            if (k != UNUSED32)
-                            {
-                                result = false;
-
-                                swprintf_s(buff, L"A degenerate face (%zu) has a neighbor %u\n", face, k);
-                                *msgs += buff;
-                            }
-                        }
-                    }
-                }
 
-                // ignore degenerate triangles for remaining tests
+    //---------------------------------------------------------------------------------
+    // Formats a problem found by ValidateFace
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    void AppendMessage(
+        std::wstring& msgs,
+        _In_reads_(nFaces * 3) const index_t* indices,
+        uint32_t error, size_t face, uint32_t value)
+    {
+        wchar_t buff[256] = {};
+
+        switch (error)
+        {
+        case VALIDATE_ERROR_INVALID_INDEX:
+            swprintf_s(buff, L"An invalid index value (%u) was found on face %zu\n", value, face);
+            break;
+
+        case VALIDATE_ERROR_INVALID_NEIGHBOR:
+            swprintf_s(buff, L"An invalid neighbor index value (%u) was found on face %zu\n", value, face);
+            break;
+
+        case VALIDATE_ERROR_UNUSED_POINTS:
+            swprintf_s(buff, L"An unused face (%zu) contains 'valid' but ignored vertices (%u,%u,%u)\n", face,
+                uint32_t(indices[face * 3]), uint32_t(indices[face * 3 + 1]), uint32_t(indices[face * 3 + 2]));
+            break;
+
+        case VALIDATE_ERROR_UNUSED_NEIGHBOR:
+            swprintf_s(buff, L"An unused face (%zu) has a neighbor %u\n", face, value);
+            break;
+
+        case VALIDATE_ERROR_DEGENERATE:
+            swprintf_s(buff, L"A point (%u) was found more than once in triangle %zu\n", value, face);
+            break;
+
+        case VALIDATE_ERROR_DEGENERATE_NEIGHBOR:
+            swprintf_s(buff, L"A degenerate face (%zu) has a neighbor %u\n", face, value);
+            break;
+
+        case VALIDATE_ERROR_ASYMMETRIC_ADJ:
+            swprintf_s(buff, L"A neighbor triangle (%u) does not reference back to this face (%zu) as expected\n", value, face);
+            break;
+
+        case VALIDATE_ERROR_BACKFACING:
+            swprintf_s(buff, L"A neighbor triangle (%u) was found more than once on triangle %zu\n"
+                L"\t(likley problem is that two triangles share same points with opposite direction)\n", value, face);
+            break;
+
+        default:
+            return;
+        }
+
+        msgs += buff;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    // Checks the flags that require adjacency information
+    //---------------------------------------------------------------------------------
+    HRESULT ValidateAdjacencyFlags(_In_opt_ const uint32_t* adjacency, DWORD flags, _In_opt_ std::wstring* msgs)
+    {
+        if (adjacency)
+            return S_OK;
+
+        bool result = true;
+
+        if (flags & VALIDATE_BACKFACING)
+        {
+            if (msgs)
+                *msgs += L"Missing adjacency information required to check for BACKFACING\n";
+
+            result = false;
+        }
+
+        if (flags & VALIDATE_ASYMMETRIC_ADJ)
+        {
+            if (msgs)
+                *msgs += L"Missing adjacency information required to check for ASYMMETRIC_ADJ\n";
+
+            result = false;
+        }
+
+        return result ? S_OK : E_INVALIDARG;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    // Validates indices and optionally the adjacency information
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT ValidateIndices(
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_ DWORD flags, _In_opt_ std::wstring* msgs)
+    {
+        HRESULT hr = ValidateAdjacencyFlags(adjacency, flags, msgs);
+        if (FAILED(hr))
+            return hr;
+
+        bool result = true;
+
+        auto report = [&](uint32_t error, size_t face, uint32_t value) -> bool
+        {
+            result = false;
+
+            if (!msgs)
+                return false;
+
+            AppendMessage(*msgs, indices, error, face, value);
+            return true;
+        };
+
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            if (!ValidateFace(indices, nFaces, nVerts, adjacency, flags, face, report))
+                return E_FAIL;
+        }
+
+        return result ? S_OK : E_FAIL;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    // Finds bowties (i.e. a vertex is the apex of two separate triangle fans)
+    //
+    // The corners of each vertex are gathered into a CSR table, then each vertex walks
+    // its first fan through the neighbors across the two edges meeting at the vertex. Any
+    // corner left unvisited belongs to a second fan. Vertices are independent, so they
+    // are checked in parallel blocks, and each bowtie is reported once in vertex order.
+    //---------------------------------------------------------------------------------
+    struct Bowtie
+    {
+        uint32_t vertex;
+        uint32_t face;          // In the second fan
+        uint32_t otherFace;     // In the first fan
+    };
+
+    template<class index_t>
+    inline bool IsFanFace(_In_reads_(3) const index_t* face, size_t nVerts)
+    {
+        // Unused, degenerate and out of range faces are not part of any fan
+        return (face[0] < nVerts && face[1] < nVerts && face[2] < nVerts)
+            && (face[0] != face[1] && face[0] != face[2] && face[1] != face[2]);
+    }
+
+    // Returns an unvisited corner of the vertex across the two edges of the face meeting at it
+    template<class index_t>
+    inline uint32_t NextFanCorner(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        size_t nVerts, _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        _In_reads_(nFaces * 3) const uint8_t* visited,
+        uint32_t corner, index_t vert)
+    {
+        const uint32_t face = corner / 3;
+        const uint32_t point = corner % 3;
+
+        const uint32_t edges[2] = { face * 3 + point, face * 3 + ((point + 2) % 3) };
+
+        for (size_t e = 0; e < 2; ++e)
+        {
+            const uint32_t neighbor = adjacency[edges[e]];
+            if (neighbor >= nFaces)
+                continue;
+
+            if (!IsFanFace(&indices[neighbor * 3], nVerts))
+                continue;
+
+            const uint32_t nPoint = find_edge<index_t>(&indices[neighbor * 3], vert);
+            if (nPoint >= 3)
+                continue;
+
+            const uint32_t nCorner = neighbor * 3 + nPoint;
+            if (!visited[nCorner])
+                return nCorner;
+        }
+
+        return UNUSED32;
+    }
+
+    template<class index_t>
+    HRESULT FindBowties(
+        _In_reads_(nFaces * 3) const index_t* indices, size_t nFaces,
+        size_t nVerts, _In_reads_(nFaces * 3) const uint32_t* adjacency,
+        std::vector<Bowtie>& bowties)
+    {
+        bowties.clear();
+
+        std::unique_ptr<uint32_t[]> offsets(new (std::nothrow) uint32_t[nVerts + 1]);
+        std::unique_ptr<uint32_t[]> corners(new (std::nothrow) uint32_t[nFaces * 3]);
+        std::unique_ptr<uint8_t[]> visited(new (std::nothrow) uint8_t[nFaces * 3]);
+        if (!offsets || !corners || !visited)
+            return E_OUTOFMEMORY;
+
+        memset(offsets.get(), 0, sizeof(uint32_t) * (nVerts + 1));
+        memset(visited.get(), 0, sizeof(uint8_t) * nFaces * 3);
+
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            if (!IsFanFace(&indices[face * 3], nVerts))
                 continue;
+
+            for (size_t point = 0; point < 3; ++point)
+            {
+                ++offsets[indices[face * 3 + point] + 1];
             }
+        }
+
+        for (size_t vert = 0; vert < nVerts; ++vert)
+        {
+            offsets[vert + 1] += offsets[vert];
+        }
 
-            // Check for symmetric neighbors
-            if ((flags & VALIDATE_ASYMMETRIC_ADJ) && adjacency)
+        // Fill using the start of each vertex as its cursor, then shift the starts back
+        for (size_t face = 0; face < nFaces; ++face)
+        {
+            if (!IsFanFace(&indices[face * 3], nVerts))
+                continue;
+
+            for (size_t point = 0; point < 3; ++point)
             {
-                for (size_t point = 0; point < 3; ++point)
-                {
-                    uint32_t k = adjacency[face * 3 + point];
-                    if (k == UNUSED32)
-                        continue;
+                corners[offsets[indices[face * 3 + point]]++] = uint32_t(face * 3 + point);
+            }
+        }
 
-                    assert(k < nFaces);
+        for (size_t vert = nVerts; vert > 0; --vert)
+        {
+            offsets[vert] = offsets[vert - 1];
+        }
+        offsets[0] = 0;
 
-                    uint32_t edge = find_edge<uint32_t>(&adjacency[k * 3], uint32_t(face));
-                    if (edge >= 3)
-                    {
-                        if (!msgs)
-                            return E_FAIL;
+        const size_t nBlocks = (nVerts + c_BowtieBlock - 1) / c_BowtieBlock;
+        std::vector<std::vector<Bowtie>> blockBowties(nBlocks);
 
-                        result = false;
+        const int blockCount = static_cast<int>(nBlocks);
 
-                        wchar_t buff[256];
-                        swprintf_s(buff, L"A neighbor triangle (%u) does not reference back to this face (%zu) as expected\n", k, face);
-                        *msgs += buff;
-                    }
-                }
-            }
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (int block = 0; block < blockCount; ++block)
+        {
+            const size_t first = size_t(block) * c_BowtieBlock;
+            const size_t last = std::min(first + c_BowtieBlock, nVerts);
 
-            // Check for duplicate neighbor
-            if ((flags & VALIDATE_BACKFACING) && adjacency)
+            for (size_t vert = first; vert < last; ++vert)
             {
-                uint32_t j0 = adjacency[face * 3];
-                uint32_t j1 = adjacency[face * 3 + 1];
-                uint32_t j2 = adjacency[face * 3 + 2];
+                uint32_t fanFace = UNUSED32;
 
-                if ((j0 == j1 && j0 != UNUSED32)
-                    || (j0 == j2 && j0 != UNUSED32)
-                    || (j1 == j2 && j1 != UNUSED32))
+                for (uint32_t k = offsets[vert]; k < offsets[vert + 1]; ++k)
                 {
-                    if (!msgs)
-                        return E_FAIL;
-
-                    result = false;
-
-                    uint32_t bad;
-                    if (j0 == j1 && j0 != UNUSED32)
-                        bad = j0;
-                    else if (j0 == j2 && j0 != UNUSED32)
-                        bad = j0;
-                    else
-                        bad = j1;
-
-                    wchar_t buff[256] = {};
-                    swprintf_s(buff, L"A neighbor triangle (%u) was found more than once on triangle %zu\n"
-                        L"\t(likley problem is that two triangles share same points with opposite direction)\n", bad, face);
-                    *msgs += buff;
+                    const uint32_t corner = corners[k];
+                    if (visited[corner])
+                        continue;
+
+                    if (fanFace != UNUSED32)
+                    {
+                        Bowtie bowtie = { uint32_t(vert), corner / 3, fanFace };
+                        blockBowties[size_t(block)].push_back(bowtie);
+                        break;
+                    }
+
+                    fanFace = corner / 3;
+                    visited[corner] = 1;
+
+                    // A fan is a chain of faces, so walk it from the first corner in each direction
+                    for (size_t pass = 0; pass < 2; ++pass)
+                    {
+                        uint32_t current = corner;
+                        for (;;)
+                        {
+                            const uint32_t next = NextFanCorner(indices, nFaces, nVerts, adjacency, visited.get(), current, index_t(vert));
+                            if (next == UNUSED32)
+                                break;
+
+                            visited[next] = 1;
+                            current = next;
+                        }
+                    }
                 }
             }
         }
 
-        return result ? S_OK : E_FAIL;
+        for (size_t block = 0; block < nBlocks; ++block)
+        {
+            bowties.insert(bowties.end(), blockBowties[block].cbegin(), blockBowties[block].cend());
+        }
+
+        return S_OK;
     }
 
 
     //---------------------------------------------------------------------------------
     // Validates mesh contains no bowties
-    // (i.e. a vertex is the apex of two separate triangle fans)
     //---------------------------------------------------------------------------------
     template<class index_t>
     HRESULT ValidateNoBowties(
@@ -255,98 +475,121 @@ namespace
             return E_INVALIDARG;
         }
 
-        size_t tsize = (sizeof(bool) * nFaces * 3) + (sizeof(index_t) * nVerts * 2) + (sizeof(bool) * nVerts);
-        std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[tsize]);
-        if (!temp)
-            return E_OUTOFMEMORY;
+        std::vector<Bowtie> bowties;
+        HRESULT hr = FindBowties(indices, nFaces, nVerts, adjacency, bowties);
+        if (FAILED(hr))
+            return hr;
 
-        auto faceSeen = reinterpret_cast<bool*>(temp.get());
-        auto faceIds = reinterpret_cast<index_t*>(temp.get() + sizeof(bool) * nFaces * 3);
-        auto faceUsing = reinterpret_cast<index_t*>(reinterpret_cast<uint8_t*>(faceIds) + sizeof(index_t) * nVerts);
-        auto vertexBowtie = reinterpret_cast<bool*>(reinterpret_cast<uint8_t*>(faceUsing) + sizeof(index_t) * nVerts);
+        if (bowties.empty())
+            return S_OK;
 
-        memset(faceSeen, 0, sizeof(bool) * nFaces * 3);
-        memset(faceIds, 0xFF, sizeof(index_t) * nVerts);
-        memset(faceUsing, 0, sizeof(index_t) * nVerts);
-        memset(vertexBowtie, 0, sizeof(bool) * nVerts);
+        if (msgs)
+        {
+            *msgs += L"A bowtie was found.  Bowties can be fixed by calling Clean\n"
+                L"  A bowtie is the usage of a single vertex by two separate fans of triangles.\n"
+                L"  The fix is to duplicate the vertex so that each fan has its own vertex.\n";
 
-        orbit_iterator<index_t> ovi(adjacency, indices, nFaces);
+            for (auto it = bowties.cbegin(); it != bowties.cend(); ++it)
+            {
+                wchar_t buff[256] = {};
+                swprintf_s(buff, L"\nBowtie found around vertex %u shared by faces %u and %u\n", it->vertex, it->face, it->otherFace);
+                *msgs += buff;
+            }
+        }
 
-        bool result = true;
+        return E_FAIL;
+    }
+
+
+    //---------------------------------------------------------------------------------
+    // Validates in parallel blocks of faces, each keeping its own counts and first
+    // issues, which are merged in face order
+    //---------------------------------------------------------------------------------
+    template<class index_t>
+    HRESULT ValidateParallel(
+        _In_reads_(nFaces * 3) const index_t* indices, _In_ size_t nFaces,
+        _In_ size_t nVerts, _In_reads_opt_(nFaces * 3) const uint32_t* adjacency,
+        _In_ DWORD flags, ValidateResult& result, size_t maxIssues)
+    {
+        HRESULT hr = ValidateAdjacencyFlags(adjacency, flags, nullptr);
+        if (FAILED(hr))
+            return hr;
+
+        if ((flags & VALIDATE_BOWTIES) && !adjacency)
+            return E_INVALIDARG;
+
+        const size_t nBlocks = (nFaces + c_ValidateBlock - 1) / c_ValidateBlock;
+        std::vector<ValidateResult> blocks(nBlocks);
+
+        const int blockCount = static_cast<int>(nBlocks);
 
-        for (uint32_t face = 0; face < nFaces; ++face)
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif
+        for (int block = 0; block < blockCount; ++block)
         {
-            index_t i0 = indices[face * 3];
-            index_t i1 = indices[face * 3 + 1];
-            index_t i2 = indices[face * 3 + 2];
+            const size_t first = size_t(block) * c_ValidateBlock;
+            const size_t last = std::min(first + c_ValidateBlock, nFaces);
 
-            if (i0 == i1
-                || i0 == i2
-                || i1 == i2)
-            {
-                // ignore degenerate faces
-                faceSeen[face * 3] = true;
-                faceSeen[face * 3 + 1] = true;
-                faceSeen[face * 3 + 2] = true;
-                continue;
-            }
+            auto& blockResult = blocks[size_t(block)];
+            memset(blockResult.counts, 0, sizeof(blockResult.counts));
 
-            for (uint32_t point = 0; point < 3; ++point)
+            auto report = [&](uint32_t error, size_t face, uint32_t value) -> bool
             {
-                if (faceSeen[face * 3 + point])
-                    continue;
+                ++blockResult.counts[error];
 
-                faceSeen[face * 3 + point] = true;
-
-                index_t i = indices[face * 3 + point];
-                ovi.initialize(face, i, orbit_iterator<index_t>::ALL);
-                ovi.moveToCCW();
-                while (!ovi.done())
+                if (blockResult.issues.size() < maxIssues)
                 {
-                    uint32_t curFace = ovi.nextFace();
-                    if (curFace >= nFaces)
-                        return E_FAIL;
-
-                    uint32_t curPoint = ovi.getpoint();
-                    if (curPoint > 2)
-                        return E_FAIL;
+                    ValidateIssue issue = { error, uint32_t(face), value };
+                    blockResult.issues.push_back(issue);
+                }
 
-                    faceSeen[curFace * 3 + curPoint] = true;
+                return true;
+            };
 
-                    uint32_t j = indices[curFace * 3 + curPoint];
+            for (size_t face = first; face < last; ++face)
+            {
+                ValidateFace(indices, nFaces, nVerts, adjacency, flags, face, report);
+            }
+        }
 
-                    if (faceIds[j] == index_t(-1))
-                    {
-                        faceIds[j] = index_t(face);
-                        faceUsing[j] = index_t(curFace);
-                    }
-                    else if ((faceIds[j] != index_t(face)) && !vertexBowtie[j])
-                    {
-                        // We found a (unique) bowtie!
+        for (size_t block = 0; block < nBlocks; ++block)
+        {
+            for (size_t error = 0; error < VALIDATE_ERROR_COUNT; ++error)
+            {
+                result.counts[error] += blocks[block].counts[error];
+            }
 
-                        if (!msgs)
-                            return E_FAIL;
+            const size_t room = maxIssues - result.issues.size();
+            const size_t count = std::min(room, blocks[block].issues.size());
+            result.issues.insert(result.issues.end(), blocks[block].issues.cbegin(), blocks[block].issues.cbegin() + ptrdiff_t(count));
+        }
 
-                        if (result)
-                        {
-                            // If this is the first bowtie found, add a quick explanation
-                            *msgs += L"A bowtie was found.  Bowties can be fixed by calling Clean\n"
-                                L"  A bowtie is the usage of a single vertex by two separate fans of triangles.\n"
-                                L"  The fix is to duplicate the vertex so that each fan has its own vertex.\n";
-                            result = false;
-                        }
+        if ((flags & VALIDATE_BOWTIES)
+            && !result.counts[VALIDATE_ERROR_INVALID_INDEX]
+            && !result.counts[VALIDATE_ERROR_INVALID_NEIGHBOR])
+        {
+            std::vector<Bowtie> bowties;
+            hr = FindBowties(indices, nFaces, nVerts, adjacency, bowties);
+            if (FAILED(hr))
+                return hr;
 
-                        vertexBowtie[j] = true;
+            result.counts[VALIDATE_ERROR_BOWTIE] = bowties.size();
 
-                        wchar_t buff[256] = {};
-                        swprintf_s(buff, L"\nBowtie found around vertex %u shared by faces %u and %u\n", j, curFace, faceUsing[j]);
-                        *msgs += buff;
-                    }
-                }
+            for (auto it = bowties.cbegin(); it != bowties.cend() && result.issues.size() < maxIssues; ++it)
+            {
+                ValidateIssue issue = { VALIDATE_ERROR_BOWTIE, it->face, it->vertex };
+                result.issues.push_back(issue);
             }
         }
 
-        return result ? S_OK : E_FAIL;
+        for (size_t error = 0; error < VALIDATE_ERROR_COUNT; ++error)
+        {
+            if (result.counts[error])
+                return E_FAIL;
+        }
+
+        return S_OK;
     }
 }
 
@@ -418,3 +661,47 @@ HRESULT DirectX::Validate(
 
     return S_OK;
 }
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::Validate(
+    const uint16_t* indices, size_t nFaces, size_t nVerts,
+    const uint32_t* adjacency, DWORD flags, ValidateResult& result, size_t maxIssues)
+{
+    memset(result.counts, 0, sizeof(result.counts));
+    result.issues.clear();
+
+    if (!indices || !nFaces || !nVerts)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT16_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    return ValidateParallel<uint16_t>(indices, nFaces, nVerts, adjacency, flags, result, maxIssues);
+}
+
+
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::Validate(
+    const uint32_t* indices, size_t nFaces, size_t nVerts,
+    const uint32_t* adjacency, DWORD flags, ValidateResult& result, size_t maxIssues)
+{
+    memset(result.counts, 0, sizeof(result.counts));
+    result.issues.clear();
+
+    if (!indices || !nFaces || !nVerts)
+        return E_INVALIDARG;
+
+    if (nVerts >= UINT32_MAX)
+        return E_INVALIDARG;
+
+    if ((uint64_t(nFaces) * 3) >= UINT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    return ValidateParallel<uint32_t>(indices, nFaces, nVerts, adjacency, flags, result, maxIssues);
+}
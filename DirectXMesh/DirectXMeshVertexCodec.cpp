@@ -0,0 +1,479 @@
+//-------------------------------------------------------------------------------------
+// DirectXMeshVertexCodec.cpp
+//
+// DirectX Mesh Geometry Library - Vertex buffer compression
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkID=324981
+//-------------------------------------------------------------------------------------
+
+#include "DirectXMeshP.h"
+
+using namespace DirectX;
+
+//
+// Compressed stream layout
+//
+//  uint32_t    magic
+//  uint32_t    vertex count
+//  uint32_t    stride
+//  blocks of 16 vertices, each with
+//      uint8_t     mode per byte of the stride, 2 bits each   [(stride + 3) / 4]
+//      uint8_t     packed data per byte of the stride
+//
+// Each block is transposed so that byte k of all 16 vertices forms a plane. A plane
+// is stored as the zigzag byte deltas from the previous vertex, packed at 0, 2, 4 or
+// 8 bits per vertex. The final partial block repeats the last vertex.
+//
+
+namespace
+{
+    const uint32_t c_VertexCodecMagic = 0x31434256; // 'VBC1'
+
+    const size_t c_MaxSlot = 32;
+    const size_t c_MaxStride = 2048;
+
+    const size_t c_BlockSize = 16;
+
+    enum PLANE_MODE
+    {
+        PLANE_ZERO = 0,
+        PLANE_BITS2,
+        PLANE_BITS4,
+        PLANE_BITS8,
+    };
+
+    const size_t c_ModeBytes[4] = { 0, 4, 8, 16 };
+
+    //---------------------------------------------------------------------------------
+    inline uint8_t zigzag8(uint8_t delta)
+    {
+        return static_cast<uint8_t>((delta << 1) ^ (static_cast<int8_t>(delta) >> 7));
+    }
+
+    inline uint8_t unzigzag8(uint8_t value)
+    {
+        return static_cast<uint8_t>((value >> 1) ^ (0u - (value & 1u)));
+    }
+
+    void EncodePlane(const uint8_t* zz, uint32_t mode, std::vector<uint8_t>& out)
+    {
+        switch (mode)
+        {
+        case PLANE_BITS2:
+            for (size_t j = 0; j < c_BlockSize; j += 4)
+            {
+                out.push_back(static_cast<uint8_t>(zz[j] | (zz[j + 1] << 2) | (zz[j + 2] << 4) | (zz[j + 3] << 6)));
+            }
+            break;
+
+        case PLANE_BITS4:
+            for (size_t j = 0; j < c_BlockSize; j += 2)
+            {
+                out.push_back(static_cast<uint8_t>(zz[j] | (zz[j + 1] << 4)));
+            }
+            break;
+
+        case PLANE_BITS8:
+            out.insert(out.end(), zz, zz + c_BlockSize);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Decodes one plane of 16 bytes, returning the last value for the next block
+#if defined(_XM_SSE_INTRINSICS_)
+    inline uint8_t DecodePlane(_In_reads_(c_ModeBytes[mode]) const uint8_t* data, uint32_t mode, uint8_t prev, _Out_writes_(c_BlockSize) uint8_t* plane)
+    {
+        const __m128i lowBits2 = _mm_set1_epi8(0x03);
+        const __m128i lowBits4 = _mm_set1_epi8(0x0f);
+
+        __m128i zz;
+        switch (mode)
+        {
+        case PLANE_BITS2:
+            {
+                int32_t packed;
+                memcpy(&packed, data, sizeof(packed));
+                __m128i x = _mm_cvtsi32_si128(packed);
+                __m128i a = _mm_and_si128(x, lowBits2);
+                __m128i b = _mm_and_si128(_mm_srli_epi16(x, 2), lowBits2);
+                __m128i c = _mm_and_si128(_mm_srli_epi16(x, 4), lowBits2);
+                __m128i d = _mm_and_si128(_mm_srli_epi16(x, 6), lowBits2);
+                zz = _mm_unpacklo_epi16(_mm_unpacklo_epi8(a, b), _mm_unpacklo_epi8(c, d));
+            }
+            break;
+
+        case PLANE_BITS4:
+            {
+                __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+                __m128i lo = _mm_and_si128(x, lowBits4);
+                __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), lowBits4);
+                zz = _mm_unpacklo_epi8(lo, hi);
+            }
+            break;
+
+        case PLANE_BITS8:
+            zz = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            break;
+
+        default:
+            zz = _mm_setzero_si128();
+            break;
+        }
+
+        // unzigzag
+        __m128i sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(zz, _mm_set1_epi8(1)));
+        __m128i v = _mm_xor_si128(_mm_and_si128(_mm_srli_epi16(zz, 1), _mm_set1_epi8(0x7f)), sign);
+
+        // prefix sum of the deltas
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 1));
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 2));
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(prev)));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(plane), v);
+
+        return static_cast<uint8_t>(_mm_extract_epi16(v, 7) >> 8);
+    }
+
+    // Transposes 16 planes of 16 vertices into 16 bytes of each vertex
+    inline void TransposePlanes(_In_reads_(c_BlockSize * c_BlockSize) const uint8_t* planes, _Out_ uint8_t* dest, size_t stride)
+    {
+        __m128i a[16];
+        for (size_t j = 0; j < 16; ++j)
+        {
+            a[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes + j * c_BlockSize));
+        }
+
+        __m128i t[16];
+        for (size_t j = 0; j < 8; ++j)
+        {
+            t[2 * j] = _mm_unpacklo_epi8(a[2 * j], a[2 * j + 1]);
+            t[2 * j + 1] = _mm_unpackhi_epi8(a[2 * j], a[2 * j + 1]);
+        }
+
+        __m128i u[16];
+        for (size_t j = 0; j < 4; ++j)
+        {
+            u[4 * j] = _mm_unpacklo_epi16(t[4 * j], t[4 * j + 2]);
+            u[4 * j + 1] = _mm_unpackhi_epi16(t[4 * j], t[4 * j + 2]);
+            u[4 * j + 2] = _mm_unpacklo_epi16(t[4 * j + 1], t[4 * j + 3]);
+            u[4 * j + 3] = _mm_unpackhi_epi16(t[4 * j + 1], t[4 * j + 3]);
+        }
+
+        for (size_t q = 0; q < 4; ++q)
+        {
+            __m128i w0 = _mm_unpacklo_epi32(u[q], u[4 + q]);
+            __m128i w1 = _mm_unpackhi_epi32(u[q], u[4 + q]);
+            __m128i w2 = _mm_unpacklo_epi32(u[8 + q], u[12 + q]);
+            __m128i w3 = _mm_unpackhi_epi32(u[8 + q], u[12 + q]);
+
+            uint8_t* vptr = dest + 4 * q * stride;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(vptr), _mm_unpacklo_epi64(w0, w2));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(vptr + stride), _mm_unpackhi_epi64(w0, w2));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(vptr + 2 * stride), _mm_unpacklo_epi64(w1, w3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(vptr + 3 * stride), _mm_unpackhi_epi64(w1, w3));
+        }
+    }
+#else
+    inline uint8_t DecodePlane(_In_reads_(c_ModeBytes[mode]) const uint8_t* data, uint32_t mode, uint8_t prev, _Out_writes_(c_BlockSize) uint8_t* plane)
+    {
+        for (size_t j = 0; j < c_BlockSize; ++j)
+        {
+            uint8_t zz;
+            switch (mode)
+            {
+            case PLANE_BITS2:   zz = static_cast<uint8_t>((data[j >> 2] >> ((j & 3) * 2)) & 0x3); break;
+            case PLANE_BITS4:   zz = static_cast<uint8_t>((data[j >> 1] >> ((j & 1) * 4)) & 0xf); break;
+            case PLANE_BITS8:   zz = data[j]; break;
+            default:            zz = 0; break;
+            }
+
+            prev = static_cast<uint8_t>(prev + unzigzag8(zz));
+            plane[j] = prev;
+        }
+
+        return prev;
+    }
+
+    inline void TransposePlanes(_In_reads_(c_BlockSize * c_BlockSize) const uint8_t* planes, _Out_ uint8_t* dest, size_t stride)
+    {
+        for (size_t v = 0; v < c_BlockSize; ++v)
+        {
+            for (size_t k = 0; k < c_BlockSize; ++k)
+            {
+                dest[v * stride + k] = planes[k * c_BlockSize + v];
+            }
+        }
+    }
+#endif
+
+    //---------------------------------------------------------------------------------
+    HRESULT CompressVertexBufferImpl(
+        _In_reads_bytes_(nVerts * stride) const uint8_t* vb, size_t nVerts, size_t stride,
+        std::vector<uint8_t>& compressed)
+    {
+        if ((uint64_t(nVerts) * stride) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        std::unique_ptr<uint8_t[]> prev(new (std::nothrow) uint8_t[stride]);
+        if (!prev)
+            return E_OUTOFMEMORY;
+
+        memset(prev.get(), 0, stride);
+
+        const uint32_t header[3] = { c_VertexCodecMagic, uint32_t(nVerts), uint32_t(stride) };
+
+        const size_t modeBytes = (stride + 3) / 4;
+
+        compressed.clear();
+        compressed.reserve(sizeof(header) + nVerts * stride);
+        compressed.resize(sizeof(header));
+        memcpy(compressed.data(), header, sizeof(header));
+
+        for (size_t block = 0; block < nVerts; block += c_BlockSize)
+        {
+            size_t modeOffset = compressed.size();
+            compressed.resize(modeOffset + modeBytes, 0);
+
+            for (size_t k = 0; k < stride; ++k)
+            {
+                uint8_t zz[c_BlockSize];
+                uint8_t bits = 0;
+
+                uint8_t p = prev[k];
+                for (size_t j = 0; j < c_BlockSize; ++j)
+                {
+                    size_t v = std::min(block + j, nVerts - 1);
+                    uint8_t value = vb[v * stride + k];
+
+                    zz[j] = zigzag8(static_cast<uint8_t>(value - p));
+                    bits |= zz[j];
+                    p = value;
+                }
+                prev[k] = p;
+
+                uint32_t mode = (!bits) ? PLANE_ZERO
+                    : (bits < 0x4) ? PLANE_BITS2
+                    : (bits < 0x10) ? PLANE_BITS4
+                    : PLANE_BITS8;
+
+                compressed[modeOffset + (k >> 2)] |= static_cast<uint8_t>(mode << ((k & 3) * 2));
+
+                EncodePlane(zz, mode, compressed);
+            }
+        }
+
+        return S_OK;
+    }
+
+    //---------------------------------------------------------------------------------
+    HRESULT DecompressVertexBufferImpl(
+        _In_reads_bytes_(size) const uint8_t* compressed, size_t size,
+        _Out_writes_bytes_(nVerts * stride) uint8_t* vb, size_t nVerts, size_t stride)
+    {
+        if ((uint64_t(nVerts) * stride) >= UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        uint32_t header[3];
+        if (size < sizeof(header))
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+        memcpy(header, compressed, sizeof(header));
+        if (header[0] != c_VertexCodecMagic || header[1] != nVerts || header[2] != stride)
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+        // planes are padded to a whole number of 16 byte groups for the transpose
+        const size_t paddedStride = (stride + c_BlockSize - 1) & ~(c_BlockSize - 1);
+
+        std::unique_ptr<uint8_t[]> prev(new (std::nothrow) uint8_t[stride]);
+        std::unique_ptr<uint8_t[]> planes(new (std::nothrow) uint8_t[paddedStride * c_BlockSize]);
+        std::unique_ptr<uint8_t[]> partial(new (std::nothrow) uint8_t[paddedStride * c_BlockSize]);
+        if (!prev || !planes || !partial)
+            return E_OUTOFMEMORY;
+
+        memset(prev.get(), 0, stride);
+        memset(planes.get(), 0, paddedStride * c_BlockSize);
+
+        const size_t modeBytes = (stride + 3) / 4;
+
+        const uint8_t* ptr = compressed + sizeof(header);
+        const uint8_t* end = compressed + size;
+
+        for (size_t block = 0; block < nVerts; block += c_BlockSize)
+        {
+            if (size_t(end - ptr) < modeBytes)
+                return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+            const uint8_t* modes = ptr;
+            ptr += modeBytes;
+
+            for (size_t k = 0; k < stride; ++k)
+            {
+                uint32_t mode = (modes[k >> 2] >> ((k & 3) * 2)) & 0x3;
+
+                size_t bytes = c_ModeBytes[mode];
+                if (size_t(end - ptr) < bytes)
+                    return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+                prev[k] = DecodePlane(ptr, mode, prev[k], planes.get() + k * c_BlockSize);
+                ptr += bytes;
+            }
+
+            // full blocks are written in place, the final partial block and short strides are staged
+            const size_t count = std::min(c_BlockSize, nVerts - block);
+            if (count == c_BlockSize && stride >= c_BlockSize)
+            {
+                uint8_t* dest = vb + block * stride;
+                for (size_t k = 0; k < stride; k += c_BlockSize)
+                {
+                    // the last group overlaps the previous one rather than running past the row
+                    size_t offset = std::min(k, stride - c_BlockSize);
+                    TransposePlanes(planes.get() + offset * c_BlockSize, dest + offset, stride);
+                }
+            }
+            else
+            {
+                for (size_t k = 0; k < paddedStride; k += c_BlockSize)
+                {
+                    TransposePlanes(planes.get() + k * c_BlockSize, partial.get() + k, paddedStride);
+                }
+
+                for (size_t v = 0; v < count; ++v)
+                {
+                    memcpy(vb + (block + v) * stride, partial.get() + v * paddedStride, stride);
+                }
+            }
+        }
+
+        if (ptr != end)
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+        return S_OK;
+    }
+}
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+#if defined(__d3d11_h__) || defined(__d3d11_x_h__)
+
+_Use_decl_annotations_
+HRESULT DirectX::CompressVertexBuffer(
+    const D3D11_INPUT_ELEMENT_DESC* vbDecl, size_t nDecl,
+    const void* vb, size_t nVerts,
+    std::vector<uint8_t>& compressed,
+    size_t inputSlot, size_t stride)
+{
+    if (!vb || !nVerts || inputSlot >= c_MaxSlot || stride > c_MaxStride)
+        return E_INVALIDARG;
+
+    if (!IsValid(vbDecl, nDecl))
+        return E_INVALIDARG;
+
+    if (!stride)
+    {
+        uint32_t strides[c_MaxSlot] = {};
+        ComputeInputLayout(vbDecl, nDecl, nullptr, strides);
+
+        stride = strides[inputSlot];
+        if (!stride)
+            return E_INVALIDARG;
+    }
+
+    return CompressVertexBufferImpl(static_cast<const uint8_t*>(vb), nVerts, stride, compressed);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::DecompressVertexBuffer(
+    const D3D11_INPUT_ELEMENT_DESC* vbDecl, size_t nDecl,
+    const uint8_t* compressed, size_t size,
+    void* vb, size_t nVerts,
+    size_t inputSlot, size_t stride)
+{
+    if (!compressed || !vb || !nVerts || inputSlot >= c_MaxSlot || stride > c_MaxStride)
+        return E_INVALIDARG;
+
+    if (!IsValid(vbDecl, nDecl))
+        return E_INVALIDARG;
+
+    if (!stride)
+    {
+        uint32_t strides[c_MaxSlot] = {};
+        ComputeInputLayout(vbDecl, nDecl, nullptr, strides);
+
+        stride = strides[inputSlot];
+        if (!stride)
+            return E_INVALIDARG;
+    }
+
+    return DecompressVertexBufferImpl(compressed, size, static_cast<uint8_t*>(vb), nVerts, stride);
+}
+
+#endif // d3d11
+
+
+//-------------------------------------------------------------------------------------
+#if defined(__d3d12_h__) || defined(__d3d12_x_h__)
+
+_Use_decl_annotations_
+HRESULT DirectX::CompressVertexBuffer(
+    const D3D12_INPUT_LAYOUT_DESC& vbDecl,
+    const void* vb, size_t nVerts,
+    std::vector<uint8_t>& compressed,
+    size_t inputSlot, size_t stride)
+{
+    if (!vb || !nVerts || inputSlot >= c_MaxSlot || stride > c_MaxStride)
+        return E_INVALIDARG;
+
+    if (!IsValid(vbDecl))
+        return E_INVALIDARG;
+
+    if (!stride)
+    {
+        uint32_t strides[c_MaxSlot] = {};
+        ComputeInputLayout(vbDecl, nullptr, strides);
+
+        stride = strides[inputSlot];
+        if (!stride)
+            return E_INVALIDARG;
+    }
+
+    return CompressVertexBufferImpl(static_cast<const uint8_t*>(vb), nVerts, stride, compressed);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::DecompressVertexBuffer(
+    const D3D12_INPUT_LAYOUT_DESC& vbDecl,
+    const uint8_t* compressed, size_t size,
+    void* vb, size_t nVerts,
+    size_t inputSlot, size_t stride)
+{
+    if (!compressed || !vb || !nVerts || inputSlot >= c_MaxSlot || stride > c_MaxStride)
+        return E_INVALIDARG;
+
+    if (!IsValid(vbDecl))
+        return E_INVALIDARG;
+
+    if (!stride)
+    {
+        uint32_t strides[c_MaxSlot] = {};
+        ComputeInputLayout(vbDecl, nullptr, strides);
+
+        stride = strides[inputSlot];
+        if (!stride)
+            return E_INVALIDARG;
+    }
+
+    return DecompressVertexBufferImpl(compressed, size, static_cast<uint8_t*>(vb), nVerts, stride);
+}
+
+#endif // d3d12
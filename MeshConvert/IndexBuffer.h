@@ -0,0 +1,75 @@
+//--------------------------------------------------------------------------------------
+// File: IndexBuffer.h
+//
+// Standalone index buffer written by MeshConvert next to the converted mesh, as either
+// a triangle list, triangle strips with primitive restart, or a compressed triangle list,
+// optionally split into chunks addressable with 16-bit indices
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+
+namespace IndexBuffer
+{
+	// .IB files
+
+	// IB_HEADER
+	// uint16_t or uint32_t         [header->IndexCount]        header->IndexOffset
+	//  or
+	// uint8_t                      [header->DataSize]          header->IndexOffset
+	// IB_CHUNK                     [header->ChunkCount]        header->ChunkOffset
+	// uint32_t                     [header->ChunkVertexCount]  header->ChunkVertexOffset
+
+	// PrimitiveType is DXUT::PT_TRIANGLE_LIST or DXUT::PT_TRIANGLE_STRIP. Strips are
+	// separated by the restart index, which is all bits set for the index size.
+	// Compressed data is always a triangle list, decoded with DirectX::DecompressIndexBuffer.
+
+	// Meshes with too many vertices for 16-bit indices are split into chunks, unless 32-bit
+	// indices were requested. Each chunk draws IndexCount indices from IndexStart, and its
+	// indices address the VertexCount chunk vertex entries from VertexStart, which hold the
+	// mesh vertex indices. ChunkCount is 0 when the indices address the mesh directly.
+
+	const uint32_t IB_FILE_MAGIC = 0x46554249; // 'IBUF'
+	const uint32_t IB_FILE_VERSION = 3;
+
+	enum IB_ENCODING
+	{
+		IB_ENCODING_RAW = 0,
+		IB_ENCODING_COMPRESSED,
+	};
+
+#pragma pack(push,4)
+
+	struct IB_HEADER
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t PrimitiveType;
+		uint32_t IndexSize;         // 2 or 4 bytes per index
+		uint32_t FaceCount;
+		uint32_t IndexCount;
+		uint64_t IndexOffset;
+		uint32_t Encoding;          // IB_ENCODING
+		uint32_t Reserved;
+		uint64_t DataSize;          // Bytes at IndexOffset
+		uint32_t ChunkCount;
+		uint32_t ChunkVertexCount;
+		uint64_t ChunkOffset;
+		uint64_t ChunkVertexOffset;
+	};
+
+	struct IB_CHUNK
+	{
+		uint32_t AttributeId;
+		uint32_t IndexStart;
+		uint32_t IndexCount;
+		uint32_t VertexStart;
+		uint32_t VertexCount;
+	};
+
+#pragma pack(pop)
+
+} // namespace
+
+static_assert(sizeof(IndexBuffer::IB_HEADER) == 72, "Index buffer structure size incorrect");
+static_assert(sizeof(IndexBuffer::IB_CHUNK) == 20, "Index buffer structure size incorrect");
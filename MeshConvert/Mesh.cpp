@@ -9,6 +9,9 @@
 
 #include "Mesh.h"
 #include "SDKMesh.h"
+#include "MeshletBuffer.h"
+#include "IndexBuffer.h"
+#include "VertexBuffer.h"
 
 using namespace DirectX;
 
@@ -36,10 +39,94 @@ namespace
 		return S_OK;
 	}
 
+	template<typename T> inline HRESULT write_file(HANDLE hFile, const T& value)
+	{
+		DWORD bytesWritten;
+		if (!WriteFile(hFile, &value, static_cast<DWORD>(sizeof(T)), &bytesWritten, nullptr))
+			return HRESULT_FROM_WIN32(GetLastError());
+
+		if (bytesWritten != sizeof(T))
+			return E_FAIL;
+
+		return S_OK;
+	}
+
+	inline HRESULT write_file(HANDLE hFile, const void* data, uint64_t size)
+	{
+		if (!size)
+			return S_OK;
+
+		if (size > UINT32_MAX)
+			return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+		DWORD bytesWritten;
+		if (!WriteFile(hFile, data, static_cast<DWORD>(size), &bytesWritten, nullptr))
+			return HRESULT_FROM_WIN32(GetLastError());
+
+		if (bytesWritten != size)
+			return E_FAIL;
+
+		return S_OK;
+	}
+
 	inline UINT64 roundup4k(UINT64 value)
 	{
 		return ((value + 4095) / 4096) * 4096;
 	}
+
+	// Remapped streams at least this large prefetch their sources this many vertices ahead and
+	// bypass the cache, written a block of vertices at a time
+	const size_t c_StreamingThreshold = 8 * 1024 * 1024;
+	const size_t c_RemapBlock = 64;
+	const size_t c_PrefetchDistance = 16;
+
+	struct RemapStream
+	{
+		const uint8_t*	src;
+		uint8_t*		dst;
+		size_t			stride;
+	};
+
+	template<class T> inline HRESULT AddRemapStream(const std::unique_ptr<T[]>& stream, size_t nVerts, std::unique_ptr<T[]>& result, RemapStream* streams, size_t& count)
+	{
+		if (!stream)
+			return S_OK;
+
+		result.reset(new (std::nothrow) T[nVerts]);
+		if (!result)
+			return E_OUTOFMEMORY;
+
+		static_assert(sizeof(T) <= sizeof(XMVECTOR), "Remap staging holds one XMVECTOR per vertex");
+
+		RemapStream& remap = streams[count++];
+		remap.src = reinterpret_cast<const uint8_t*>(stream.get());
+		remap.dst = reinterpret_cast<uint8_t*>(result.get());
+		remap.stride = sizeof(T);
+
+		return S_OK;
+	}
+
+	// Follows FinalizeIB, where vertices without a remap entry keep their index
+	inline HRESULT RemapIndices(const uint32_t* inverse, size_t nVerts, const uint32_t* ibin, size_t count, uint32_t* ibout)
+	{
+		for (size_t j = 0; j < count; ++j)
+		{
+			uint32_t index = ibin[j];
+			if (index == uint32_t(-1))
+			{
+				ibout[j] = index;
+				continue;
+			}
+
+			if (index >= nVerts)
+				return E_UNEXPECTED;
+
+			uint32_t dest = inverse[index];
+			ibout[j] = (dest == uint32_t(-1)) ? index : dest;
+		}
+
+		return S_OK;
+	}
 }
 
 HRESULT Mesh::SetVertexData(_Inout_ DirectX::VBReader& reader, _In_ size_t nVerts)
@@ -286,6 +373,20 @@ void Mesh::Clear()
 	mColors.reset();
 	mBlendIndices.reset();
 	mBlendWeights.reset();
+
+	// Release meshlet data
+	mMeshlets.clear();
+	mMeshletIndices.clear();
+	mMeshletTriangles.clear();
+	mMeshletCullData.clear();
+
+	// Release LOD data
+	mLODIndices.clear();
+	mLODRanges.clear();
+	mLODErrors.clear();
+
+	mRemapScratch.reset();
+	mnRemapScratch = 0;
 }
 
 HRESULT Mesh::LoadFromObj(const char *inputFile)
@@ -937,6 +1038,720 @@ HRESULT Mesh::ExportToSDKMesh(const char *outputFile)
 	return S_OK;
 }
 
+HRESULT Mesh::ComputeMeshlets(size_t maxVerts, size_t maxPrims)
+{
+	HRESULT hr = GenerateAdjacency();
+	if (FAILED(hr))
+		return hr;
+
+	hr = DirectX::ComputeMeshlets(mIndices.get(), mnFaces, mnVerts, mAdjacency.get(),
+		mMeshlets, mMeshletIndices, mMeshletTriangles, maxVerts, maxPrims);
+	if (FAILED(hr))
+		return hr;
+
+	mMeshletCullData.resize(mMeshlets.size());
+
+	return ComputeCullData(mPositions.get(), mnVerts,
+		mMeshlets.data(), mMeshlets.size(),
+		reinterpret_cast<const uint32_t*>(mMeshletIndices.data()), mMeshletIndices.size() / sizeof(uint32_t),
+		mMeshletTriangles.data(), mMeshletTriangles.size(),
+		mMeshletCullData.data());
+}
+
+HRESULT Mesh::ExportToMeshlets(const char *outputFile) const
+{
+	using namespace MeshletBuffer;
+
+	if (mMeshlets.empty())
+		return E_UNEXPECTED;
+
+	assert(mMeshletCullData.size() == mMeshlets.size());
+
+	// mIndices is 32-bit, so narrow the unique vertex indices when every vertex fits
+	const size_t nIndices = mMeshletIndices.size() / sizeof(uint32_t);
+	const uint32_t* indices = reinterpret_cast<const uint32_t*>(mMeshletIndices.data());
+	const uint32_t indexSize = (mnVerts < UINT16_MAX) ? sizeof(uint16_t) : sizeof(uint32_t);
+
+	std::vector<uint16_t> indices16;
+	if (indexSize == sizeof(uint16_t))
+	{
+		indices16.resize(nIndices);
+		for (size_t j = 0; j < nIndices; ++j)
+		{
+			indices16[j] = static_cast<uint16_t>(indices[j]);
+		}
+	}
+
+	auto align = [](uint64_t value) -> uint64_t
+	{
+		return (value + MESHLET_FILE_ALIGNMENT - 1) & ~uint64_t(MESHLET_FILE_ALIGNMENT - 1);
+	};
+
+	MESHLET_HEADER header = {};
+	header.Magic = MESHLET_FILE_MAGIC;
+	header.Version = MESHLET_FILE_VERSION;
+	header.IndexSize = indexSize;
+	header.MeshletCount = static_cast<uint32_t>(mMeshlets.size());
+	header.UniqueIndexCount = static_cast<uint32_t>(nIndices);
+	header.PrimitiveCount = static_cast<uint32_t>(mMeshletTriangles.size());
+	header.MeshletOffset = align(sizeof(MESHLET_HEADER));
+	header.CullDataOffset = align(header.MeshletOffset + uint64_t(header.MeshletCount) * sizeof(Meshlet));
+	header.UniqueIndexOffset = align(header.CullDataOffset + uint64_t(header.MeshletCount) * sizeof(MeshletCullData));
+	header.PrimitiveOffset = align(header.UniqueIndexOffset + uint64_t(header.UniqueIndexCount) * indexSize);
+
+	ScopedHandle hFile(safe_handle(CreateFile(outputFile, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr)));
+	if (!hFile)
+		return HRESULT_FROM_WIN32(GetLastError());
+
+	static const uint8_t s_padding[MESHLET_FILE_ALIGNMENT] = {};
+	uint64_t written = 0;
+
+	auto writeBlock = [&](uint64_t offset, const void* data, uint64_t size) -> HRESULT
+	{
+		assert(offset >= written && (offset - written) < MESHLET_FILE_ALIGNMENT);
+
+		HRESULT hr = write_file(hFile.get(), s_padding, offset - written);
+		if (FAILED(hr))
+			return hr;
+
+		hr = write_file(hFile.get(), data, size);
+		if (FAILED(hr))
+			return hr;
+
+		written = offset + size;
+		return S_OK;
+	};
+
+	HRESULT hr = write_file(hFile.get(), header);
+	if (FAILED(hr))
+		return hr;
+
+	written = sizeof(MESHLET_HEADER);
+
+	hr = writeBlock(header.MeshletOffset, mMeshlets.data(), uint64_t(header.MeshletCount) * sizeof(Meshlet));
+	if (FAILED(hr))
+		return hr;
+
+	hr = writeBlock(header.CullDataOffset, mMeshletCullData.data(), uint64_t(header.MeshletCount) * sizeof(MeshletCullData));
+	if (FAILED(hr))
+		return hr;
+
+	hr = writeBlock(header.UniqueIndexOffset,
+		(indexSize == sizeof(uint16_t)) ? static_cast<const void*>(indices16.data()) : static_cast<const void*>(indices),
+		uint64_t(header.UniqueIndexCount) * indexSize);
+	if (FAILED(hr))
+		return hr;
+
+	return writeBlock(header.PrimitiveOffset, mMeshletTriangles.data(), uint64_t(header.PrimitiveCount) * sizeof(MeshletTriangle));
+}
+
+HRESULT Mesh::ExportToIndexBuffer(const char *outputFile, bool allowStrips, bool compress, bool allowChunks, bool *usedStrips, size_t *chunkCount)
+{
+	using namespace IndexBuffer;
+
+	if (usedStrips)
+		*usedStrips = false;
+
+	if (chunkCount)
+		*chunkCount = 0;
+
+	if ((uint64_t(mnFaces) * 3) >= UINT32_MAX)
+		return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+	HRESULT hr = GenerateAdjacency();
+	if (FAILED(hr))
+		return hr;
+
+	// mIndices is 32-bit, so narrow when every vertex fits below the 16-bit restart index,
+	// and otherwise split into chunks that each do unless 32-bit indices are allowed
+	const bool chunked = allowChunks && (mnVerts >= UINT16_MAX);
+	const uint32_t indexSize = (chunked || mnVerts < UINT16_MAX) ? sizeof(uint16_t) : sizeof(uint32_t);
+	const size_t nListIndices = mnFaces * 3;
+
+	std::vector<uint16_t> indices16;
+	std::vector<uint32_t> indices32;
+	std::vector<IndexChunk> chunks;
+	std::vector<uint32_t> chunkVertices;
+	if (chunked)
+	{
+		indices16.resize(nListIndices);
+		hr = ComputeIndexChunks(mIndices.get(), mnFaces, mnVerts, nullptr, chunks, chunkVertices, indices16.data());
+		if (FAILED(hr))
+			return hr;
+	}
+	else if (indexSize == sizeof(uint16_t))
+	{
+		indices16.resize(nListIndices);
+		for (size_t j = 0; j < nListIndices; ++j)
+		{
+			indices16[j] = static_cast<uint16_t>(mIndices[j]);
+		}
+	}
+	else
+	{
+		indices32.assign(mIndices.get(), mIndices.get() + nListIndices);
+	}
+
+	// list ranges of each chunk, replaced below if strips are used
+	std::vector<std::pair<size_t, size_t>> chunkRanges;
+	chunkRanges.reserve(chunks.size());
+	for (auto it = chunks.cbegin(); it != chunks.cend(); ++it)
+	{
+		chunkRanges.emplace_back(size_t(it->FaceOffset) * 3, size_t(it->FaceCount) * 3);
+	}
+
+	// compressed lists are smaller than strips, so strips are only considered for raw output
+	bool strips = false;
+	if (allowStrips && !compress)
+	{
+		// keep the strips only if they are smaller than the triangle list
+		if (chunked)
+		{
+			// strips must not cross chunks, so each chunk is its own attribute group
+			std::unique_ptr<uint32_t[]> chunkIds(new (std::nothrow) uint32_t[mnFaces]);
+			if (!chunkIds)
+				return E_OUTOFMEMORY;
+
+			for (size_t j = 0; j < chunks.size(); ++j)
+			{
+				std::fill_n(&chunkIds[chunks[j].FaceOffset], chunks[j].FaceCount, static_cast<uint32_t>(j));
+			}
+
+			std::vector<uint16_t> strip16;
+			std::vector<std::pair<size_t, size_t>> stripRanges;
+			hr = GenerateStripsEx(indices16.data(), mnFaces, mAdjacency.get(), chunkIds.get(), strip16, stripRanges);
+			if (FAILED(hr))
+				return hr;
+
+			if (stripRanges.size() != chunks.size())
+				return E_UNEXPECTED;
+
+			if (strip16.size() < nListIndices)
+			{
+				indices16.swap(strip16);
+				chunkRanges.swap(stripRanges);
+				strips = true;
+			}
+		}
+		else if (indexSize == sizeof(uint16_t))
+		{
+			std::vector<uint16_t> strip16;
+			hr = GenerateStrips(indices16.data(), mnFaces, mAdjacency.get(), strip16);
+			if (FAILED(hr))
+				return hr;
+
+			if (strip16.size() < nListIndices)
+			{
+				indices16.swap(strip16);
+				strips = true;
+			}
+		}
+		else
+		{
+			std::vector<uint32_t> strip32;
+			hr = GenerateStrips(indices32.data(), mnFaces, mAdjacency.get(), strip32);
+			if (FAILED(hr))
+				return hr;
+
+			if (strip32.size() < nListIndices)
+			{
+				indices32.swap(strip32);
+				strips = true;
+			}
+		}
+	}
+
+	IB_HEADER header = {};
+	header.Magic = IB_FILE_MAGIC;
+	header.Version = IB_FILE_VERSION;
+	header.PrimitiveType = strips ? DXUT::PT_TRIANGLE_STRIP : DXUT::PT_TRIANGLE_LIST;
+	header.IndexSize = indexSize;
+	header.FaceCount = static_cast<uint32_t>(mnFaces);
+	header.IndexCount = static_cast<uint32_t>((indexSize == sizeof(uint16_t)) ? indices16.size() : indices32.size());
+	header.IndexOffset = sizeof(IB_HEADER);
+	header.Encoding = IB_ENCODING_RAW;
+	header.DataSize = uint64_t(header.IndexCount) * indexSize;
+
+	std::vector<uint8_t> compressed;
+	if (compress)
+	{
+		if (indexSize == sizeof(uint16_t))
+		{
+			hr = CompressIndexBuffer(indices16.data(), mnFaces, compressed);
+		}
+		else
+		{
+			hr = CompressIndexBuffer(indices32.data(), mnFaces, compressed);
+		}
+		if (FAILED(hr))
+			return hr;
+
+		// verify the round trip before writing anything
+		bool match;
+		if (indexSize == sizeof(uint16_t))
+		{
+			std::vector<uint16_t> decoded(nListIndices);
+			hr = DecompressIndexBuffer(compressed.data(), compressed.size(), decoded.data(), mnFaces);
+			match = (decoded == indices16);
+		}
+		else
+		{
+			std::vector<uint32_t> decoded(nListIndices);
+			hr = DecompressIndexBuffer(compressed.data(), compressed.size(), decoded.data(), mnFaces);
+			match = (decoded == indices32);
+		}
+		if (FAILED(hr))
+			return hr;
+
+		if (!match)
+			return E_FAIL;
+
+		header.Encoding = IB_ENCODING_COMPRESSED;
+		header.DataSize = compressed.size();
+	}
+
+	std::vector<IB_CHUNK> chunkTable;
+	if (chunked)
+	{
+		chunkTable.resize(chunks.size());
+		for (size_t j = 0; j < chunks.size(); ++j)
+		{
+			IB_CHUNK& chunk = chunkTable[j];
+			chunk.AttributeId = chunks[j].AttributeId;
+			chunk.IndexStart = static_cast<uint32_t>(chunkRanges[j].first);
+			chunk.IndexCount = static_cast<uint32_t>(chunkRanges[j].second);
+			chunk.VertexStart = chunks[j].VertOffset;
+			chunk.VertexCount = chunks[j].VertCount;
+		}
+
+		header.ChunkCount = static_cast<uint32_t>(chunkTable.size());
+		header.ChunkVertexCount = static_cast<uint32_t>(chunkVertices.size());
+		header.ChunkOffset = (header.IndexOffset + header.DataSize + 3) & ~uint64_t(3);
+		header.ChunkVertexOffset = header.ChunkOffset + uint64_t(header.ChunkCount) * sizeof(IB_CHUNK);
+	}
+
+	ScopedHandle hFile(safe_handle(CreateFile(outputFile, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr)));
+	if (!hFile)
+		return HRESULT_FROM_WIN32(GetLastError());
+
+	hr = write_file(hFile.get(), header);
+	if (FAILED(hr))
+		return hr;
+
+	const void* data = compress ? static_cast<const void*>(compressed.data())
+		: (indexSize == sizeof(uint16_t)) ? static_cast<const void*>(indices16.data())
+		: static_cast<const void*>(indices32.data());
+
+	hr = write_file(hFile.get(), data, header.DataSize);
+	if (FAILED(hr))
+		return hr;
+
+	if (chunked)
+	{
+		static const uint8_t s_padding[4] = {};
+		hr = write_file(hFile.get(), s_padding, header.ChunkOffset - header.IndexOffset - header.DataSize);
+		if (FAILED(hr))
+			return hr;
+
+		hr = write_file(hFile.get(), chunkTable.data(), uint64_t(header.ChunkCount) * sizeof(IB_CHUNK));
+		if (FAILED(hr))
+			return hr;
+
+		hr = write_file(hFile.get(), chunkVertices.data(), uint64_t(header.ChunkVertexCount) * sizeof(uint32_t));
+		if (FAILED(hr))
+			return hr;
+	}
+
+	if (usedStrips)
+		*usedStrips = strips;
+
+	if (chunkCount)
+		*chunkCount = chunkTable.size();
+
+	return S_OK;
+}
+
+HRESULT Mesh::ExportToVertexBuffer(const char *outputFile, bool compact, XMFLOAT3 *positionScale, XMFLOAT3 *positionBias) const
+{
+	using namespace VertexBuffer;
+
+	if (!mnVerts || !mPositions)
+		return E_UNEXPECTED;
+
+	if (mnVerts >= UINT32_MAX)
+		return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+	// One element per attribute the mesh has. The compact tangent keeps the bitangent sign,
+	// so the shader rebuilds the bitangent rather than reading it.
+	D3D11_INPUT_ELEMENT_DESC layout[8] = {};
+	size_t nDecl = 0;
+
+	auto addElement = [&](const char* name, DXGI_FORMAT format)
+	{
+		D3D11_INPUT_ELEMENT_DESC desc = { name, 0, format, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 };
+		layout[nDecl++] = desc;
+	};
+
+	addElement("SV_Position", compact ? VBFORMAT_QUANTIZED_POSITION_16 : DXGI_FORMAT_R32G32B32_FLOAT);
+
+	if (mNormals)
+		addElement("NORMAL", compact ? VBFORMAT_OCTAHEDRAL_NORMAL_16 : DXGI_FORMAT_R32G32B32_FLOAT);
+
+	if (mTangents)
+		addElement("TANGENT", compact ? VBFORMAT_OCTAHEDRAL_TANGENT_8 : DXGI_FORMAT_R32G32B32A32_FLOAT);
+
+	if (mBiTangents && !compact)
+		addElement("BINORMAL", DXGI_FORMAT_R32G32B32_FLOAT);
+
+	if (mTexCoords)
+		addElement("TEXCOORD", DXGI_FORMAT_R32G32_FLOAT);
+
+	if (mColors)
+		addElement("COLOR", DXGI_FORMAT_B8G8R8A8_UNORM);
+
+	if (mBlendIndices)
+		addElement("BLENDINDICES", DXGI_FORMAT_R8G8B8A8_UINT);
+
+	if (mBlendWeights)
+		addElement("BLENDWEIGHT", DXGI_FORMAT_R8G8B8A8_UNORM);
+
+	VBWriter writer;
+	HRESULT hr = writer.Initialize(layout, nDecl);
+	if (FAILED(hr))
+		return hr;
+
+	uint32_t strides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+	ComputeInputLayout(layout, nDecl, nullptr, strides);
+
+	const size_t bytes = mnVerts * strides[0];
+
+	std::unique_ptr<uint8_t[]> vb(new (std::nothrow) uint8_t[bytes]);
+	if (!vb)
+		return E_OUTOFMEMORY;
+
+	memset(vb.get(), 0, bytes);
+
+	hr = writer.AddStream(vb.get(), mnVerts, 0, strides[0]);
+	if (FAILED(hr))
+		return hr;
+
+	// The whole mesh shares one bounding box, as subsets can share vertices
+	XMFLOAT3 scale(1.f, 1.f, 1.f);
+	XMFLOAT3 bias(0.f, 0.f, 0.f);
+	if (compact)
+	{
+		ComputeQuantization(mPositions.get(), mnVerts, scale, bias);
+
+		hr = writer.SetQuantization("SV_Position", 0, scale, bias);
+		if (FAILED(hr))
+			return hr;
+	}
+
+	hr = GetVertexBuffer(writer);
+	if (FAILED(hr))
+		return hr;
+
+	VB_HEADER header = {};
+	header.Magic = VB_FILE_MAGIC;
+	header.Version = VB_FILE_VERSION;
+	header.VertexCount = static_cast<uint32_t>(mnVerts);
+	header.Stride = strides[0];
+	header.ElementCount = static_cast<uint32_t>(nDecl);
+	header.ElementOffset = sizeof(VB_HEADER);
+	header.VertexOffset = header.ElementOffset + uint64_t(nDecl) * sizeof(VB_ELEMENT);
+	header.PositionScale[0] = scale.x;
+	header.PositionScale[1] = scale.y;
+	header.PositionScale[2] = scale.z;
+	header.PositionBias[0] = bias.x;
+	header.PositionBias[1] = bias.y;
+	header.PositionBias[2] = bias.z;
+
+	VB_ELEMENT elements[_countof(layout)] = {};
+	for (size_t j = 0; j < nDecl; ++j)
+	{
+		auto desc = writer.GetElement11(layout[j].SemanticName, layout[j].SemanticIndex);
+		if (!desc)
+			return E_UNEXPECTED;
+
+		strcpy_s(elements[j].SemanticName, desc->SemanticName);
+		elements[j].SemanticIndex = desc->SemanticIndex;
+		elements[j].Format = GetStorageFormat(desc->Format);
+		elements[j].AlignedByteOffset = desc->AlignedByteOffset;
+
+		switch (static_cast<int>(desc->Format))
+		{
+		case VBFORMAT_OCTAHEDRAL_NORMAL_8:
+		case VBFORMAT_OCTAHEDRAL_NORMAL_16:
+			elements[j].Encoding = VB_ENCODING_OCTAHEDRAL;
+			break;
+
+		case VBFORMAT_OCTAHEDRAL_TANGENT_8:
+		case VBFORMAT_OCTAHEDRAL_TANGENT_16:
+			elements[j].Encoding = VB_ENCODING_OCTAHEDRAL_SIGN;
+			break;
+
+		case VBFORMAT_QUANTIZED_POSITION_16:
+			elements[j].Encoding = VB_ENCODING_QUANTIZED;
+			break;
+
+		default:
+			elements[j].Encoding = VB_ENCODING_NONE;
+			break;
+		}
+	}
+
+	ScopedHandle hFile(safe_handle(CreateFile(outputFile, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr)));
+	if (!hFile)
+		return HRESULT_FROM_WIN32(GetLastError());
+
+	hr = write_file(hFile.get(), header);
+	if (FAILED(hr))
+		return hr;
+
+	hr = write_file(hFile.get(), elements, uint64_t(nDecl) * sizeof(VB_ELEMENT));
+	if (FAILED(hr))
+		return hr;
+
+	hr = write_file(hFile.get(), vb.get(), bytes);
+	if (FAILED(hr))
+		return hr;
+
+	if (positionScale)
+		*positionScale = scale;
+
+	if (positionBias)
+		*positionBias = bias;
+
+	return S_OK;
+}
+
+HRESULT Mesh::ComputeVertexCacheMissRate(size_t cacheSize, VCACHE_MODEL model, float& acmr, float& atvr) const
+{
+	if (!mnFaces || !mIndices || !mnVerts)
+		return E_UNEXPECTED;
+
+	DirectX::ComputeVertexCacheMissRate(mIndices.get(), mnFaces, mnVerts, cacheSize, model, acmr, atvr);
+
+	return (acmr < 0.f) ? E_FAIL : S_OK;
+}
+
+// Reorders the faces for the post-transform vertex cache, then the vertices in order of first use
+HRESULT Mesh::Optimize(uint32_t vertexCache)
+{
+	HRESULT hr = GenerateAdjacency();
+	if (FAILED(hr))
+		return hr;
+
+	std::unique_ptr<uint32_t[]> remap(new (std::nothrow) uint32_t[std::max<size_t>(mnFaces, mnVerts)]);
+	if (!remap)
+		return E_OUTOFMEMORY;
+
+	hr = OptimizeFaces(mIndices.get(), mnFaces, mAdjacency.get(), remap.get(), vertexCache);
+	if (FAILED(hr))
+		return hr;
+
+	hr = ReorderIB(mIndices.get(), mnFaces, remap.get());
+	if (FAILED(hr))
+		return hr;
+
+	// derived face data no longer matches
+	mAdjacency.reset();
+
+	hr = OptimizeVertices(mIndices.get(), mnFaces, mnVerts, remap.get());
+	if (FAILED(hr))
+		return hr;
+
+	return ApplyRemap(remap.get());
+}
+
+HRESULT Mesh::ComputeLODs(size_t count, bool clustering)
+{
+	if (!mnFaces || !mIndices || !mnVerts || !mPositions || !count)
+		return E_UNEXPECTED;
+
+	std::unique_ptr<uint32_t[]> pointRep(new (std::nothrow) uint32_t[mnVerts]);
+	if (!pointRep)
+		return E_OUTOFMEMORY;
+
+	HRESULT hr = GenerateAdjacencyAndPointReps(mIndices.get(), mnFaces, mPositions.get(), mnVerts, 0.f, pointRep.get(), nullptr);
+	if (FAILED(hr))
+		return hr;
+
+	// each LOD has half the faces of the one before
+	std::vector<size_t> targetFaces(count);
+	size_t faces = mnFaces;
+	for (size_t j = 0; j < count; ++j)
+	{
+		faces = std::max<size_t>(faces / 2, 1);
+		targetFaces[j] = faces;
+	}
+
+	mLODErrors.resize(count);
+
+	if (clustering)
+	{
+		hr = ComputeClusteredLODs(pointRep.get(), targetFaces);
+	}
+	else
+	{
+		hr = GenerateLODs(mIndices.get(), mnFaces, mPositions.get(), mnVerts, pointRep.get(),
+			targetFaces.data(), count, mLODIndices, mLODRanges, mLODErrors.data());
+	}
+
+	if (FAILED(hr))
+	{
+		mLODIndices.clear();
+		mLODRanges.clear();
+		mLODErrors.clear();
+	}
+
+	return hr;
+}
+
+// Each LOD uses the finest grid that reaches its face target, found by bisection as every
+// clustering pass is linear
+HRESULT Mesh::ComputeClusteredLODs(const uint32_t* pointRep, const std::vector<size_t>& targetFaces)
+{
+	std::unique_ptr<uint32_t[]> ib(new (std::nothrow) uint32_t[mnFaces * 3]);
+	std::unique_ptr<uint32_t[]> best(new (std::nothrow) uint32_t[mnFaces * 3]);
+	if (!ib || !best)
+		return E_OUTOFMEMORY;
+
+	XMVECTOR vMin = XMLoadFloat3(&mPositions[0]);
+	XMVECTOR vMax = vMin;
+	for (size_t j = 1; j < mnVerts; ++j)
+	{
+		XMVECTOR p = XMLoadFloat3(&mPositions[j]);
+		vMin = XMVectorMin(vMin, p);
+		vMax = XMVectorMax(vMax, p);
+	}
+
+	XMFLOAT3 extent;
+	XMStoreFloat3(&extent, XMVectorSubtract(vMax, vMin));
+
+	float maxExtent = std::max<float>(std::max<float>(extent.x, extent.y), extent.z);
+
+	mLODIndices.clear();
+	mLODRanges.clear();
+
+	size_t maxGrid = 1024;
+	for (size_t j = 0; j < targetFaces.size(); ++j)
+	{
+		size_t lo = 1;
+		size_t hi = maxGrid;
+		size_t bestGrid = 0;
+		size_t bestFaces = 0;
+
+		while (lo <= hi)
+		{
+			size_t grid = (lo + hi) / 2;
+
+			memcpy(ib.get(), mIndices.get(), sizeof(uint32_t) * mnFaces * 3);
+
+			size_t faces = 0;
+			HRESULT hr = SimplifyByClustering(ib.get(), mnFaces, mPositions.get(), mnVerts, pointRep, grid, nullptr, &faces);
+			if (FAILED(hr))
+				return hr;
+
+			// prefer the finest grid within the target, otherwise the fewest faces
+			bool better = (faces <= targetFaces[j])
+				? (bestFaces > targetFaces[j] || grid > bestGrid)
+				: (bestFaces > targetFaces[j] && faces < bestFaces);
+
+			if (!bestGrid || better)
+			{
+				bestGrid = grid;
+				bestFaces = faces;
+				std::swap(ib, best);
+			}
+
+			if (faces <= targetFaces[j])
+			{
+				lo = grid + 1;
+			}
+			else
+			{
+				hi = grid - 1;
+			}
+		}
+
+		size_t offset = mLODIndices.size();
+		mLODIndices.reserve(offset + bestFaces * 3);
+		for (size_t face = 0; face < mnFaces; ++face)
+		{
+			const uint32_t* f = &best[face * 3];
+			if (f[0] == uint32_t(-1))
+				continue;
+
+			mLODIndices.insert(mLODIndices.end(), f, f + 3);
+		}
+		mLODRanges.emplace_back(offset, mLODIndices.size() - offset);
+
+		// points move at most one cell diagonal
+		mLODErrors[j] = maxExtent * 1.7320508f / float(bestGrid);
+
+		maxGrid = bestGrid;
+	}
+
+	return S_OK;
+}
+
+// LOD 0 is the full mesh, which is not kept once another LOD is selected
+HRESULT Mesh::SelectLOD(size_t lod, size_t *nFaces, float *error)
+{
+	if (!lod || lod > mLODRanges.size())
+		return E_INVALIDARG;
+
+	const auto& range = mLODRanges[lod - 1];
+	if (!range.second)
+		return E_FAIL;
+
+	mnFaces = range.second / 3;
+
+	mIndices.reset(new (std::nothrow) uint32_t[range.second]);
+	if (!mIndices)
+		return E_OUTOFMEMORY;
+
+	memcpy(mIndices.get(), mLODIndices.data() + range.first, sizeof(uint32_t) * range.second);
+
+	// derived face data no longer matches
+	mAdjacency.reset();
+	mMeshlets.clear();
+	mMeshletIndices.clear();
+	mMeshletTriangles.clear();
+	mMeshletCullData.clear();
+
+	if (nFaces)
+		*nFaces = mnFaces;
+
+	if (error)
+		*error = mLODErrors[lod - 1];
+
+	return S_OK;
+}
+
+HRESULT Mesh::GenerateAdjacency()
+{
+	if (!mnFaces || !mIndices || !mnVerts || !mPositions)
+		return E_UNEXPECTED;
+
+	if (mAdjacency)
+		return S_OK;
+
+	mAdjacency.reset(new (std::nothrow) uint32_t[mnFaces * 3]);
+	if (!mAdjacency)
+		return E_OUTOFMEMORY;
+
+	HRESULT hr = GenerateAdjacencyAndPointReps(mIndices.get(), mnFaces, mPositions.get(), mnVerts, 0.f, nullptr, mAdjacency.get());
+	if (FAILED(hr))
+	{
+		mAdjacency.reset();
+		return hr;
+	}
+
+	return S_OK;
+}
+
 HRESULT Mesh::SetIndexBuffer32(const std::unique_ptr<uint16_t[]> &ib16, const size_t nFaces)
 {
 	if (!nFaces)
@@ -971,3 +1786,215 @@ HRESULT Mesh::SetIndexBuffer32(const std::unique_ptr<uint16_t[]> &ib16, const si
 
 	return S_OK;
 }
+
+
+// Applies a vertex remap and/or vertex duplication set, as FinalizeVB and FinalizeIB would, to every
+// vertex stream in one gather and to the index buffers
+HRESULT Mesh::ApplyRemap(const uint32_t *vertexRemap, const uint32_t *dupVerts, size_t nDupVerts)
+{
+	if (!mnFaces || !mIndices || !mnVerts || !mPositions)
+		return E_UNEXPECTED;
+
+	if (!vertexRemap && !dupVerts)
+		return E_INVALIDARG;
+
+	if ((dupVerts != nullptr) != (nDupVerts > 0))
+		return E_INVALIDARG;
+
+	if ((uint64_t(mnVerts) + uint64_t(nDupVerts)) >= UINT32_MAX)
+		return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+	const size_t nVerts = mnVerts + nDupVerts;
+
+	// The scratch holds the source vertex for each output, then the inverse remap for the indices
+	if (mnRemapScratch < nVerts * 2)
+	{
+		mRemapScratch.reset(new (std::nothrow) uint32_t[nVerts * 2]);
+		if (!mRemapScratch)
+		{
+			mnRemapScratch = 0;
+			return E_OUTOFMEMORY;
+		}
+
+		mnRemapScratch = nVerts * 2;
+	}
+
+	uint32_t* source = mRemapScratch.get();
+	uint32_t* inverse = source + nVerts;
+
+	memset(inverse, 0xff, sizeof(uint32_t) * nVerts);
+
+	for (size_t j = 0; j < nVerts; ++j)
+	{
+		uint32_t src = (vertexRemap) ? vertexRemap[j] : uint32_t(j);
+		if (src == uint32_t(-1))
+		{
+			source[j] = src;
+			continue;
+		}
+
+		if (src >= nVerts)
+			return E_FAIL;
+
+		inverse[src] = uint32_t(j);
+
+		if (src < mnVerts)
+		{
+			source[j] = src;
+		}
+		else if (dupVerts)
+		{
+			source[j] = dupVerts[src - mnVerts];
+			if (source[j] >= mnVerts)
+				return E_FAIL;
+		}
+		else
+			return E_FAIL;
+	}
+
+	std::unique_ptr<uint32_t[]> indices(new (std::nothrow) uint32_t[mnFaces * 3]);
+	if (!indices)
+		return E_OUTOFMEMORY;
+
+	std::vector<uint32_t> lodIndices(mLODIndices.size());
+
+	std::unique_ptr<XMFLOAT3[]> positions;
+	std::unique_ptr<XMFLOAT3[]> normals;
+	std::unique_ptr<XMFLOAT4[]> tangents;
+	std::unique_ptr<XMFLOAT3[]> bitangents;
+	std::unique_ptr<XMFLOAT2[]> texcoords;
+	std::unique_ptr<XMFLOAT4[]> colors;
+	std::unique_ptr<XMFLOAT4[]> blendIndices;
+	std::unique_ptr<XMFLOAT4[]> blendWeights;
+
+	RemapStream streams[8];
+	size_t nStreams = 0;
+
+	HRESULT hr = AddRemapStream(mPositions, nVerts, positions, streams, nStreams);
+	if (SUCCEEDED(hr))
+		hr = AddRemapStream(mNormals, nVerts, normals, streams, nStreams);
+	if (SUCCEEDED(hr))
+		hr = AddRemapStream(mTangents, nVerts, tangents, streams, nStreams);
+	if (SUCCEEDED(hr))
+		hr = AddRemapStream(mBiTangents, nVerts, bitangents, streams, nStreams);
+	if (SUCCEEDED(hr))
+		hr = AddRemapStream(mTexCoords, nVerts, texcoords, streams, nStreams);
+	if (SUCCEEDED(hr))
+		hr = AddRemapStream(mColors, nVerts, colors, streams, nStreams);
+	if (SUCCEEDED(hr))
+		hr = AddRemapStream(mBlendIndices, nVerts, blendIndices, streams, nStreams);
+	if (SUCCEEDED(hr))
+		hr = AddRemapStream(mBlendWeights, nVerts, blendWeights, streams, nStreams);
+	if (FAILED(hr))
+		return hr;
+
+	size_t vertexSize = 0;
+	for (size_t k = 0; k < nStreams; ++k)
+	{
+		vertexSize += streams[k].stride;
+	}
+
+	// Outputs too large to stay in cache are gathered into a staging block, then written with non-temporal
+	// stores so they don't evict the sources. Streams that aren't 16-byte aligned are written directly.
+	const bool streaming = (vertexSize * nVerts) >= c_StreamingThreshold;
+
+	// The index buffers are remapped in the same pass, an equal share of them per block of vertices
+	const size_t nBlocks = (nVerts + c_RemapBlock - 1) / c_RemapBlock;
+	const size_t nIndices = mnFaces * 3;
+	const size_t ibBlock = (nIndices + nBlocks - 1) / nBlocks;
+	const size_t lodBlock = (mLODIndices.size() + nBlocks - 1) / nBlocks;
+
+	XMVECTOR staging[c_RemapBlock];
+
+	for (size_t block = 0; block < nBlocks; ++block)
+	{
+		const size_t base = block * c_RemapBlock;
+		const size_t count = std::min<size_t>(c_RemapBlock, nVerts - base);
+
+		size_t first = block * ibBlock;
+		if (first < nIndices)
+		{
+			hr = RemapIndices(inverse, nVerts, mIndices.get() + first, std::min<size_t>(ibBlock, nIndices - first), indices.get() + first);
+			if (FAILED(hr))
+				return hr;
+		}
+
+		first = block * lodBlock;
+		if (first < mLODIndices.size())
+		{
+			hr = RemapIndices(inverse, nVerts, mLODIndices.data() + first, std::min<size_t>(lodBlock, mLODIndices.size() - first), lodIndices.data() + first);
+			if (FAILED(hr))
+				return hr;
+		}
+
+		for (size_t k = 0; k < nStreams; ++k)
+		{
+			const RemapStream& stream = streams[k];
+			uint8_t* dest = stream.dst + base * stream.stride;
+
+			const bool nonTemporal = streaming && !(reinterpret_cast<uintptr_t>(stream.dst) & 0xF);
+			uint8_t* dptr = nonTemporal ? reinterpret_cast<uint8_t*>(staging) : dest;
+
+			for (size_t j = 0; j < count; ++j)
+			{
+				const size_t vert = base + j;
+				if (streaming && vert + c_PrefetchDistance < nVerts)
+				{
+					uint32_t ahead = source[vert + c_PrefetchDistance];
+					if (ahead != uint32_t(-1))
+					{
+						_mm_prefetch(reinterpret_cast<const char*>(stream.src + ahead * stream.stride), _MM_HINT_T0);
+					}
+				}
+
+				uint32_t src = source[vert];
+				if (src == uint32_t(-1))
+				{
+					// remap entry is unused
+					memset(dptr + j * stream.stride, 0, stream.stride);
+				}
+				else
+				{
+					memcpy(dptr + j * stream.stride, stream.src + src * stream.stride, stream.stride);
+				}
+			}
+
+			if (nonTemporal)
+			{
+				const size_t bytes = count * stream.stride;
+				const size_t vectors = bytes / sizeof(__m128i);
+
+				for (size_t v = 0; v < vectors; ++v)
+				{
+					_mm_stream_si128(reinterpret_cast<__m128i*>(dest) + v, _mm_castps_si128(staging[v]));
+				}
+
+				memcpy(dest + vectors * sizeof(__m128i), reinterpret_cast<const uint8_t*>(staging) + vectors * sizeof(__m128i), bytes - vectors * sizeof(__m128i));
+			}
+		}
+	}
+
+	if (streaming)
+		_mm_sfence();
+
+	mnVerts = nVerts;
+	mIndices.swap(indices);
+	mLODIndices.swap(lodIndices);
+
+	mPositions.swap(positions);
+	mNormals.swap(normals);
+	mTangents.swap(tangents);
+	mBiTangents.swap(bitangents);
+	mTexCoords.swap(texcoords);
+	mColors.swap(colors);
+	mBlendIndices.swap(blendIndices);
+	mBlendWeights.swap(blendWeights);
+
+	// meshlets refer to the old vertices
+	mMeshlets.clear();
+	mMeshletIndices.clear();
+	mMeshletTriangles.clear();
+	mMeshletCullData.clear();
+
+	return S_OK;
+}
@@ -12,7 +12,7 @@
 class Mesh
 {
 public:
-	Mesh() noexcept : mnFaces(0), mnVerts(0) {};
+	Mesh() noexcept : mnFaces(0), mnVerts(0), mnRemapScratch(0) {};
 
 	void Clear();
 
@@ -24,8 +24,28 @@ public:
 
 	HRESULT ExportToSDKMesh(const char *outputFile);
 
+	HRESULT ComputeMeshlets(size_t maxVerts = DirectX::MESHLET_DEFAULT_MAX_VERTS, size_t maxPrims = DirectX::MESHLET_DEFAULT_MAX_PRIMS);
+
+	HRESULT ExportToMeshlets(const char *outputFile) const;
+
+	HRESULT ExportToIndexBuffer(const char *outputFile, bool allowStrips, bool compress, bool allowChunks, bool *usedStrips = nullptr, size_t *chunkCount = nullptr);
+
+	HRESULT ExportToVertexBuffer(const char *outputFile, bool compact, DirectX::XMFLOAT3 *positionScale = nullptr, DirectX::XMFLOAT3 *positionBias = nullptr) const;
+
+	HRESULT ComputeVertexCacheMissRate(size_t cacheSize, DirectX::VCACHE_MODEL model, float& acmr, float& atvr) const;
+
+	HRESULT Optimize(uint32_t vertexCache = DirectX::OPTFACES_V_DEFAULT);
+
+	HRESULT ComputeLODs(size_t count, bool clustering = false);
+
+	size_t GetLODCount() const { return mLODRanges.size(); }
+
+	HRESULT SelectLOD(size_t lod, size_t *nFaces = nullptr, float *error = nullptr);
+
 	HRESULT SetIndexBuffer32(const std::unique_ptr<uint16_t[]> &ib16, const size_t nFaces);
 
+	HRESULT ApplyRemap(const uint32_t *vertexRemap, const uint32_t *dupVerts = nullptr, size_t nDupVerts = 0);
+
 	struct Material
 	{
 		std::wstring        name;
@@ -128,6 +148,8 @@ public:
 	};
 private:
 
+	HRESULT GenerateAdjacency();
+	HRESULT ComputeClusteredLODs(const uint32_t* pointRep, const std::vector<size_t>& targetFaces);
 	HRESULT SetVertexData(_Inout_ DirectX::VBReader& reader, _In_ size_t nVerts);
 	HRESULT GetVertexBuffer(_Inout_ DirectX::VBWriter& writer) const;
 
@@ -147,6 +169,15 @@ private:
 	std::unique_ptr<DirectX::XMFLOAT4[]>		mBlendIndices;
 	std::unique_ptr<DirectX::XMFLOAT4[]>		mBlendWeights;
 	std::unique_ptr<Material[]>					mMaterials;
+	std::vector<DirectX::Meshlet>				mMeshlets;
+	std::vector<uint8_t>						mMeshletIndices;
+	std::vector<DirectX::MeshletTriangle>		mMeshletTriangles;
+	std::vector<DirectX::MeshletCullData>		mMeshletCullData;
+	std::vector<uint32_t>						mLODIndices;
+	std::vector<std::pair<size_t, size_t>>		mLODRanges;
+	std::vector<float>							mLODErrors;
+	std::unique_ptr<uint32_t[]>					mRemapScratch;
+	size_t										mnRemapScratch;
 };
 
 #endif // !MESH_CONVERT_MESH_CLASS
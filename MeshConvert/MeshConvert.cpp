@@ -13,7 +13,17 @@ enum OPTIONS
 	OPT_OUT_OBJ,
 	OPT_OUT_SDKMESH,
 	OPT_IN_OBJ,
-	OPT_IN_SDKMESH
+	OPT_IN_SDKMESH,
+	OPT_MESHLETS,
+	OPT_VCACHE_REPORT,
+	OPT_STRIPS,
+	OPT_IB_COMPRESS,
+	OPT_IB_32BIT,
+	OPT_LODS,
+	OPT_LOD_CLUSTERING,
+	OPT_VB,
+	OPT_VB_COMPACT,
+	OPT_OPTIMIZE
 };
 
 struct SConversion
@@ -32,7 +42,17 @@ const SValue g_pOptions[] =
 	{ "i",			OPT_INPUT },
 	{ "o",			OPT_OUTPUT },
 	{ "obj",		OPT_OUT_OBJ },
-	{ "sdkmesh",	OPT_OUT_SDKMESH }
+	{ "sdkmesh",	OPT_OUT_SDKMESH },
+	{ "meshlet",	OPT_MESHLETS },
+	{ "vcache",		OPT_VCACHE_REPORT },
+	{ "strip",		OPT_STRIPS },
+	{ "ibcompress",	OPT_IB_COMPRESS },
+	{ "ib32",		OPT_IB_32BIT },
+	{ "lod",		OPT_LODS },
+	{ "lodcluster",	OPT_LOD_CLUSTERING },
+	{ "vb",			OPT_VB },
+	{ "vbcompact",	OPT_VB_COMPACT },
+	{ "op",			OPT_OPTIMIZE }
 };
 
 namespace
@@ -140,6 +160,16 @@ namespace
 			<< "	-o			Output file\n"
 			<< "	-obj		Format outfile Obj\n"
 			<< "	-sdkmesh	Format outfile Sdkmesh\n"
+			<< "	-meshlet	Also write meshlets to a .meshlet file next to the outfile\n"
+			<< "	-vcache		Report ACMR/ATVR of the input for FIFO, LRU, and batch vertex caches\n"
+			<< "	-strip		Also write a .ib index buffer, as strips with restarts when smaller than the list\n"
+			<< "	-ibcompress	Also write a .ib index buffer, compressed\n"
+			<< "	-ib32		Keep 32-bit indices in the .ib rather than splitting large meshes into 16-bit chunks\n"
+			<< "	-lod[:n]	Also write n simplified LODs (default 4), each with half the faces, as outfile_LODn\n"
+			<< "	-lodcluster	Simplify the -lod LODs by fast vertex clustering rather than edge collapses\n"
+			<< "	-vb			Also write a .vb vertex buffer with full precision elements\n"
+			<< "	-vbcompact	Also write a .vb vertex buffer with quantized positions and octahedral normals and tangents\n"
+			<< "	-op			Reorder the faces for the vertex cache and the vertices in order of use before writing\n"
 			<< "Example: meshtransform -i test.obj -o test.sdkmesh\n"
 			<< "		  meshtransform -i test.sdkmesh -obj\n\n";
 	}
@@ -155,6 +185,8 @@ int main(int argc, char* argv[])
 	char inputFile[MAX_PATH] = "";
 	char outputFile[MAX_PATH] = "";
 
+	size_t lodCount = 4;
+
 	Mesh mesh;
 
 	for (int iArg = 1; iArg < argc; iArg++)
@@ -208,6 +240,47 @@ int main(int argc, char* argv[])
 			case OPT_OUT_SDKMESH:
 				dwOptions |= (1 << OPT_OUT_SDKMESH);
 				break;
+			case OPT_MESHLETS:
+				dwOptions |= (1 << OPT_MESHLETS);
+				break;
+			case OPT_VCACHE_REPORT:
+				dwOptions |= (1 << OPT_VCACHE_REPORT);
+				break;
+			case OPT_STRIPS:
+				dwOptions |= (1 << OPT_STRIPS);
+				break;
+			case OPT_IB_COMPRESS:
+				dwOptions |= (1 << OPT_IB_COMPRESS);
+				break;
+			case OPT_IB_32BIT:
+				dwOptions |= (1 << OPT_IB_32BIT);
+				break;
+			case OPT_LODS:
+				dwOptions |= (1 << OPT_LODS);
+				if (*pValue)
+				{
+					int count = atoi(pValue);
+					if (count < 1 || count > 16)
+					{
+						cout << "ERROR: invalid LOD count " << pValue << "\n\n";
+						PrintUsage();
+						return 1;
+					}
+					lodCount = size_t(count);
+				}
+				break;
+			case OPT_LOD_CLUSTERING:
+				dwOptions |= (1 << OPT_LOD_CLUSTERING);
+				break;
+			case OPT_VB:
+				dwOptions |= (1 << OPT_VB);
+				break;
+			case OPT_VB_COMPACT:
+				dwOptions |= (1 << OPT_VB_COMPACT);
+				break;
+			case OPT_OPTIMIZE:
+				dwOptions |= (1 << OPT_OPTIMIZE);
+				break;
 			}
 		}
 	}
@@ -245,6 +318,51 @@ int main(int argc, char* argv[])
 	
 	cout << "Success Load File.\n";
 
+	if (dwOptions & (1 << OPT_VCACHE_REPORT))
+	{
+		static const char* s_models[] = { "FIFO", "LRU", "Batch" };
+		static const size_t s_cacheSizes[] = { DirectX::OPTFACES_V_DEFAULT, 16, DirectX::OPTFACES_LRU_DEFAULT };
+
+		cout << "Vertex cache (ACMR / ATVR):\n";
+		for (size_t m = 0; m < _countof(s_models); ++m)
+		{
+			cout << "	" << s_models[m];
+			for (size_t c = 0; c < _countof(s_cacheSizes); ++c)
+			{
+				float acmr, atvr;
+				hr = mesh.ComputeVertexCacheMissRate(s_cacheSizes[c], static_cast<DirectX::VCACHE_MODEL>(m), acmr, atvr);
+				if (FAILED(hr))
+				{
+					cout << "\nERROR: Failed computing vertex cache miss rate " << hr << endl;
+					return 1;
+				}
+
+				cout << "	[" << s_cacheSizes[c] << "] " << acmr << " / " << atvr;
+			}
+			cout << "\n";
+		}
+	}
+
+	if (dwOptions & (1 << OPT_OPTIMIZE))
+	{
+		hr = mesh.Optimize();
+		if (FAILED(hr))
+		{
+			cout << "\nERROR: Failed optimizing mesh " << hr << endl;
+			return 1;
+		}
+
+		float acmr, atvr;
+		hr = mesh.ComputeVertexCacheMissRate(DirectX::OPTFACES_V_DEFAULT, DirectX::VCACHE_MODEL_FIFO, acmr, atvr);
+		if (FAILED(hr))
+		{
+			cout << "\nERROR: Failed computing vertex cache miss rate " << hr << endl;
+			return 1;
+		}
+
+		cout << "Success Optimize, ACMR " << acmr << " ATVR " << atvr << "\n";
+	}
+
 	char oExt[_MAX_EXT];
 	char ofName[_MAX_FNAME];
 
@@ -291,5 +409,134 @@ int main(int argc, char* argv[])
 
 	cout << "Success Output File.\n";
 
+	if (dwOptions & (1 << OPT_MESHLETS))
+	{
+		char meshletFile[MAX_PATH];
+		char oDrive[_MAX_DRIVE];
+		char oDir[_MAX_DIR];
+
+		_splitpath_s(outputFile, oDrive, _MAX_DRIVE, oDir, _MAX_DIR, ofName, _MAX_FNAME, nullptr, 0);
+		_makepath_s(meshletFile, oDrive, oDir, ofName, ".meshlet");
+
+		cout << "Meshlet File: " << meshletFile;
+
+		hr = mesh.ComputeMeshlets();
+		if (SUCCEEDED(hr))
+		{
+			hr = mesh.ExportToMeshlets(meshletFile);
+		}
+
+		if (FAILED(hr))
+		{
+			cout << "\nERROR: Failed write " << hr << "-> " << meshletFile << endl;
+			return 1;
+		}
+
+		cout << "\nSuccess Output Meshlets.\n";
+	}
+
+	if (dwOptions & ((1 << OPT_STRIPS) | (1 << OPT_IB_COMPRESS)))
+	{
+		char ibFile[MAX_PATH];
+		char oDrive[_MAX_DRIVE];
+		char oDir[_MAX_DIR];
+
+		_splitpath_s(outputFile, oDrive, _MAX_DRIVE, oDir, _MAX_DIR, ofName, _MAX_FNAME, nullptr, 0);
+		_makepath_s(ibFile, oDrive, oDir, ofName, ".ib");
+
+		cout << "Index Buffer File: " << ibFile;
+
+		bool usedStrips = false;
+		size_t chunkCount = 0;
+		const bool compress = (dwOptions & (1 << OPT_IB_COMPRESS)) != 0;
+		hr = mesh.ExportToIndexBuffer(ibFile, (dwOptions & (1 << OPT_STRIPS)) != 0, compress,
+			(dwOptions & (1 << OPT_IB_32BIT)) == 0, &usedStrips, &chunkCount);
+		if (FAILED(hr))
+		{
+			cout << "\nERROR: Failed write " << hr << "-> " << ibFile << endl;
+			return 1;
+		}
+
+		cout << (compress ? "\nSuccess Output Compressed Triangle List.\n"
+			: usedStrips ? "\nSuccess Output Triangle Strips.\n" : "\nSuccess Output Triangle List.\n");
+
+		if (chunkCount)
+		{
+			cout << "Split into " << chunkCount << " 16-bit index chunks.\n";
+		}
+	}
+
+	if (dwOptions & ((1 << OPT_VB) | (1 << OPT_VB_COMPACT)))
+	{
+		char vbFile[MAX_PATH];
+		char oDrive[_MAX_DRIVE];
+		char oDir[_MAX_DIR];
+
+		_splitpath_s(outputFile, oDrive, _MAX_DRIVE, oDir, _MAX_DIR, ofName, _MAX_FNAME, nullptr, 0);
+		_makepath_s(vbFile, oDrive, oDir, ofName, ".vb");
+
+		cout << "Vertex Buffer File: " << vbFile;
+
+		DirectX::XMFLOAT3 scale, bias;
+		const bool compact = (dwOptions & (1 << OPT_VB_COMPACT)) != 0;
+		hr = mesh.ExportToVertexBuffer(vbFile, compact, &scale, &bias);
+		if (FAILED(hr))
+		{
+			cout << "\nERROR: Failed write " << hr << "-> " << vbFile << endl;
+			return 1;
+		}
+
+		cout << (compact ? "\nSuccess Output Compact Vertex Buffer.\n" : "\nSuccess Output Vertex Buffer.\n");
+
+		if (compact)
+		{
+			cout << "Position scale (" << scale.x << ", " << scale.y << ", " << scale.z
+				<< ") bias (" << bias.x << ", " << bias.y << ", " << bias.z << ")\n";
+		}
+	}
+
+	if (dwOptions & (1 << OPT_LODS))
+	{
+		char oDrive[_MAX_DRIVE];
+		char oDir[_MAX_DIR];
+
+		_splitpath_s(outputFile, oDrive, _MAX_DRIVE, oDir, _MAX_DIR, ofName, _MAX_FNAME, oExt, _MAX_EXT);
+
+		hr = mesh.ComputeLODs(lodCount, (dwOptions & (1 << OPT_LOD_CLUSTERING)) != 0);
+		if (FAILED(hr))
+		{
+			cout << "\nERROR: Failed simplifying mesh " << hr << endl;
+			return 1;
+		}
+
+		// selecting a LOD replaces the full mesh, so this runs after every other export
+		for (size_t lod = 1; lod <= mesh.GetLODCount(); ++lod)
+		{
+			char lodName[_MAX_FNAME];
+			char lodFile[MAX_PATH];
+
+			sprintf_s(lodName, "%s_LOD%zu", ofName, lod);
+			_makepath_s(lodFile, oDrive, oDir, lodName, oExt);
+
+			cout << "LOD File: " << lodFile;
+
+			size_t nFaces = 0;
+			float error = 0.f;
+			hr = mesh.SelectLOD(lod, &nFaces, &error);
+			if (SUCCEEDED(hr))
+			{
+				hr = (!_stricmp(oExt, ".obj")) ? mesh.ExportToObj(lodFile) : mesh.ExportToSDKMesh(lodFile);
+			}
+
+			if (FAILED(hr))
+			{
+				cout << "\nERROR: Failed write " << hr << "-> " << lodFile << endl;
+				return 1;
+			}
+
+			cout << "\nSuccess Output LOD " << lod << ": " << nFaces << " faces, error " << error << "\n";
+		}
+	}
+
 	return 0;
 }
\ No newline at end of file
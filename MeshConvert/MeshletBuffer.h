@@ -0,0 +1,51 @@
+//--------------------------------------------------------------------------------------
+// File: MeshletBuffer.h
+//
+// Packed meshlet buffer written by MeshConvert next to the converted mesh, so the
+// meshlets are generated from the same load as the rest of the cook
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+
+namespace MeshletBuffer
+{
+	// .MESHLET files
+
+	// MESHLET_HEADER
+	// DirectX::Meshlet             [header->MeshletCount]      header->MeshletOffset
+	// DirectX::MeshletCullData     [header->MeshletCount]      header->CullDataOffset
+	// uint16_t or uint32_t         [header->UniqueIndexCount]  header->UniqueIndexOffset
+	// DirectX::MeshletTriangle     [header->PrimitiveCount]    header->PrimitiveOffset
+
+	// Each block starts on a MESHLET_FILE_ALIGNMENT boundary. Meshlet VertOffset and
+	// PrimOffset are element offsets into the unique index and primitive blocks.
+
+	const uint32_t MESHLET_FILE_MAGIC = 0x544C534D; // 'MSLT'
+	const uint32_t MESHLET_FILE_VERSION = 1;
+	const uint32_t MESHLET_FILE_ALIGNMENT = 16;
+
+#pragma pack(push,4)
+
+	struct MESHLET_HEADER
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t IndexSize;         // 2 or 4 bytes per unique vertex index
+		uint32_t MeshletCount;
+		uint32_t UniqueIndexCount;
+		uint32_t PrimitiveCount;
+		uint64_t MeshletOffset;
+		uint64_t CullDataOffset;
+		uint64_t UniqueIndexOffset;
+		uint64_t PrimitiveOffset;
+	};
+
+#pragma pack(pop)
+
+} // namespace
+
+static_assert(sizeof(MeshletBuffer::MESHLET_HEADER) == 56, "Meshlet buffer structure size incorrect");
+static_assert(sizeof(DirectX::Meshlet) == 16, "Meshlet buffer structure size incorrect");
+static_assert(sizeof(DirectX::MeshletCullData) == 44, "Meshlet buffer structure size incorrect");
+static_assert(sizeof(DirectX::MeshletTriangle) == 3, "Meshlet buffer structure size incorrect");
@@ -0,0 +1,69 @@
+//--------------------------------------------------------------------------------------
+// File: VertexBuffer.h
+//
+// Standalone vertex buffer written by MeshConvert next to the converted mesh, with
+// either full precision elements or compact encodings the vertex shader decodes
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+
+namespace VertexBuffer
+{
+	// .VB files
+
+	// VB_HEADER
+	// VB_ELEMENT                   [header->ElementCount]                      header->ElementOffset
+	// uint8_t                      [header->VertexCount * header->Stride]      header->VertexOffset
+
+	// Each element's Format is the DXGI format for the input layout, and its Encoding says
+	// how the shader turns the fetched value into the attribute:
+	//  VB_ENCODING_OCTAHEDRAL         xy is an octahedral unit vector; z = 1 - |x| - |y|, then
+	//                                 x -= sign(x) * max(-z, 0), likewise y, and normalize
+	//  VB_ENCODING_OCTAHEDRAL_SIGN    as above, with the bitangent sign in w
+	//  VB_ENCODING_QUANTIZED          position = value.xyz * PositionScale + PositionBias
+
+	const uint32_t VB_FILE_MAGIC = 0x46554256; // 'VBUF'
+	const uint32_t VB_FILE_VERSION = 1;
+
+	const uint32_t VB_MAX_SEMANTIC_NAME = 32;
+
+	enum VB_ENCODING
+	{
+		VB_ENCODING_NONE = 0,
+		VB_ENCODING_OCTAHEDRAL,
+		VB_ENCODING_OCTAHEDRAL_SIGN,
+		VB_ENCODING_QUANTIZED,
+	};
+
+#pragma pack(push,4)
+
+	struct VB_HEADER
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t VertexCount;
+		uint32_t Stride;
+		uint32_t ElementCount;
+		uint32_t Reserved;
+		uint64_t ElementOffset;
+		uint64_t VertexOffset;
+		float    PositionScale[3];
+		float    PositionBias[3];
+	};
+
+	struct VB_ELEMENT
+	{
+		char     SemanticName[VB_MAX_SEMANTIC_NAME];
+		uint32_t SemanticIndex;
+		uint32_t Format;            // DXGI_FORMAT
+		uint32_t Encoding;          // VB_ENCODING
+		uint32_t AlignedByteOffset;
+	};
+
+#pragma pack(pop)
+
+} // namespace
+
+static_assert(sizeof(VertexBuffer::VB_HEADER) == 64, "Vertex buffer structure size incorrect");
+static_assert(sizeof(VertexBuffer::VB_ELEMENT) == 48, "Vertex buffer structure size incorrect");